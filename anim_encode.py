@@ -0,0 +1,237 @@
+import argparse
+import math
+import os
+import struct
+import sys
+
+# CODIFICADOR DE ANIMAÇÕES PARA A MATRIZ (formato lido por animation.c)
+# Converte uma sequência de PNGs, um GIF, frames RGB crus ou uma animação de
+# exemplo no container binário, escolhendo por frame a codificação menor.
+# Uso:
+#   python anim_encode.py -o pulso.bin quadro_*.png
+#   python anim_encode.py --duracao 100 -o onda.bin onda.gif
+#   python anim_encode.py --demo pulso --c anim_pulse -o animations.c
+# PNG e GIF precisam do Pillow (pip install pillow); .raw não tem dependências.
+
+LARGURA = 5              # Deve bater com MATRIX_WIDTH
+ALTURA = 5               # Deve bater com MATRIX_HEIGHT
+DURACAO_MS = 100         # Duração padrão de cada frame
+KEYFRAME_A_CADA = 0      # Força um keyframe a cada N frames (0 = só o primeiro)
+
+# FORMATO (ver animation.h)
+MAGIC = b'LANM'
+VERSAO = 1
+FLAG_PALETA = 0x01
+FRAME_RAW, FRAME_RLE, FRAME_XOR_RLE = 0, 1, 2
+NOMES = {FRAME_RAW: 'raw', FRAME_RLE: 'rle', FRAME_XOR_RLE: 'xor+rle'}
+
+# Modelo de custo do decodificador no Cortex-M0+ (ciclos aproximados, para comparação;
+# a medida real está no caso animation_frame de benchmark.c)
+CICLOS_FRAME = 60        # Cabeçalho do frame e chamada
+CICLOS_CONTROLE = 12     # Cada byte de controle do RLE
+CICLOS_BYTE_COPIA = 6    # Byte copiado ou preenchido
+CICLOS_BYTE_XOR = 8      # Byte combinado com o frame anterior
+CICLOS_PIXEL_PALETA = 14 # Expansão índice -> RGB
+
+
+def carregar_imagens(caminhos, largura, altura, duracao):
+    """Lê PNG/GIF/raw e retorna [(pixels RGB em bytes, duração_ms)]."""
+    frames = []
+    for caminho in caminhos:
+        if caminho.lower().endswith('.raw'):
+            dados = open(caminho, 'rb').read()
+            tamanho = largura * altura * 3
+            for inicio in range(0, len(dados) - tamanho + 1, tamanho):
+                frames.append((dados[inicio:inicio + tamanho], duracao))
+            continue
+
+        try:
+            from PIL import Image, ImageSequence
+        except ImportError:
+            sys.exit("❌ PNG/GIF precisam do Pillow: pip install pillow")
+
+        imagem = Image.open(caminho)
+        for quadro in ImageSequence.Iterator(imagem):
+            rgb = quadro.convert('RGB')
+            if rgb.size != (largura, altura):
+                sys.exit(f"❌ {caminho}: {rgb.size[0]}x{rgb.size[1]}, esperado {largura}x{altura}")
+            frames.append((rgb.tobytes(), quadro.info.get('duration', duracao) or duracao))
+    return frames
+
+
+def demo_pulso(largura, altura, duracao):
+    """Anel que se expande do centro trocando de cor."""
+    cores = [(255, 0, 0), (255, 128, 0), (0, 255, 0), (0, 128, 255), (160, 0, 255)]
+    cx, cy = (largura - 1) / 2, (altura - 1) / 2
+    raio_max = math.hypot(cx, cy) + 1
+    passos = 8
+    frames = []
+    for cor in cores:
+        for passo in range(passos):
+            raio = passo * raio_max / (passos - 1)
+            pixels = bytearray()
+            for y in range(altura):
+                for x in range(largura):
+                    perto = abs(math.hypot(x - cx, y - cy) - raio) < 0.75
+                    pixels += bytes(cor if perto else (0, 0, 0))
+            frames.append((bytes(pixels), duracao))
+    return frames
+
+
+def rle(unidades, limiar):
+    """
+    RLE em unidades (1 byte com paleta, 3 sem): controle 0x80|(n-1) + unidade para
+    repetições, (n-1) + n unidades para literais; n vai de 1 a 128.
+    """
+    saida = bytearray()
+    literais = []
+    i = 0
+    total = len(unidades)
+
+    def despejar():
+        while literais:
+            bloco = literais[:128]
+            del literais[:128]
+            saida.append(len(bloco) - 1)
+            for unidade in bloco:
+                saida.extend(unidade)
+
+    while i < total:
+        n = 1
+        while i + n < total and n < 128 and unidades[i + n] == unidades[i]:
+            n += 1
+        if n >= limiar:
+            despejar()
+            saida.append(0x80 | (n - 1))
+            saida += unidades[i]
+            i += n
+        else:
+            literais.append(unidades[i])
+            i += 1
+    despejar()
+    return bytes(saida)
+
+
+def custo_decodificacao(tipo, dados, unidade, pixels, paleta):
+    """Ciclos estimados para decodificar um frame (modelo acima)."""
+    ciclos = CICLOS_FRAME
+    if tipo == FRAME_RAW:
+        ciclos += len(dados) * CICLOS_BYTE_COPIA
+    else:
+        custo_byte = CICLOS_BYTE_XOR if tipo == FRAME_XOR_RLE else CICLOS_BYTE_COPIA
+        i = 0
+        while i < len(dados):
+            controle = dados[i]
+            n = (controle & 0x7F) + 1
+            ciclos += CICLOS_CONTROLE
+            if controle & 0x80:
+                zero = not any(dados[i + 1:i + 1 + unidade])
+                # Repetição de zeros no XOR não altera nada: o decodificador só avança
+                ciclos += 0 if (tipo == FRAME_XOR_RLE and zero) else n * unidade * custo_byte
+                i += 1 + unidade
+            else:
+                ciclos += n * unidade * custo_byte
+                i += 1 + n * unidade
+    if paleta:
+        ciclos += pixels * CICLOS_PIXEL_PALETA
+    return ciclos
+
+
+def codificar(frames, largura, altura, usar_paleta, keyframe_a_cada):
+    """Monta o container e retorna (bytes, estatísticas por frame)."""
+    pixels = largura * altura
+
+    # Paleta quando todas as cores cabem em um byte de índice
+    cores = sorted({frame[i:i + 3] for frame, _ in frames for i in range(0, len(frame), 3)})
+    paleta = usar_paleta and len(cores) <= 256
+    indice = {cor: i for i, cor in enumerate(cores)}
+    unidade = 1 if paleta else 3
+
+    cabecalho = MAGIC + struct.pack('<BBBBHH', VERSAO, FLAG_PALETA if paleta else 0, largura, altura,
+                                    len(frames), len(cores) if paleta else 0)
+    saida = bytearray(cabecalho)
+    if paleta:
+        for cor in cores:
+            saida += cor
+
+    estatisticas = []
+    anterior = None
+    for numero, (frame, duracao) in enumerate(frames):
+        if paleta:
+            dados = bytes(indice[frame[i:i + 3]] for i in range(0, len(frame), 3))
+        else:
+            dados = frame
+        unidades = [dados[i:i + unidade] for i in range(0, len(dados), unidade)]
+        limiar = 3 if unidade == 1 else 2
+
+        candidatos = [(FRAME_RAW, dados), (FRAME_RLE, rle(unidades, limiar))]
+        keyframe = anterior is None or (keyframe_a_cada and numero % keyframe_a_cada == 0)
+        if not keyframe:
+            delta = bytes(a ^ b for a, b in zip(dados, anterior))
+            delta_unidades = [delta[i:i + unidade] for i in range(0, len(delta), unidade)]
+            candidatos.append((FRAME_XOR_RLE, rle(delta_unidades, limiar)))
+
+        tipo, codificado = min(candidatos, key=lambda c: len(c[1]))
+        saida += struct.pack('<BHH', tipo, min(duracao, 0xFFFF), len(codificado)) + codificado
+        estatisticas.append((tipo, len(codificado) + 5, custo_decodificacao(tipo, codificado, unidade, pixels, paleta)))
+        anterior = dados
+
+    return bytes(saida), estatisticas, paleta, len(cores)
+
+
+def escrever_c(caminho, nome, dados, origem):
+    """Grava o container como array C em flash (const)."""
+    with open(caminho, 'w') as f:
+        f.write(f"// Gerado por anim_encode.py a partir de {origem}. Não editar à mão.\n")
+        f.write('#include "animations.h"\n\n')
+        f.write(f"const uint8_t {nome}[] = {{\n")
+        for inicio in range(0, len(dados), 16):
+            f.write("    " + ", ".join(f"0x{b:02X}" for b in dados[inicio:inicio + 16]) + ",\n")
+        f.write("};\n\n")
+        f.write(f"const uint32_t {nome}_size = sizeof({nome});\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Codifica animações para a matriz de LEDs')
+    parser.add_argument('entradas', nargs='*', help='PNGs, GIFs ou arquivos .raw')
+    parser.add_argument('-o', '--saida', required=True)
+    parser.add_argument('--c', metavar='NOME', help='Grava um .c com o array NOME em vez do binário')
+    parser.add_argument('--demo', choices=['pulso'], help='Usa uma animação de exemplo no lugar das entradas')
+    parser.add_argument('--largura', type=int, default=LARGURA)
+    parser.add_argument('--altura', type=int, default=ALTURA)
+    parser.add_argument('--duracao', type=int, default=DURACAO_MS, help='ms por frame (quando a entrada não define)')
+    parser.add_argument('--keyframe', type=int, default=KEYFRAME_A_CADA)
+    parser.add_argument('--sem-paleta', action='store_true', help='Grava RGB mesmo com até 256 cores')
+    args = parser.parse_args()
+
+    if args.demo:
+        frames = demo_pulso(args.largura, args.altura, args.duracao)
+        origem = f"--demo {args.demo}"
+    else:
+        frames = carregar_imagens(args.entradas, args.largura, args.altura, args.duracao)
+        origem = ', '.join(os.path.basename(e) for e in args.entradas)
+    if not frames:
+        sys.exit("❌ Nenhum frame de entrada")
+
+    dados, estatisticas, paleta, cores = codificar(frames, args.largura, args.altura, not args.sem_paleta,
+                                                    args.keyframe)
+    if args.c:
+        escrever_c(args.saida, args.c, dados, origem)
+    else:
+        open(args.saida, 'wb').write(dados)
+
+    cru = len(frames) * args.largura * args.altura * 3
+    print(f"✅ {len(frames)} frames {args.largura}x{args.altura}, "
+          f"{'paleta de ' + str(cores) + ' cores' if paleta else 'RGB direto'} -> {args.saida}")
+    print(f"   {cru} bytes crus -> {len(dados)} bytes ({cru / len(dados):.1f}:1)")
+    for tipo in (FRAME_RAW, FRAME_RLE, FRAME_XOR_RLE):
+        usados = [e for e in estatisticas if e[0] == tipo]
+        if usados:
+            print(f"   {NOMES[tipo]:8} {len(usados):4} frames, média de {sum(e[1] for e in usados) / len(usados):.1f} bytes")
+    ciclos = [e[2] for e in estatisticas]
+    print(f"   decodificação estimada: média {sum(ciclos) / len(ciclos):.0f} ciclos/frame, máximo {max(ciclos)} "
+          f"(medida real: benchmark animation_frame)")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,210 @@
+#include <string.h>
+#include "animation.h"
+#include "framebuffer.h"
+#include "scheduler.h"
+
+/**
+ * Lê um valor de 16 bits little-endian
+ * @param p Ponteiro para os bytes
+ * @return Valor lido
+ */
+static inline uint16_t read_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/**
+ * Valida o container e prepara o player
+ * @param player Player a preparar
+ * @param data Container
+ * @param size Tamanho em bytes
+ * @param pio Instância PIO
+ * @param sm State machine
+ * @param intensity Intensidade (0-256)
+ * @param loops Repetições (0 = infinito)
+ * @return true se válido
+ */
+bool animation_open(AnimationPlayer *player, const uint8_t *data, uint32_t size,
+                    PIO pio, uint sm, uint16_t intensity, uint16_t loops) {
+    if (!data || size < ANIMATION_HEADER_BYTES) return false;
+    if (memcmp(data, ANIMATION_MAGIC, 4) != 0 || data[4] != ANIMATION_VERSION) return false;
+
+    // Só toca animações feitas para esta matriz
+    if (data[6] != MATRIX_WIDTH || data[7] != MATRIX_HEIGHT) return false;
+
+    uint16_t palette_count = read_u16(data + 10);
+    bool has_palette = data[5] & ANIMATION_FLAG_PALETTE;
+    if (has_palette && (palette_count == 0 || palette_count > 256)) return false;
+
+    uint32_t first = ANIMATION_HEADER_BYTES + (has_palette ? palette_count * 3u : 0);
+    if (first > size) return false;
+
+    player->data = data;
+    player->size = size;
+    player->palette = has_palette ? data + ANIMATION_HEADER_BYTES : NULL;
+    player->palette_count = has_palette ? palette_count : 0;
+    player->frame_count = read_u16(data + 8);
+    player->frame = 0;
+    player->first_offset = first;
+    player->offset = first;
+    player->loops_left = loops;
+    player->intensity = intensity;
+    player->pio = pio;
+    player->sm = sm;
+    memset(player->indices, 0, sizeof(player->indices));
+
+    return player->frame_count > 0;
+}
+
+/**
+ * Decodifica RLE (ou XOR+RLE) sobre o destino
+ * @param src Dados do frame
+ * @param len Tamanho dos dados
+ * @param dst Destino (índices ou bytes R,G,B)
+ * @param unit Bytes por unidade (1 ou 3)
+ * @param xor true para combinar com o conteúdo atual
+ * @return true se os dados cobrem exatamente o frame
+ */
+static bool decode_rle(const uint8_t *src, uint32_t len, uint8_t *dst, uint unit, bool xor) {
+    const uint32_t total = NUM_LEDS * unit;
+    uint32_t pos = 0, i = 0;
+
+    while (pos < total) {
+        if (i >= len) return false;
+
+        uint8_t control = src[i++];
+        uint32_t bytes = ((control & 0x7F) + 1u) * unit;
+        if (pos + bytes > total) return false;
+
+        if (control & 0x80) {
+            // Repetição de uma unidade
+            if (i + unit > len) return false;
+            const uint8_t *value = src + i;
+            i += unit;
+
+            if (xor) {
+                // XOR com zero não muda nada: trechos parados custam só o controle
+                bool zero = true;
+                for (uint k = 0; k < unit; k++) zero &= value[k] == 0;
+                if (!zero) {
+                    for (uint32_t k = 0; k < bytes; k++) dst[pos + k] ^= value[k % unit];
+                }
+            } else if (unit == 1) {
+                memset(dst + pos, value[0], bytes);
+            } else {
+                for (uint32_t k = 0; k < bytes; k += unit) memcpy(dst + pos + k, value, unit);
+            }
+        } else {
+            // Unidades literais
+            if (i + bytes > len) return false;
+            if (xor) {
+                for (uint32_t k = 0; k < bytes; k++) dst[pos + k] ^= src[i + k];
+            } else {
+                memcpy(dst + pos, src + i, bytes);
+            }
+            i += bytes;
+        }
+        pos += bytes;
+    }
+
+    return i == len;
+}
+
+/**
+ * Decodifica o próximo frame
+ * @param player Player
+ * @param pixels Destino com o frame anterior
+ * @return Duração em ms, ou -1 no fim/erro
+ */
+int32_t animation_decode_next(AnimationPlayer *player, RGBColor8 *pixels) {
+    // Fim de uma repetição: volta ao primeiro frame (sempre um keyframe)
+    if (player->frame >= player->frame_count) {
+        if (player->loops_left == 1) return -1;
+        if (player->loops_left > 1) player->loops_left--;
+        player->frame = 0;
+        player->offset = player->first_offset;
+    }
+
+    if (player->offset + ANIMATION_FRAME_HEADER_BYTES > player->size) return -1;
+    const uint8_t *header = player->data + player->offset;
+    uint8_t type = header[0];
+    uint16_t duration = read_u16(header + 1);
+    uint16_t length = read_u16(header + 3);
+    const uint8_t *src = header + ANIMATION_FRAME_HEADER_BYTES;
+    if (player->offset + ANIMATION_FRAME_HEADER_BYTES + length > player->size) return -1;
+
+    // Com paleta o frame é mantido em índices; sem paleta, direto nos pixels RGB
+    uint unit = player->palette ? 1 : 3;
+    uint8_t *dst = player->palette ? player->indices : (uint8_t *)pixels;
+    bool ok;
+
+    switch (type) {
+        case ANIMATION_FRAME_RAW:
+            ok = length == NUM_LEDS * unit;
+            if (ok) memcpy(dst, src, length);
+            break;
+        case ANIMATION_FRAME_RLE:
+            ok = decode_rle(src, length, dst, unit, false);
+            break;
+        case ANIMATION_FRAME_XOR_RLE:
+            ok = decode_rle(src, length, dst, unit, true);
+            break;
+        default:
+            ok = false;
+            break;
+    }
+    if (!ok) return -1;
+
+    if (player->palette) {
+        // Índice além da paleta (container malformado) leria fora dela na flash
+        for (int i = 0; i < NUM_LEDS; i++) {
+            if (player->indices[i] >= player->palette_count) return -1;
+        }
+        for (int i = 0; i < NUM_LEDS; i++) {
+            const uint8_t *color = player->palette + player->indices[i] * 3;
+            pixels[i] = (RGBColor8){color[0], color[1], color[2]};
+        }
+    }
+
+    player->offset += ANIMATION_FRAME_HEADER_BYTES + length;
+    player->frame++;
+    return duration;
+}
+
+/**
+ * Decodifica no framebuffer e envia
+ * @param player Player
+ * @return Duração do frame em ms, ou -1 no fim
+ */
+static int32_t animation_show_next(AnimationPlayer *player) {
+    int32_t duration = animation_decode_next(player, framebuffer_back());
+    if (duration < 0) return -1;
+
+    framebuffer_mark_dirty();
+    framebuffer_commit(player->pio, player->sm, player->intensity);
+    return duration;
+}
+
+/**
+ * Passo do escalonador
+ * @param state AnimationPlayer
+ * @return false no fim
+ */
+bool animation_step(void *state) {
+    int32_t duration = animation_show_next(state);
+    if (duration < 0) return false;
+
+    // Cada frame tem a própria duração
+    scheduler_set_period((uint32_t)duration * 1000);
+    return true;
+}
+
+/**
+ * Toca a animação até o fim
+ * @param player Player
+ */
+void animation_play(AnimationPlayer *player) {
+    int32_t duration;
+    while ((duration = animation_show_next(player)) >= 0) {
+        sleep_ms(duration);
+    }
+}
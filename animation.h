@@ -0,0 +1,88 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "led_functions.h"
+
+// === CONTAINER DE ANIMAÇÃO (gerado por anim_encode.py) ===
+// Lido direto da flash (XIP): o player guarda só ponteiros e posições.
+// Todos os campos são little-endian.
+//
+// Cabeçalho (12 bytes):
+//   "LANM" | versão (1) | flags (1) | largura (1) | altura (1) | frames (2) | cores da paleta (2)
+// Paleta (se ANIMATION_FLAG_PALETTE): cores * R,G,B
+// Cada frame:
+//   tipo (1) | duração em ms (2) | tamanho dos dados (2) | dados
+// Unidade de pixel: 1 byte (índice da paleta) ou 3 bytes (R,G,B), em ordem lógica.
+// RLE: controle 0x80|(n-1) seguido de uma unidade repetida n vezes, ou
+//      controle (n-1) seguido de n unidades literais (n de 1 a 128).
+// XOR+RLE: RLE do XOR com o frame anterior; repetições de zero não tocam nos pixels.
+
+#define ANIMATION_MAGIC "LANM"
+#define ANIMATION_VERSION 1
+#define ANIMATION_HEADER_BYTES 12
+#define ANIMATION_FRAME_HEADER_BYTES 5
+#define ANIMATION_FLAG_PALETTE 0x01
+
+typedef enum {
+    ANIMATION_FRAME_RAW = 0,      // Unidades sem compressão (keyframe)
+    ANIMATION_FRAME_RLE = 1,      // Unidades em RLE (keyframe)
+    ANIMATION_FRAME_XOR_RLE = 2   // Diferença para o frame anterior, em RLE
+} AnimationFrameType;
+
+typedef struct {
+    const uint8_t *data;          // Container na flash
+    uint32_t size;                // Tamanho do container
+    const uint8_t *palette;       // Cores da paleta (NULL sem paleta)
+    uint16_t palette_count;       // Cores na paleta (índices válidos: 0 a palette_count - 1)
+    uint16_t frame_count;         // Frames no container
+    uint16_t frame;               // Próximo frame a decodificar
+    uint32_t first_offset;        // Posição do primeiro frame
+    uint32_t offset;              // Posição do próximo frame
+    uint16_t loops_left;          // Repetições restantes (0 = infinito)
+    uint16_t intensity;           // Intensidade em ponto fixo (0-256)
+    PIO pio;                      // PIO usado no envio
+    uint sm;                      // State machine usada no envio
+    uint8_t indices[NUM_LEDS];    // Frame atual em índices (só com paleta)
+} AnimationPlayer;
+
+/**
+ * Valida o container e prepara o player. A animação deve ter o tamanho da matriz.
+ * @param player Player a preparar
+ * @param data Container (normalmente um array const na flash)
+ * @param size Tamanho do container em bytes
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade em ponto fixo (0-256)
+ * @param loops Quantas vezes tocar (0 = para sempre)
+ * @return true se o container é válido para esta matriz
+ */
+extern bool animation_open(AnimationPlayer *player, const uint8_t *data, uint32_t size,
+                           PIO pio, uint sm, uint16_t intensity, uint16_t loops);
+
+/**
+ * Decodifica o próximo frame nos pixels dados (que devem conter o frame anterior,
+ * usado pelos frames XOR). Volta ao início ao fim de cada repetição.
+ * @param player Player aberto com animation_open()
+ * @param pixels Destino, NUM_LEDS pixels em ordem lógica
+ * @return Duração do frame em ms, ou -1 no fim da animação ou com dados inválidos
+ *         (inclusive índices fora da paleta)
+ */
+extern int32_t animation_decode_next(AnimationPlayer *player, RGBColor8 *pixels);
+
+/**
+ * Passo para o escalonador: decodifica no framebuffer, envia e agenda o próximo
+ * frame pela duração gravada (scheduler_set_period()).
+ * @param state AnimationPlayer
+ * @return false no fim da animação
+ */
+extern bool animation_step(void *state);
+
+/**
+ * Toca a animação até o fim, bloqueando (versão sem escalonador).
+ * @param player Player aberto com animation_open()
+ */
+extern void animation_play(AnimationPlayer *player);
+
+#endif
@@ -0,0 +1,49 @@
+// Gerado por anim_encode.py a partir de --demo pulso. Não editar à mão.
+#include "animations.h"
+
+const uint8_t anim_pulse[] = {
+    0x4C, 0x41, 0x4E, 0x4D, 0x01, 0x01, 0x05, 0x05, 0x28, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0xFF, 0x00, 0xFF, 0x00, 0xA0, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0x80, 0x00, 0x01, 0x50,
+    0x00, 0x06, 0x00, 0x8B, 0x00, 0x00, 0x04, 0x8B, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x86, 0x00,
+    0x00, 0x04, 0x82, 0x00, 0x82, 0x04, 0x82, 0x00, 0x00, 0x04, 0x86, 0x00, 0x01, 0x50, 0x00, 0x10,
+    0x00, 0x85, 0x00, 0x82, 0x04, 0x06, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x82, 0x04, 0x85,
+    0x00, 0x01, 0x50, 0x00, 0x12, 0x00, 0x00, 0x00, 0x82, 0x04, 0x00, 0x00, 0x86, 0x04, 0x00, 0x00,
+    0x86, 0x04, 0x00, 0x00, 0x82, 0x04, 0x00, 0x00, 0x01, 0x50, 0x00, 0x10, 0x00, 0x85, 0x04, 0x82,
+    0x00, 0x01, 0x04, 0x04, 0x82, 0x00, 0x01, 0x04, 0x04, 0x82, 0x00, 0x85, 0x04, 0x02, 0x50, 0x00,
+    0x02, 0x00, 0x98, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x00, 0x04, 0x82, 0x00, 0x00, 0x04, 0x8E,
+    0x00, 0x00, 0x04, 0x82, 0x00, 0x00, 0x04, 0x01, 0x50, 0x00, 0x02, 0x00, 0x98, 0x00, 0x01, 0x50,
+    0x00, 0x06, 0x00, 0x8B, 0x00, 0x00, 0x05, 0x8B, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x86, 0x00,
+    0x00, 0x05, 0x82, 0x00, 0x82, 0x05, 0x82, 0x00, 0x00, 0x05, 0x86, 0x00, 0x01, 0x50, 0x00, 0x10,
+    0x00, 0x85, 0x00, 0x82, 0x05, 0x06, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00, 0x00, 0x82, 0x05, 0x85,
+    0x00, 0x01, 0x50, 0x00, 0x12, 0x00, 0x00, 0x00, 0x82, 0x05, 0x00, 0x00, 0x86, 0x05, 0x00, 0x00,
+    0x86, 0x05, 0x00, 0x00, 0x82, 0x05, 0x00, 0x00, 0x01, 0x50, 0x00, 0x10, 0x00, 0x85, 0x05, 0x82,
+    0x00, 0x01, 0x05, 0x05, 0x82, 0x00, 0x01, 0x05, 0x05, 0x82, 0x00, 0x85, 0x05, 0x02, 0x50, 0x00,
+    0x02, 0x00, 0x98, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x00, 0x05, 0x82, 0x00, 0x00, 0x05, 0x8E,
+    0x00, 0x00, 0x05, 0x82, 0x00, 0x00, 0x05, 0x01, 0x50, 0x00, 0x02, 0x00, 0x98, 0x00, 0x01, 0x50,
+    0x00, 0x06, 0x00, 0x8B, 0x00, 0x00, 0x02, 0x8B, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x86, 0x00,
+    0x00, 0x02, 0x82, 0x00, 0x82, 0x02, 0x82, 0x00, 0x00, 0x02, 0x86, 0x00, 0x01, 0x50, 0x00, 0x10,
+    0x00, 0x85, 0x00, 0x82, 0x02, 0x06, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x82, 0x02, 0x85,
+    0x00, 0x01, 0x50, 0x00, 0x12, 0x00, 0x00, 0x00, 0x82, 0x02, 0x00, 0x00, 0x86, 0x02, 0x00, 0x00,
+    0x86, 0x02, 0x00, 0x00, 0x82, 0x02, 0x00, 0x00, 0x01, 0x50, 0x00, 0x10, 0x00, 0x85, 0x02, 0x82,
+    0x00, 0x01, 0x02, 0x02, 0x82, 0x00, 0x01, 0x02, 0x02, 0x82, 0x00, 0x85, 0x02, 0x02, 0x50, 0x00,
+    0x02, 0x00, 0x98, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x00, 0x02, 0x82, 0x00, 0x00, 0x02, 0x8E,
+    0x00, 0x00, 0x02, 0x82, 0x00, 0x00, 0x02, 0x01, 0x50, 0x00, 0x02, 0x00, 0x98, 0x00, 0x01, 0x50,
+    0x00, 0x06, 0x00, 0x8B, 0x00, 0x00, 0x01, 0x8B, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x86, 0x00,
+    0x00, 0x01, 0x82, 0x00, 0x82, 0x01, 0x82, 0x00, 0x00, 0x01, 0x86, 0x00, 0x01, 0x50, 0x00, 0x10,
+    0x00, 0x85, 0x00, 0x82, 0x01, 0x06, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x82, 0x01, 0x85,
+    0x00, 0x01, 0x50, 0x00, 0x12, 0x00, 0x00, 0x00, 0x82, 0x01, 0x00, 0x00, 0x86, 0x01, 0x00, 0x00,
+    0x86, 0x01, 0x00, 0x00, 0x82, 0x01, 0x00, 0x00, 0x01, 0x50, 0x00, 0x10, 0x00, 0x85, 0x01, 0x82,
+    0x00, 0x01, 0x01, 0x01, 0x82, 0x00, 0x01, 0x01, 0x01, 0x82, 0x00, 0x85, 0x01, 0x02, 0x50, 0x00,
+    0x02, 0x00, 0x98, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x00, 0x01, 0x82, 0x00, 0x00, 0x01, 0x8E,
+    0x00, 0x00, 0x01, 0x82, 0x00, 0x00, 0x01, 0x01, 0x50, 0x00, 0x02, 0x00, 0x98, 0x00, 0x01, 0x50,
+    0x00, 0x06, 0x00, 0x8B, 0x00, 0x00, 0x03, 0x8B, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x86, 0x00,
+    0x00, 0x03, 0x82, 0x00, 0x82, 0x03, 0x82, 0x00, 0x00, 0x03, 0x86, 0x00, 0x01, 0x50, 0x00, 0x10,
+    0x00, 0x85, 0x00, 0x82, 0x03, 0x06, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x82, 0x03, 0x85,
+    0x00, 0x01, 0x50, 0x00, 0x12, 0x00, 0x00, 0x00, 0x82, 0x03, 0x00, 0x00, 0x86, 0x03, 0x00, 0x00,
+    0x86, 0x03, 0x00, 0x00, 0x82, 0x03, 0x00, 0x00, 0x01, 0x50, 0x00, 0x10, 0x00, 0x85, 0x03, 0x82,
+    0x00, 0x01, 0x03, 0x03, 0x82, 0x00, 0x01, 0x03, 0x03, 0x82, 0x00, 0x85, 0x03, 0x02, 0x50, 0x00,
+    0x02, 0x00, 0x98, 0x00, 0x01, 0x50, 0x00, 0x0E, 0x00, 0x00, 0x03, 0x82, 0x00, 0x00, 0x03, 0x8E,
+    0x00, 0x00, 0x03, 0x82, 0x00, 0x00, 0x03, 0x01, 0x50, 0x00, 0x02, 0x00, 0x98, 0x00,
+};
+
+const uint32_t anim_pulse_size = sizeof(anim_pulse);
@@ -0,0 +1,12 @@
+#ifndef ANIMATIONS_H
+#define ANIMATIONS_H
+
+#include "pico/stdlib.h"
+
+// Animações prontas, geradas com anim_encode.py (ver o cabeçalho de cada .c)
+
+// Anel que se expande do centro em 5 cores (5x5, paleta, 80 ms por frame)
+extern const uint8_t anim_pulse[];
+extern const uint32_t anim_pulse_size;
+
+#endif
@@ -0,0 +1,469 @@
+#include <stdlib.h>
+#include <string.h>
+#include "benchmark.h"
+#include "led_functions.h"
+#include "indexed_framebuffer.h"
+#include "gamma_dither.h"
+#include "scroll.h"
+#include "compositor.h"
+#include "message_cache.h"
+#include "animation.h"
+#include "animations.h"
+#include "effects.h"
+#include "transition.h"
+#include "parallel_strip.h"
+
+#if PICO_ON_DEVICE
+#include "hardware/clocks.h"
+#else
+#include <time.h>
+#endif
+
+static volatile uint32_t sink;  // Resultado acumulado: mantém o trabalho medido
+
+/**
+ * Relógio em ns
+ * @return Instante atual
+ */
+uint64_t benchmark_now_ns(void) {
+#if PICO_ON_DEVICE
+    return time_us_64() * 1000;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * Mede a função dobrando as iterações até o tempo alvo
+ * @param name Nome do caso
+ * @param fn Função medida
+ * @param context Dados da função
+ * @return Resultado
+ */
+BenchmarkResult benchmark_measure(const char *name, benchmark_fn_t fn, void *context) {
+    BenchmarkResult result = {name, 0, 0, 0, 0};
+    uint32_t iterations = 1;
+
+    while (1) {
+        uint32_t acc = 0;
+        uint64_t start = benchmark_now_ns();
+        for (uint32_t i = 0; i < iterations; i++) {
+            acc += fn(context);
+        }
+        uint64_t elapsed = benchmark_now_ns() - start;
+        sink += acc;
+
+        // Medições curtas demais ficam dominadas pela resolução do relógio
+        if (elapsed >= BENCHMARK_TARGET_NS || iterations >= (1u << 30)) {
+            result.iterations = iterations;
+            result.elapsed_ns = elapsed;
+            break;
+        }
+        iterations *= 2;
+    }
+
+    result.ns_per_op = result.elapsed_ns / result.iterations;
+#if PICO_ON_DEVICE
+    result.cycles_per_op = result.elapsed_ns * (clock_get_hz(clk_sys) / 1000000) / 1000 / result.iterations;
+#endif
+    return result;
+}
+
+/**
+ * Cabeçalho CSV
+ * @param out Arquivo de saída
+ */
+void benchmark_print_header(FILE *out) {
+    fprintf(out, "BENCH,name,width,height,leds,iterations,ns_per_op,cycles_per_op,fps_cpu,fps_max\n");
+}
+
+/**
+ * Linha CSV de um resultado
+ * @param out Arquivo de saída
+ * @param result Resultado
+ * @param per_frame Operação produz um frame inteiro
+ */
+void benchmark_print(FILE *out, const BenchmarkResult *result, bool per_frame) {
+    uint64_t fps_cpu = 0, fps_max = 0;
+
+    if (per_frame && result->ns_per_op > 0) {
+        uint64_t wire_ns = ((uint64_t)NUM_LEDS * BENCHMARK_WIRE_US_PER_LED + BENCHMARK_LATCH_US) * 1000;
+        fps_cpu = 1000000000ull / result->ns_per_op;
+
+        // Com DMA, render e envio se sobrepõem: vale o mais lento dos dois
+        uint64_t frame_ns = result->ns_per_op > wire_ns ? result->ns_per_op : wire_ns;
+        fps_max = 1000000000ull / frame_ns;
+    }
+
+    fprintf(out, "BENCH,%s,%d,%d,%d,%lu,%llu,%llu,%llu,%llu\n", result->name, MATRIX_WIDTH, MATRIX_HEIGHT, NUM_LEDS,
+            (unsigned long)result->iterations, (unsigned long long)result->ns_per_op,
+            (unsigned long long)result->cycles_per_op, (unsigned long long)fps_cpu, (unsigned long long)fps_max);
+}
+
+// === CASOS DO CAMINHO DE RENDERIZAÇÃO ===
+
+#define BENCH_TEXT "VIRTUS CC"
+#define BENCH_TEXT_UTF8 "Ação às 10h: VIRTUS CC!"
+
+typedef struct {
+    double frame[NUM_LEDS];        // Frame em double (API original)
+    uint8_t frame8[NUM_LEDS];      // Frame em 8 bits (API inteira)
+    RGBColor8 pixels[NUM_LEDS];    // Framebuffer RGB
+    uint32_t words[NUM_LEDS];      // Palavras de saída
+    uint8_t indices[INDEXED_BYTES];            // Framebuffer indexado
+    RGBColor8 palette[INDEXED_COLORS];         // Paleta do framebuffer indexado
+    uint32_t palette_words[INDEXED_COLORS];    // Paleta no formato do fio
+    uint palette_step;                         // Rotação atual da paleta
+    DitherState dither;                        // Acumuladores do dithering temporal
+    ScrollAnimation scroll_up;                 // Rolagem por máscaras, vertical
+    ScrollAnimation scroll_left;               // Rolagem por máscaras, horizontal com sub-passo
+    ScrollAnimation scroll_text;               // Preparação de mensagens (texto trocado a cada operação)
+    Compositor compositor;                     // Fundo, efeito, texto e sprite empilhados
+    uint32_t effect_phase;                     // Fase do efeito de teste
+    int row_base;                  // Posição da rolagem
+    AnimationPlayer player;        // Animação em laço infinito
+    Effect effect;                 // Efeito procedural medido
+    uint32_t previous[NUM_LEDS];   // Frame que estava nos LEDs (origem das transições)
+    uint8_t planes[PARALLEL_LEDS_PER_LANE * PARALLEL_BYTES_PER_LED]; // Bits transpostos das 8 fitas
+} BenchContext;
+
+static uint32_t bench_rgb_matrix(void *context) {
+    (void)context;
+    return rgb_matrix(0.25, 0.5, 0.75);
+}
+
+static uint32_t bench_rgb_matrix_fixed(void *context) {
+    (void)context;
+    return rgb_matrix_fixed(64, 128, 192);
+}
+
+static uint32_t bench_normalize_color(void *context) {
+    (void)context;
+    RGBColor color = {100, 156, 255};
+    normalize_color(&color);
+    return (uint32_t)(color.g * 255);
+}
+
+static uint32_t bench_pack_frame(void *context) {
+    BenchContext *bench = context;
+    pack_frame(bench->frame, (RGBColor){100, 156, 255}, 0.1, bench->words);
+    return bench->words[0];
+}
+
+static uint32_t bench_pack_frame_fixed(void *context) {
+    BenchContext *bench = context;
+    pack_frame_fixed(bench->frame8, (RGBColor8){100, 156, 255}, 26, bench->words);
+    return bench->words[0];
+}
+
+static uint32_t bench_pack_pixels_fixed(void *context) {
+    BenchContext *bench = context;
+    pack_pixels_fixed(bench->pixels, 26, bench->words);
+    return bench->words[0];
+}
+
+static uint32_t bench_parallel_transpose_frame(void *context) {
+    BenchContext *bench = context;
+    pack_pixels_fixed(bench->pixels, 26, bench->words);
+    parallel_transpose(bench->words, NUM_LEDS, PARALLEL_LEDS_PER_LANE, bench->planes);
+    return bench->planes[0];
+}
+
+static uint32_t bench_pack_indexed_fixed(void *context) {
+    BenchContext *bench = context;
+    pack_indexed_fixed(bench->indices, INDEXED_BITS, bench->palette_words, bench->words);
+    return bench->words[0];
+}
+
+static uint32_t bench_palette_cycle_frame(void *context) {
+    BenchContext *bench = context;
+    const uint8_t *table = brightness_table(26);
+
+    // Um frame do ciclo de cores: gira a paleta e resolve no fio, sem tocar nos pixels
+    bench->palette_step = (bench->palette_step + 1) % INDEXED_COLORS;
+    for (uint c = 0; c < INDEXED_COLORS; c++) {
+        RGBColor8 color = bench->palette[(c + bench->palette_step) % INDEXED_COLORS];
+        bench->palette_words[c] = rgb_matrix_fixed(table[color.b], table[color.r], table[color.g]);
+    }
+    pack_indexed_fixed(bench->indices, INDEXED_BITS, bench->palette_words, bench->words);
+    return bench->words[0];
+}
+
+static uint32_t bench_dithered_frame(void *context) {
+    BenchContext *bench = context;
+    pack_pixels_dithered(bench->pixels, gamma_table(26), &bench->dither, bench->words);
+    return bench->words[0];
+}
+
+static uint32_t bench_create_text(void *context) {
+    (void)context;
+    uint32_t *glyphs = create_text(BENCH_TEXT);
+    uint32_t first = glyphs ? glyphs[0] : 0;
+    free(glyphs);
+    return first;
+}
+
+static uint32_t bench_message_frame(void *context) {
+    BenchContext *bench = context;
+    int length = sizeof(BENCH_TEXT) - 1;
+
+    // Um frame da rolagem: janela do texto + conversão para o fio
+    render_text_window(BENCH_TEXT, length, bench->row_base, bench->frame8, 255);
+    pack_frame_fixed(bench->frame8, (RGBColor8){100, 156, 255}, 26, bench->words);
+
+    if (++bench->row_base >= text_height(length)) bench->row_base = -(MATRIX_HEIGHT - 1);
+    return bench->words[0];
+}
+
+/**
+ * Um frame da rolagem por máscaras (janela + conversão), andando pela mensagem
+ * @param bench Contexto
+ * @param scroll Rolagem medida
+ * @return Primeira palavra
+ */
+static uint32_t bench_scroll(BenchContext *bench, ScrollAnimation *scroll) {
+    scroll_pack_window(scroll, scroll->position, bench->words);
+
+    scroll->position += scroll->speed;
+    if ((scroll->position >> 8) > scroll->count) scroll->position = -(scroll->span - 1) * SCROLL_SPEED_ONE;
+    return bench->words[0];
+}
+
+static uint32_t bench_scroll_up_frame(void *context) {
+    BenchContext *bench = context;
+    return bench_scroll(bench, &bench->scroll_up);
+}
+
+static uint32_t bench_scroll_left_smooth_frame(void *context) {
+    BenchContext *bench = context;
+    return bench_scroll(bench, &bench->scroll_left);
+}
+
+/**
+ * Efeito de teste: gradiente diagonal que anda a cada frame
+ * @param state Fase (uint32_t)
+ * @param pixels Saída 0x00RRGGBB
+ */
+static void bench_gradient_effect(void *state, uint32_t *pixels) {
+    uint32_t phase = ++*(uint32_t *)state;
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+        for (int x = 0; x < MATRIX_WIDTH; x++) {
+            uint32_t v = (uint32_t)((x + y) * 16 + phase) & 0xFF;
+            pixels[y * MATRIX_WIDTH + x] = (v << 16) | ((255 - v) << 8) | 64;
+        }
+    }
+}
+
+static uint32_t bench_scroll_set_text(void *context) {
+    BenchContext *bench = context;
+
+    // Preparação de uma mensagem nova: UTF-8, busca dos glifos, kerning e máscaras
+    message_cache_clear();
+    scroll_animation_set_text(&bench->scroll_text, BENCH_TEXT_UTF8, &font_5x5, TEXT_SPACING);
+    return (uint32_t)bench->scroll_text.count;
+}
+
+static uint32_t bench_scroll_set_text_cached(void *context) {
+    BenchContext *bench = context;
+
+    // Mensagem repetida: as máscaras vêm prontas do cache
+    scroll_animation_set_text(&bench->scroll_text, BENCH_TEXT_UTF8, &font_5x5, TEXT_SPACING);
+    return (uint32_t)bench->scroll_text.count;
+}
+
+static uint32_t bench_composite_frame(void *context) {
+    BenchContext *bench = context;
+
+    // Quatro camadas compostas e convertidas para o fio, com o texto andando
+    compositor_render(&bench->compositor, bench->pixels);
+    pack_pixels_fixed(bench->pixels, 26, bench->words);
+
+    ScrollAnimation *text = &bench->scroll_left;
+    if (!scroll_animation_advance(text)) text->position = -(text->span - 1) * SCROLL_SPEED_ONE;
+    return bench->words[0];
+}
+
+static uint32_t bench_effect_frame(void *context) {
+    BenchContext *bench = context;
+
+    // Um frame do efeito (estado incremental + tabelas) e a conversão para o fio
+    effect_render(&bench->effect, bench->pixels);
+    pack_pixels_fixed(bench->pixels, 26, bench->words);
+    return bench->words[0];
+}
+
+static uint32_t bench_transition_frame(void *context) {
+    BenchContext *bench = context;
+
+    // A passada extra da transição sobre as palavras de saída, no lugar
+    transition_apply(bench->words, bench->previous);
+    return bench->words[0];
+}
+
+static uint32_t bench_animation_frame(void *context) {
+    BenchContext *bench = context;
+    animation_decode_next(&bench->player, bench->pixels);
+    return bench->pixels[0].r;
+}
+
+/**
+ * Confere se o reenvio com dithering sustenta GAMMA_DITHER_REFRESH_HZ.
+ * Linha: DITHER,target_hz,refresh_hz,cpu_percent,ok
+ * refresh_hz é o menor entre o alvo, o limite do fio e o limite da CPU;
+ * cpu_percent é a ocupação do núcleo de saída no ritmo alcançado.
+ * @param out Arquivo de saída
+ * @param result Medição de pack_pixels_dithered()
+ */
+static void benchmark_print_refresh(FILE *out, const BenchmarkResult *result) {
+    uint64_t wire_ns = ((uint64_t)NUM_LEDS * BENCHMARK_WIRE_US_PER_LED + BENCHMARK_LATCH_US) * 1000;
+    uint64_t frame_ns = result->ns_per_op > wire_ns ? result->ns_per_op : wire_ns;
+
+    uint64_t refresh_hz = 1000000000ull / frame_ns;
+    if (refresh_hz > GAMMA_DITHER_REFRESH_HZ) refresh_hz = GAMMA_DITHER_REFRESH_HZ;
+    uint64_t cpu_percent = result->ns_per_op * refresh_hz / 10000000ull;
+
+    fprintf(out, "DITHER,%d,%llu,%llu,%s\n", GAMMA_DITHER_REFRESH_HZ, (unsigned long long)refresh_hz,
+            (unsigned long long)cpu_percent, refresh_hz >= GAMMA_DITHER_REFRESH_HZ ? "ok" : "abaixo do alvo");
+}
+
+/**
+ * Confere um efeito contra o orçamento declarado em effects.c.
+ * Linha: EFFECT,name,budget_cycles,cycles_per_op,status
+ * O orçamento vale só para o efeito; a medição inclui a conversão para o fio,
+ * que é igual para todos, então budget_cycles é comparado com a diferença.
+ * No host não há ciclos: status fica "host".
+ * @param out Arquivo de saída
+ * @param type Efeito
+ * @param result Medição do frame do efeito
+ * @param pack_cycles Ciclos de pack_pixels_fixed() no mesmo tamanho
+ */
+static void benchmark_print_budget(FILE *out, EffectType type, const BenchmarkResult *result, uint64_t pack_cycles) {
+    uint64_t budget = effect_budget_cycles(type);
+    uint64_t cycles = result->cycles_per_op > pack_cycles ? result->cycles_per_op - pack_cycles : 0;
+    const char *status = result->cycles_per_op == 0 ? "host" : cycles <= budget ? "ok" : "acima do orçamento";
+
+    fprintf(out, "EFFECT,%s,%llu,%llu,%s\n", effect_info(type)->name, (unsigned long long)budget,
+            (unsigned long long)cycles, status);
+}
+
+/**
+ * Executa todos os casos
+ * @param out Arquivo de saída
+ */
+void benchmark_run_all(FILE *out) {
+    static BenchContext bench;
+
+    // Frame de teste com metade dos LEDs acesos
+    for (int i = 0; i < NUM_LEDS; i++) {
+        bench.frame[i] = i & 1;
+        bench.frame8[i] = (i & 1) ? 255 : 0;
+        bench.pixels[i] = (RGBColor8){(uint8_t)i, (uint8_t)(i * 3), (uint8_t)(i * 7)};
+    }
+    bench.row_base = -(MATRIX_HEIGHT - 1);
+    gamma_dither_reset(&bench.dither);
+    scroll_animation_init(&bench.scroll_up, BENCH_TEXT, SCROLL_UP, TEXT_SPACING, (RGBColor){100, 156, 255}, NULL, 0, 0.1);
+    scroll_animation_init(&bench.scroll_left, BENCH_TEXT, SCROLL_LEFT, TEXT_SPACING, (RGBColor){100, 156, 255}, NULL, 0, 0.1);
+    scroll_animation_set_speed(&bench.scroll_left, SCROLL_SPEED_ONE / 4, true);
+    scroll_animation_init(&bench.scroll_text, "", SCROLL_LEFT, TEXT_SPACING, (RGBColor){100, 156, 255}, NULL, 0, 0.1);
+
+    // Compositor com uma camada de cada tipo, o texto somado e o sprite semitransparente
+    static const RGBColor8 sprite_pixels[4] = {{255, 0, 0}, {0, 255, 0}, {0, 0, 255}, {255, 255, 255}};
+    static const uint8_t sprite_alpha[4] = {255, 128, 128, 64};
+    static const Sprite sprite = {2, 2, sprite_pixels, sprite_alpha};
+    compositor_init(&bench.compositor);
+    compositor_add_solid(&bench.compositor, (RGBColor8){8, 8, 32});
+    compositor_add_effect(&bench.compositor, bench_gradient_effect, &bench.effect_phase)->opacity = 128;
+    compositor_add_text(&bench.compositor, &bench.scroll_left, (RGBColor8){255, 255, 255})->blend = BLEND_ADD;
+    compositor_add_sprite(&bench.compositor, &sprite, MATRIX_WIDTH - 2, 0);
+
+    // Índices em faixas diagonais, como um ciclo de cores
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+        for (int x = 0; x < MATRIX_WIDTH; x++) {
+            int position = y * MATRIX_WIDTH + x;
+            uint8_t index = (uint8_t)((x + y) % INDEXED_COLORS);
+            if (INDEXED_BITS == 8) {
+                bench.indices[position] = index;
+            } else {
+                bench.indices[position >> 1] |= (uint8_t)(index << ((position & 1) << 2));
+            }
+        }
+    }
+    for (int c = 0; c < INDEXED_COLORS; c++) {
+        bench.palette[c] = (RGBColor8){(uint8_t)(c * 16), (uint8_t)(255 - c * 16), 128};
+        bench.palette_words[c] = rgb_matrix_fixed(bench.palette[c].b, bench.palette[c].r, bench.palette[c].g);
+    }
+
+    static const struct {
+        const char *name;
+        benchmark_fn_t fn;
+        bool per_frame;
+    } cases[] = {
+        {"rgb_matrix", bench_rgb_matrix, false},
+        {"rgb_matrix_fixed", bench_rgb_matrix_fixed, false},
+        {"normalize_color", bench_normalize_color, false},
+        {"pack_frame", bench_pack_frame, true},
+        {"pack_frame_fixed", bench_pack_frame_fixed, true},
+        {"pack_pixels_fixed", bench_pack_pixels_fixed, true},
+        {"parallel_transpose_frame", bench_parallel_transpose_frame, true},
+        {"pack_indexed_fixed", bench_pack_indexed_fixed, true},
+        {"palette_cycle_frame", bench_palette_cycle_frame, true},
+        {"dithered_frame", bench_dithered_frame, true},
+        {"create_text", bench_create_text, false},
+        {"show_message_frame", bench_message_frame, true},
+        {"scroll_set_text", bench_scroll_set_text, false},
+        {"scroll_set_text_cached", bench_scroll_set_text_cached, false},
+        {"scroll_up_frame", bench_scroll_up_frame, true},
+        {"scroll_left_smooth_frame", bench_scroll_left_smooth_frame, true},
+        {"composite_4_layers_frame", bench_composite_frame, true},
+        {"animation_frame", bench_animation_frame, true},
+    };
+
+    // A animação de exemplo só existe no tamanho 5x5
+    bool has_animation = animation_open(&bench.player, anim_pulse, anim_pulse_size, NULL, 0, 26, 0);
+
+    benchmark_print_header(out);
+    uint64_t pack_cycles = 0;
+    for (uint i = 0; i < count_of(cases); i++) {
+        if (cases[i].fn == bench_animation_frame && !has_animation) continue;
+
+        BenchmarkResult result = benchmark_measure(cases[i].name, cases[i].fn, &bench);
+        benchmark_print(out, &result, cases[i].per_frame);
+
+        if (cases[i].fn == bench_dithered_frame) {
+            benchmark_print_refresh(out, &result);
+        }
+        if (cases[i].fn == bench_pack_pixels_fixed) {
+            pack_cycles = result.cycles_per_op;
+        }
+    }
+
+    // Efeitos procedurais, cada um conferido contra o próprio orçamento
+    static char effect_names[EFFECT_COUNT][32];
+    for (int type = 0; type < EFFECT_COUNT; type++) {
+        snprintf(effect_names[type], sizeof(effect_names[type]), "effect_%s_frame", effect_info(type)->name);
+        effect_init(&bench.effect, (EffectType)type, (RGBColor8){100, 156, 255}, 0, NULL, 0, 26);
+
+        BenchmarkResult result = benchmark_measure(effect_names[type], bench_effect_frame, &bench);
+        benchmark_print(out, &result, true);
+        benchmark_print_budget(out, (EffectType)type, &result, pack_cycles);
+    }
+
+    // Transições longas (a medição inteira fica no meio delas); a fusão interpola todos os LEDs
+    static const struct {
+        const char *name;
+        TransitionType type;
+    } transitions[] = {
+        {"transition_crossfade_frame", TRANSITION_CROSSFADE},
+        {"transition_wipe_frame", TRANSITION_WIPE_RIGHT},
+        {"transition_dissolve_frame", TRANSITION_DISSOLVE},
+    };
+    pack_pixels_fixed(bench.pixels, 26, bench.previous);
+    for (uint i = 0; i < count_of(transitions); i++) {
+        transition_start(transitions[i].type, 60000);
+        BenchmarkResult result = benchmark_measure(transitions[i].name, bench_transition_frame, &bench);
+        benchmark_print(out, &result, true);
+    }
+    transition_start(TRANSITION_CUT, 0);
+}
@@ -0,0 +1,68 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "matrix_config.h"
+#include "led_dma.h"
+
+#ifndef BENCHMARK_TARGET_NS
+#define BENCHMARK_TARGET_NS 200000000ull  // Duração alvo de cada medição (200 ms)
+#endif
+#define BENCHMARK_WIRE_US_PER_LED LED_WORD_US  // Tempo de fio por LED (24 bits)
+#define BENCHMARK_LATCH_US LED_DMA_LATCH_US     // Tempo de latch entre frames
+
+/**
+ * Função medida: executa a operação uma vez.
+ * @param context Dados próprios do benchmark
+ * @return Valor qualquer derivado do resultado (impede o compilador de descartar o trabalho)
+ */
+typedef uint32_t (*benchmark_fn_t)(void *context);
+
+typedef struct {
+    const char *name;        // Nome do caso (coluna "name" da saída)
+    uint32_t iterations;     // Execuções medidas
+    uint64_t elapsed_ns;     // Tempo total medido
+    uint64_t ns_per_op;      // Tempo médio por execução
+    uint64_t cycles_per_op;  // Ciclos de CPU por execução (0 no host)
+} BenchmarkResult;
+
+/**
+ * Relógio do benchmark em nanossegundos: timer de 64 bits no RP2040,
+ * relógio monotônico real no host (o relógio do emulador é virtual).
+ * @return Instante atual em ns
+ */
+extern uint64_t benchmark_now_ns(void);
+
+/**
+ * Mede uma função, aumentando as iterações até atingir BENCHMARK_TARGET_NS.
+ * @param name Nome do caso
+ * @param fn Função medida
+ * @param context Dados repassados à função
+ * @return Resultado da medição
+ */
+extern BenchmarkResult benchmark_measure(const char *name, benchmark_fn_t fn, void *context);
+
+/**
+ * Escreve o cabeçalho CSV (uma vez, antes dos resultados).
+ * Todas as linhas começam com "BENCH," para serem separadas dos demais logs.
+ * @param out Arquivo de saída (stdout no Pico: USB CDC)
+ */
+extern void benchmark_print_header(FILE *out);
+
+/**
+ * Escreve um resultado em CSV, com o fps máximo sustentável: o menor entre
+ * o limite da CPU (1 / tempo por frame) e o limite do fio (NUM_LEDS LEDs + latch).
+ * @param out Arquivo de saída
+ * @param result Resultado da medição
+ * @param per_frame true se a operação medida produz um frame inteiro
+ */
+extern void benchmark_print(FILE *out, const BenchmarkResult *result, bool per_frame);
+
+/**
+ * Executa todos os casos do caminho de renderização e escreve os resultados.
+ * @param out Arquivo de saída
+ */
+extern void benchmark_run_all(FILE *out);
+
+#endif
@@ -0,0 +1,294 @@
+#include <string.h>
+#include "compositor.h"
+
+#define LANES 0x00FF00FFu                // Dois canais de 8 bits com 8 bits de folga cada
+
+// === BUFFERS DE TRABALHO (um frame por vez) ===
+static uint32_t canvas[NUM_LEDS];        // Resultado parcial, 0x00RRGGBB
+static uint32_t effect_pixels[NUM_LEDS]; // Saída da camada de efeito atual
+static uint8_t coverage[NUM_LEDS];       // Máscara da camada de texto atual
+
+/**
+ * Interpola dois pares de canais: dst + (src - dst) * alpha / 256
+ * A subtração pode "emprestar" da faixa vizinha, mas a folga de 8 bits e a máscara final
+ * descartam o empréstimo: o resultado é exato em cada faixa
+ * @param dst Canais de destino (máscara LANES)
+ * @param src Canais de origem (máscara LANES)
+ * @param alpha Peso da origem (0-256)
+ * @return Canais interpolados
+ */
+static inline uint32_t lerp_lanes(uint32_t dst, uint32_t src, uint32_t alpha) {
+    return (dst + (((src - dst) * alpha) >> 8)) & LANES;
+}
+
+/**
+ * Escala dois pares de canais por alpha/256
+ * @param src Canais (máscara LANES)
+ * @param alpha Peso (0-256)
+ * @return Canais escalados
+ */
+static inline uint32_t scale_lanes(uint32_t src, uint32_t alpha) {
+    return ((src * alpha) >> 8) & LANES;
+}
+
+/**
+ * Soma dois pares de canais saturando em 255
+ * @param dst Canais (máscara LANES)
+ * @param src Canais (máscara LANES)
+ * @return Soma saturada
+ */
+static inline uint32_t add_lanes(uint32_t dst, uint32_t src) {
+    uint32_t sum = dst + src;
+    uint32_t carry = sum & 0x01000100u;
+
+    // Faixa que passou de 255 vira 0xFF (carry - carry/256 = 0xFF na faixa)
+    return (sum | (carry - (carry >> 8))) & LANES;
+}
+
+/**
+ * Mistura um pixel da camada sobre o destino
+ * @param dst Pixel de destino (0x00RRGGBB)
+ * @param src Pixel da camada (0x00RRGGBB)
+ * @param alpha Peso da camada (1-256)
+ * @param mode Modo de mistura
+ * @return Pixel resultante
+ */
+static inline uint32_t blend_pixel(uint32_t dst, uint32_t src, uint32_t alpha, BlendMode mode) {
+    uint32_t dst_rb = dst & LANES, dst_g = (dst >> 8) & LANES;
+    uint32_t src_rb = src & LANES, src_g = (src >> 8) & LANES;
+
+    switch (mode) {
+        case BLEND_ADD:
+            return add_lanes(dst_rb, scale_lanes(src_rb, alpha)) | (add_lanes(dst_g, scale_lanes(src_g, alpha)) << 8);
+
+        case BLEND_MULTIPLY: {
+            // Produto canal a canal (multiplicadores diferentes por faixa), depois a mistura normal
+            uint32_t r = (((dst >> 16) & 0xFF) * (((src >> 16) & 0xFF) + 1)) >> 8;
+            uint32_t g = (((dst >> 8) & 0xFF) * (((src >> 8) & 0xFF) + 1)) >> 8;
+            uint32_t b = ((dst & 0xFF) * ((src & 0xFF) + 1)) >> 8;
+            src_rb = (r << 16) | b;
+            src_g = g;
+        }
+            // fallthrough
+        case BLEND_NORMAL:
+        default:
+            return lerp_lanes(dst_rb, src_rb, alpha) | (lerp_lanes(dst_g, src_g, alpha) << 8);
+    }
+}
+
+/**
+ * Limpa o compositor
+ * @param compositor Compositor
+ */
+void compositor_init(Compositor *compositor) {
+    compositor->count = 0;
+}
+
+/**
+ * Reserva a próxima camada com valores padrão
+ * @param compositor Compositor
+ * @param type Tipo da camada
+ * @return Camada ou NULL
+ */
+static Layer *compositor_add(Compositor *compositor, LayerType type) {
+    if (compositor->count >= COMPOSITOR_MAX_LAYERS) return NULL;
+
+    Layer *layer = &compositor->layers[compositor->count++];
+    memset(layer, 0, sizeof(*layer));
+    layer->type = type;
+    layer->blend = BLEND_NORMAL;
+    layer->opacity = 255;
+    layer->visible = true;
+    return layer;
+}
+
+/**
+ * Camada de cor única
+ * @param compositor Compositor
+ * @param color Cor
+ * @return Camada ou NULL
+ */
+Layer *compositor_add_solid(Compositor *compositor, RGBColor8 color) {
+    Layer *layer = compositor_add(compositor, LAYER_SOLID);
+    if (layer) layer->color = color;
+    return layer;
+}
+
+/**
+ * Camada de texto
+ * @param compositor Compositor
+ * @param text Rolagem
+ * @param color Cor do texto
+ * @return Camada ou NULL
+ */
+Layer *compositor_add_text(Compositor *compositor, const ScrollAnimation *text, RGBColor8 color) {
+    Layer *layer = compositor_add(compositor, LAYER_TEXT);
+    if (layer) {
+        layer->text = text;
+        layer->color = color;
+    }
+    return layer;
+}
+
+/**
+ * Camada de sprite
+ * @param compositor Compositor
+ * @param sprite Imagem
+ * @param x Coluna
+ * @param y Linha
+ * @return Camada ou NULL
+ */
+Layer *compositor_add_sprite(Compositor *compositor, const Sprite *sprite, int x, int y) {
+    Layer *layer = compositor_add(compositor, LAYER_SPRITE);
+    if (layer) {
+        layer->sprite = sprite;
+        layer->x = (int16_t)x;
+        layer->y = (int16_t)y;
+    }
+    return layer;
+}
+
+/**
+ * Camada de efeito
+ * @param compositor Compositor
+ * @param effect Função geradora
+ * @param state Estado da função
+ * @return Camada ou NULL
+ */
+Layer *compositor_add_effect(Compositor *compositor, layer_effect_fn effect, void *state) {
+    Layer *layer = compositor_add(compositor, LAYER_EFFECT);
+    if (layer) {
+        layer->effect = effect;
+        layer->effect_state = state;
+    }
+    return layer;
+}
+
+/**
+ * Define o recorte
+ * @param layer Camada
+ * @param x Coluna inicial
+ * @param y Linha inicial
+ * @param width Largura (0 = até a borda)
+ * @param height Altura (0 = até a borda)
+ */
+void layer_set_clip(Layer *layer, int x, int y, int width, int height) {
+    layer->clip = (ClipRect){(int16_t)x, (int16_t)y, (int16_t)width, (int16_t)height};
+}
+
+/**
+ * Região efetiva da camada: recorte ∩ matriz ∩ extensão do sprite
+ * @param layer Camada
+ * @param x0 Primeira coluna
+ * @param y0 Primeira linha
+ * @param x1 Coluna após a última
+ * @param y1 Linha após a última
+ * @return false se a região for vazia
+ */
+static bool layer_region(const Layer *layer, int *x0, int *y0, int *x1, int *y1) {
+    const ClipRect *clip = &layer->clip;
+    *x0 = clip->x > 0 ? clip->x : 0;
+    *y0 = clip->y > 0 ? clip->y : 0;
+    *x1 = clip->width > 0 ? clip->x + clip->width : MATRIX_WIDTH;
+    *y1 = clip->height > 0 ? clip->y + clip->height : MATRIX_HEIGHT;
+    if (*x1 > MATRIX_WIDTH) *x1 = MATRIX_WIDTH;
+    if (*y1 > MATRIX_HEIGHT) *y1 = MATRIX_HEIGHT;
+
+    if (layer->type == LAYER_SPRITE) {
+        if (!layer->sprite) return false;
+        if (*x0 < layer->x) *x0 = layer->x;
+        if (*y0 < layer->y) *y0 = layer->y;
+        if (*x1 > layer->x + layer->sprite->width) *x1 = layer->x + layer->sprite->width;
+        if (*y1 > layer->y + layer->sprite->height) *y1 = layer->y + layer->sprite->height;
+    }
+
+    return *x0 < *x1 && *y0 < *y1;
+}
+
+/**
+ * Mistura uma camada no canvas
+ * @param layer Camada visível
+ */
+static void compositor_apply(const Layer *layer) {
+    int x0, y0, x1, y1;
+    if (!layer_region(layer, &x0, &y0, &x1, &y1)) return;
+
+    // Opacidade 0-255 levada a 0-256: 255 deixa a camada intacta
+    uint32_t alpha = layer->opacity + (layer->opacity >> 7);
+    BlendMode mode = layer->blend;
+
+    // Origem preparada uma vez por frame
+    uint32_t solid = compositor_pack(layer->color);
+    if (layer->type == LAYER_TEXT) {
+        if (!layer->text) return;
+        scroll_render_window(layer->text, layer->text->position, coverage, 255);
+    } else if (layer->type == LAYER_EFFECT) {
+        if (!layer->effect) return;
+        layer->effect(layer->effect_state, effect_pixels);
+    }
+
+    for (int y = y0; y < y1; y++) {
+        uint32_t *row = &canvas[y * MATRIX_WIDTH];
+
+        switch (layer->type) {
+            case LAYER_SOLID:
+                for (int x = x0; x < x1; x++) {
+                    row[x] = blend_pixel(row[x], solid, alpha, mode);
+                }
+                break;
+
+            case LAYER_TEXT: {
+                const uint8_t *mask = &coverage[y * MATRIX_WIDTH];
+                for (int x = x0; x < x1; x++) {
+                    // Fora do texto não há nada a misturar; a cobertura vai a 0-256 como a opacidade
+                    if (mask[x] == 0) continue;
+                    uint32_t cover = mask[x] + (mask[x] >> 7);
+                    row[x] = blend_pixel(row[x], solid, (cover * alpha) >> 8, mode);
+                }
+                break;
+            }
+
+            case LAYER_SPRITE: {
+                const Sprite *sprite = layer->sprite;
+                int offset = (y - layer->y) * sprite->width - layer->x;
+                for (int x = x0; x < x1; x++) {
+                    uint32_t cover = sprite->alpha ? sprite->alpha[offset + x] + (sprite->alpha[offset + x] >> 7) : 256;
+                    uint32_t weight = (cover * alpha) >> 8;
+                    if (weight == 0) continue;
+                    row[x] = blend_pixel(row[x], compositor_pack(sprite->pixels[offset + x]), weight, mode);
+                }
+                break;
+            }
+
+            case LAYER_EFFECT: {
+                const uint32_t *source = &effect_pixels[y * MATRIX_WIDTH];
+                for (int x = x0; x < x1; x++) {
+                    row[x] = blend_pixel(row[x], source[x], alpha, mode);
+                }
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Compõe as camadas visíveis
+ * @param compositor Compositor
+ * @param out Pixels RGB de saída
+ */
+void compositor_render(const Compositor *compositor, RGBColor8 *out) {
+    // Fundo preto: camadas ausentes deixam os LEDs apagados
+    memset(canvas, 0, sizeof(canvas));
+
+    for (int i = 0; i < compositor->count; i++) {
+        const Layer *layer = &compositor->layers[i];
+        if (layer->visible && layer->opacity) {
+            compositor_apply(layer);
+        }
+    }
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        uint32_t pixel = canvas[i];
+        out[i] = (RGBColor8){(uint8_t)(pixel >> 16), (uint8_t)(pixel >> 8), (uint8_t)pixel};
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "pico/stdlib.h"
+#include "led_functions.h"
+#include "scroll.h"
+
+/**
+ * Compositor de camadas: fundo, texto em rolagem, sprites e efeitos empilhados
+ * de baixo para cima, cada um com opacidade, modo de mistura e região de recorte.
+ * A mistura é inteira em SWAR: o pixel fica em 0x00RRGGBB e cada multiplicação
+ * de 32 bits mistura dois canais (R e B juntos, G sozinho na outra metade).
+ * O custo por frame é limitado: no máximo COMPOSITOR_MAX_LAYERS camadas, cada
+ * uma percorrendo só a própria região recortada.
+ */
+
+#define COMPOSITOR_MAX_LAYERS 6          // Camadas por compositor
+
+typedef enum {
+    LAYER_SOLID,                         // Cor única
+    LAYER_TEXT,                          // Janela atual de uma ScrollAnimation como máscara
+    LAYER_SPRITE,                        // Imagem RGB com alfa opcional, posicionada
+    LAYER_EFFECT                         // Pixels gerados por uma função a cada frame
+} LayerType;
+
+typedef enum {
+    BLEND_NORMAL,                        // Interpola do fundo para a camada
+    BLEND_ADD,                           // Soma com saturação (brilho)
+    BLEND_MULTIPLY                       // Multiplica (escurece; canal a canal)
+} BlendMode;
+
+typedef struct {
+    int16_t x, y;                        // Canto superior esquerdo
+    int16_t width, height;               // Tamanho (0 = até a borda da matriz)
+} ClipRect;
+
+typedef struct {
+    uint8_t width;                       // Colunas
+    uint8_t height;                      // Linhas
+    const RGBColor8 *pixels;             // width * height pixels, linha a linha
+    const uint8_t *alpha;                // Cobertura por pixel (0-255), ou NULL para opaco
+} Sprite;
+
+/**
+ * Gera os pixels de uma camada de efeito.
+ * @param state Estado próprio do efeito
+ * @param pixels Saída com NUM_LEDS pixels 0x00RRGGBB em ordem lógica
+ */
+typedef void (*layer_effect_fn)(void *state, uint32_t *pixels);
+
+typedef struct {
+    LayerType type;                      // Origem dos pixels
+    BlendMode blend;                     // Modo de mistura
+    uint8_t opacity;                     // Opacidade da camada (0-255)
+    bool visible;                        // Camadas ocultas não custam nada
+    ClipRect clip;                       // Região onde a camada pode desenhar
+    RGBColor8 color;                     // LAYER_SOLID e LAYER_TEXT
+    const ScrollAnimation *text;         // LAYER_TEXT
+    const Sprite *sprite;                // LAYER_SPRITE
+    int16_t x, y;                        // LAYER_SPRITE: posição do sprite
+    layer_effect_fn effect;              // LAYER_EFFECT
+    void *effect_state;                  // LAYER_EFFECT: estado repassado à função
+} Layer;
+
+typedef struct {
+    Layer layers[COMPOSITOR_MAX_LAYERS]; // Da camada de baixo para a de cima
+    int count;                           // Camadas usadas
+} Compositor;
+
+/**
+ * Esvazia o compositor.
+ * @param compositor Compositor
+ */
+extern void compositor_init(Compositor *compositor);
+
+/**
+ * Adiciona uma camada de cor única sobre as existentes.
+ * @param compositor Compositor
+ * @param color Cor
+ * @return Camada (opaca, modo normal, matriz inteira), ou NULL sem espaço
+ */
+extern Layer *compositor_add_solid(Compositor *compositor, RGBColor8 color);
+
+/**
+ * Adiciona uma camada de texto: a janela atual da rolagem vira a máscara.
+ * A rolagem é avançada por quem chama (scroll_animation_advance()).
+ * @param compositor Compositor
+ * @param text Rolagem preparada com scroll_animation_init()
+ * @param color Cor do texto
+ * @return Camada, ou NULL sem espaço
+ */
+extern Layer *compositor_add_text(Compositor *compositor, const ScrollAnimation *text, RGBColor8 color);
+
+/**
+ * Adiciona uma camada de sprite.
+ * @param compositor Compositor
+ * @param sprite Imagem
+ * @param x Coluna do canto superior esquerdo (pode ser negativa)
+ * @param y Linha do canto superior esquerdo (pode ser negativa)
+ * @return Camada, ou NULL sem espaço
+ */
+extern Layer *compositor_add_sprite(Compositor *compositor, const Sprite *sprite, int x, int y);
+
+/**
+ * Adiciona uma camada de efeito.
+ * @param compositor Compositor
+ * @param effect Função que gera os pixels a cada frame
+ * @param state Estado repassado à função
+ * @return Camada, ou NULL sem espaço
+ */
+extern Layer *compositor_add_effect(Compositor *compositor, layer_effect_fn effect, void *state);
+
+/**
+ * Restringe a camada a um retângulo da matriz.
+ * @param layer Camada
+ * @param x Coluna inicial
+ * @param y Linha inicial
+ * @param width Largura (0 = até a borda)
+ * @param height Altura (0 = até a borda)
+ */
+extern void layer_set_clip(Layer *layer, int x, int y, int width, int height);
+
+/**
+ * Compõe todas as camadas visíveis em pixels RGB (ordem lógica), por exemplo
+ * direto em framebuffer_back() seguido de framebuffer_mark_dirty().
+ * @param compositor Compositor
+ * @param out Saída com NUM_LEDS pixels
+ */
+extern void compositor_render(const Compositor *compositor, RGBColor8 *out);
+
+/**
+ * Empacota uma cor no formato de trabalho do compositor (0x00RRGGBB).
+ * @param color Cor
+ * @return Pixel empacotado
+ */
+static inline uint32_t compositor_pack(RGBColor8 color) {
+    return ((uint32_t)color.r << 16) | ((uint32_t)color.g << 8) | color.b;
+}
+
+#endif
@@ -0,0 +1,319 @@
+#include <math.h>
+#include <string.h>
+#include "effects.h"
+#include "framebuffer.h"
+
+// === PARÂMETROS DOS EFEITOS (derivados do tamanho da matriz na compilação) ===
+#define RAINBOW_SPAN (MATRIX_WIDTH + MATRIX_HEIGHT)
+#define RAINBOW_STEP (RAINBOW_SPAN < 256 ? 256 / RAINBOW_SPAN : 1)  // Matiz entre vizinhos
+#define PLASMA_SCALE_X (192 / MATRIX_WIDTH + 8)     // Ângulo por coluna
+#define PLASMA_SCALE_Y (192 / MATRIX_HEIGHT + 8)    // Ângulo por linha
+#define PLASMA_SCALE_D 11                            // Ângulo por diagonal
+#define FIRE_COOLING (576 / MATRIX_HEIGHT + 16)     // Resfriamento máximo por frame (o calor some ao subir a matriz)
+#define FIRE_SPARKING 120                            // Chance de faísca por coluna e frame (de 256)
+#define TWINKLE_SPAWNS (NUM_LEDS / 24 + 1)          // Tentativas de acender por frame
+#define TWINKLE_CHANCE 48                            // Chance de cada tentativa (de 256)
+#define WIPE_SPEED ((MATRIX_WIDTH << 8) / EFFECT_FPS + 1)  // Colunas por frame em 8.8 (uma passada por segundo)
+#define WIPE_HUE_STEP 48                             // Matiz entre passadas
+
+// === ORÇAMENTOS (ciclos do Cortex-M0+ por frame: base + por LED) ===
+static const EffectInfo effect_infos[EFFECT_COUNT] = {
+    [EFFECT_RAINBOW] = {"rainbow", 200, 24},
+    [EFFECT_PLASMA] = {"plasma", 1600, 36},
+    [EFFECT_FIRE] = {"fire", 800, 64},
+    [EFFECT_TWINKLE] = {"twinkle", 400, 40},
+    [EFFECT_BREATHING] = {"breathing", 200, 10},
+    [EFFECT_WIPE] = {"wipe", 200, 12},
+};
+
+// === TABELAS (montadas uma vez por boot) ===
+static uint8_t sine[256];                // 128 + 127 * sen(2πi/256)
+static uint8_t noise[256];               // Ruído fixo (xorshift), consultado por posição e frame
+static RGBColor8 hue_palette[256];       // Matiz com saturação e brilho máximos
+static RGBColor8 heat_palette[256];      // Preto → vermelho → amarelo → branco
+static bool tables_ready = false;
+
+/**
+ * Gerador xorshift de 32 bits
+ * @param state Estado (nunca zero)
+ * @return Próximo valor
+ */
+static inline uint32_t xorshift32(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+/**
+ * Escala um canal por um nível de 0 a 255 (255 mantém o valor)
+ */
+static inline uint8_t scale8(uint8_t value, uint8_t level) {
+    return (uint8_t)(((uint32_t)value * (level + 1u)) >> 8);
+}
+
+/**
+ * Monta as tabelas: ponto flutuante só aqui, o caminho por pixel é inteiro
+ */
+static void effect_tables_init(void) {
+    uint32_t rng = 0x9E3779B9u;
+
+    for (int i = 0; i < 256; i++) {
+        sine[i] = (uint8_t)lround(128.0 + 127.0 * sin(i * (2.0 * 3.14159265358979323846 / 256.0)));
+        noise[i] = (uint8_t)xorshift32(&rng);
+
+        // Três trechos de 85 passos: vermelho → verde → azul → vermelho
+        uint8_t h = (uint8_t)i, up, down;
+        uint8_t segment = h < 85 ? 0 : h < 170 ? 1 : 2;
+        up = (uint8_t)((h - segment * 85) * 3);
+        down = (uint8_t)(255 - up);
+        hue_palette[i] = segment == 0 ? (RGBColor8){down, up, 0}
+                       : segment == 1 ? (RGBColor8){0, down, up}
+                                      : (RGBColor8){up, 0, down};
+
+        // Calor em três terços: sobe o vermelho, depois o verde, depois o azul
+        uint8_t ramp = (uint8_t)((i % 85) * 3);
+        heat_palette[i] = i < 85 ? (RGBColor8){ramp, 0, 0}
+                        : i < 170 ? (RGBColor8){255, ramp, 0}
+                                  : (RGBColor8){255, 255, ramp};
+    }
+
+    tables_ready = true;
+}
+
+/**
+ * Seno por tabela
+ * @param angle Ângulo (256 = volta)
+ * @return 0 a 255
+ */
+uint8_t effect_sin8(uint8_t angle) {
+    if (!tables_ready) effect_tables_init();
+    return sine[angle];
+}
+
+/**
+ * Arco-íris: a matiz cresce um passo por coluna e por linha e anda com o tempo
+ */
+static void render_rainbow(Effect *effect, RGBColor8 *pixels) {
+    uint8_t row_hue = (uint8_t)(effect->frame * 2);
+
+    for (int y = 0; y < MATRIX_HEIGHT; y++, row_hue += RAINBOW_STEP) {
+        uint8_t hue = row_hue;
+        for (int x = 0; x < MATRIX_WIDTH; x++, hue += RAINBOW_STEP) {
+            *pixels++ = hue_palette[hue];
+        }
+    }
+}
+
+/**
+ * Plasma: três ondas (coluna, linha e diagonal) calculadas uma vez por frame;
+ * por pixel só a soma e a paleta
+ */
+static void render_plasma(Effect *effect, RGBColor8 *pixels) {
+    uint8_t columns[MATRIX_WIDTH], rows[MATRIX_HEIGHT], diagonals[MATRIX_WIDTH + MATRIX_HEIGHT - 1];
+    uint32_t t = effect->frame;
+
+    for (int x = 0; x < MATRIX_WIDTH; x++) columns[x] = sine[(uint8_t)(x * PLASMA_SCALE_X + t * 3)];
+    for (int y = 0; y < MATRIX_HEIGHT; y++) rows[y] = sine[(uint8_t)(y * PLASMA_SCALE_Y - t * 2)];
+    for (int d = 0; d < MATRIX_WIDTH + MATRIX_HEIGHT - 1; d++) {
+        diagonals[d] = sine[(uint8_t)(d * PLASMA_SCALE_D + t * 5)];
+    }
+
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+        const uint8_t *diagonal = &diagonals[y];
+        uint32_t row = rows[y];
+        for (int x = 0; x < MATRIX_WIDTH; x++) {
+            // Média das três ondas (× 85/256 ≈ ÷ 3), girando a paleta com o tempo
+            uint32_t sum = columns[x] + row + diagonal[x];
+            *pixels++ = hue_palette[(uint8_t)(((sum * 85) >> 8) + t)];
+        }
+    }
+}
+
+/**
+ * Fogo: cada célula esfria pelo ruído, o calor sobe misturando as duas de baixo
+ * e a base recebe faíscas ao acaso
+ */
+static void render_fire(Effect *effect, RGBColor8 *pixels) {
+    uint8_t *heat = effect->level;
+    uint8_t t = (uint8_t)effect->frame;
+
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
+        // Resfriamento
+        for (int y = 0; y < MATRIX_HEIGHT; y++) {
+            uint8_t *cell = &heat[y * MATRIX_WIDTH + x];
+            uint8_t cooling = (uint8_t)((noise[(uint8_t)(x * 29 + y * 13 + t)] * FIRE_COOLING) >> 8);
+            *cell = *cell > cooling ? (uint8_t)(*cell - cooling) : 0;
+        }
+
+        // Subida: de cima para baixo, cada célula recebe a média ponderada das duas abaixo
+        for (int y = 0; y < MATRIX_HEIGHT - 1; y++) {
+            uint32_t below = heat[(y + 1) * MATRIX_WIDTH + x];
+            uint32_t below2 = y + 2 < MATRIX_HEIGHT ? heat[(y + 2) * MATRIX_WIDTH + x] : below;
+            heat[y * MATRIX_WIDTH + x] = (uint8_t)(((below + 2 * below2) * 85) >> 8);
+        }
+
+        // Faísca na linha de baixo
+        uint32_t r = xorshift32(&effect->rng);
+        if ((r & 0xFF) < FIRE_SPARKING) {
+            uint8_t *base = &heat[(MATRIX_HEIGHT - 1) * MATRIX_WIDTH + x];
+            uint32_t spark = *base + 160 + ((r >> 8) & 0x5F);
+            *base = spark > 255 ? 255 : (uint8_t)spark;
+        }
+    }
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        pixels[i] = heat_palette[heat[i]];
+    }
+}
+
+/**
+ * Cintilação: todos os LEDs apagam 1/8 por frame e alguns acendem ao acaso
+ */
+static void render_twinkle(Effect *effect, RGBColor8 *pixels) {
+    uint8_t *level = effect->level;
+    RGBColor8 color = effect->color;
+
+    for (int s = 0; s < TWINKLE_SPAWNS; s++) {
+        uint32_t r = xorshift32(&effect->rng);
+        if ((r >> 24) < TWINKLE_CHANCE) {
+            level[((r & 0xFFFF) * NUM_LEDS) >> 16] = 255;
+        }
+    }
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        uint8_t l = level[i];
+        pixels[i] = (RGBColor8){scale8(color.r, l), scale8(color.g, l), scale8(color.b, l)};
+        level[i] = (uint8_t)((l * 7u) >> 3);
+    }
+}
+
+/**
+ * Respiração: uma cor para a matriz inteira, com brilho em seno ao quadrado
+ */
+static void render_breathing(Effect *effect, RGBColor8 *pixels) {
+    uint32_t wave = sine[(uint8_t)((effect->frame * 3) >> 1)];
+    uint8_t level = (uint8_t)((wave * wave) >> 8);
+    RGBColor8 color = {scale8(effect->color.r, level), scale8(effect->color.g, level), scale8(effect->color.b, level)};
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        pixels[i] = color;
+    }
+}
+
+/**
+ * Varredura: a borda anda da esquerda para a direita trocando a cor anterior pela nova
+ */
+static void render_wipe(Effect *effect, RGBColor8 *pixels) {
+    effect->position += WIPE_SPEED;
+    if ((effect->position >> 8) >= MATRIX_WIDTH) {
+        effect->position = 0;
+        effect->hue += WIPE_HUE_STEP;
+    }
+
+    RGBColor8 next = hue_palette[effect->hue];
+    RGBColor8 previous = hue_palette[(uint8_t)(effect->hue - WIPE_HUE_STEP)];
+    int edge = (effect->position >> 8) + 1;
+
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+        int x = 0;
+        for (; x < edge; x++) *pixels++ = next;
+        for (; x < MATRIX_WIDTH; x++) *pixels++ = previous;
+    }
+}
+
+typedef void (*effect_render_fn)(Effect *effect, RGBColor8 *pixels);
+
+static const effect_render_fn renderers[EFFECT_COUNT] = {
+    [EFFECT_RAINBOW] = render_rainbow,
+    [EFFECT_PLASMA] = render_plasma,
+    [EFFECT_FIRE] = render_fire,
+    [EFFECT_TWINKLE] = render_twinkle,
+    [EFFECT_BREATHING] = render_breathing,
+    [EFFECT_WIPE] = render_wipe,
+};
+
+/**
+ * Prepara um efeito
+ * @param effect Estado
+ * @param type Efeito
+ * @param color Cor base
+ * @param frames Frames até terminar (0 = sem fim)
+ * @param pio Instância PIO
+ * @param sm State machine
+ * @param intensity Intensidade em ponto fixo
+ */
+void effect_init(Effect *effect, EffectType type, RGBColor8 color, uint32_t frames, PIO pio, uint sm,
+                 uint16_t intensity) {
+    if (!tables_ready) effect_tables_init();
+
+    memset(effect, 0, sizeof(*effect));
+    effect->type = type < EFFECT_COUNT ? type : EFFECT_RAINBOW;
+    effect->frames = frames;
+    effect->rng = 0x2545F491u;
+    effect->color = color;
+    effect->intensity = intensity;
+    effect->pio = pio;
+    effect->sm = sm;
+}
+
+/**
+ * Desenha um frame
+ * @param effect Estado
+ * @param pixels Saída
+ */
+void effect_render(Effect *effect, RGBColor8 *pixels) {
+    renderers[effect->type](effect, pixels);
+    effect->frame++;
+}
+
+/**
+ * Passo para o escalonador
+ * @param state Ponteiro para Effect
+ * @return false ao terminar
+ */
+bool effect_step(void *state) {
+    Effect *effect = (Effect *)state;
+
+    effect_render(effect, framebuffer_back());
+    framebuffer_mark_dirty();
+    framebuffer_commit(effect->pio, effect->sm, effect->intensity);
+
+    return effect->frames == 0 || effect->frame < effect->frames;
+}
+
+/**
+ * Nome e orçamento
+ * @param type Efeito
+ * @return Descrição
+ */
+const EffectInfo *effect_info(EffectType type) {
+    return &effect_infos[type < EFFECT_COUNT ? type : EFFECT_RAINBOW];
+}
+
+/**
+ * Orçamento na matriz configurada
+ * @param type Efeito
+ * @return Ciclos por frame
+ */
+uint32_t effect_budget_cycles(EffectType type) {
+    const EffectInfo *info = effect_info(type);
+    return info->budget_base + (uint32_t)info->budget_per_led * NUM_LEDS;
+}
+
+/**
+ * Procura pelo nome
+ * @param name Nome
+ * @param type Saída
+ * @return true se encontrado
+ */
+bool effect_find(const char *name, EffectType *type) {
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        if (strcmp(name, effect_infos[i].name) == 0) {
+            *type = (EffectType)i;
+            return true;
+        }
+    }
+    return false;
+}
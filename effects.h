@@ -0,0 +1,112 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "led_functions.h"
+
+/**
+ * Efeitos procedurais em inteiros: arco-íris, plasma, fogo, cintilação,
+ * respiração e varredura. Nada de trigonometria por pixel: senos, ruído,
+ * paleta de matiz e paleta de calor são tabelas de 256 entradas montadas uma
+ * vez por boot, e o que depende de linha ou coluna é calculado uma vez por frame.
+ * Fogo e cintilação guardam estado por LED e só o atualizam a cada frame.
+ *
+ * Cada efeito declara um orçamento de ciclos por frame (base + custo por LED)
+ * que os benchmarks conferem no RP2040 a 5x5, 16x16 e 8x32; EFFECT_FPS frames
+ * por segundo precisam caber no clock com folga para a conversão e o envio.
+ */
+
+#ifndef EFFECT_FPS
+#define EFFECT_FPS 60                    // Frames por segundo dos efeitos
+#endif
+
+#define EFFECT_PERIOD_US (1000000 / EFFECT_FPS)  // Período do passo no escalonador
+
+typedef enum {
+    EFFECT_RAINBOW,                      // Faixas de matiz em diagonal andando
+    EFFECT_PLASMA,                       // Soma de senos em coluna, linha e diagonal
+    EFFECT_FIRE,                         // Calor sobe, esfria e recebe faíscas na base
+    EFFECT_TWINKLE,                      // LEDs acendem ao acaso e apagam devagar
+    EFFECT_BREATHING,                    // Matriz inteira pulsando em seno
+    EFFECT_WIPE,                         // Coluna a coluna, cada passada com uma cor nova
+    EFFECT_COUNT
+} EffectType;
+
+typedef struct {
+    const char *name;                    // Nome do efeito (emulador e benchmarks)
+    uint16_t budget_base;                // Ciclos fixos por frame (tabelas de linha/coluna, estado)
+    uint16_t budget_per_led;             // Ciclos por LED
+} EffectInfo;
+
+typedef struct {
+    EffectType type;                     // Efeito desenhado
+    uint32_t frame;                      // Frames desenhados desde effect_init()
+    uint32_t frames;                     // Frames até o passo terminar (0 = sem fim)
+    uint32_t rng;                        // Estado do xorshift (faíscas, cintilação)
+    RGBColor8 color;                     // Cor base (cintilação, respiração)
+    uint8_t hue;                         // Matiz atual (varredura)
+    uint16_t position;                   // Borda da varredura em 8.8
+    uint8_t level[NUM_LEDS];             // Calor (fogo) ou brilho (cintilação) de cada LED
+    uint16_t intensity;                  // Intensidade em ponto fixo
+    PIO pio;                             // Instância PIO
+    uint sm;                             // State machine
+} Effect;
+
+/**
+ * Prepara um efeito (e as tabelas, na primeira chamada).
+ * @param effect Estado do efeito
+ * @param type Efeito
+ * @param color Cor base da cintilação e da respiração
+ * @param frames Frames até effect_step() retornar false (0 = sem fim)
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ */
+extern void effect_init(Effect *effect, EffectType type, RGBColor8 color, uint32_t frames, PIO pio, uint sm,
+                        uint16_t intensity);
+
+/**
+ * Desenha o próximo frame e avança o estado.
+ * @param effect Estado do efeito
+ * @param pixels Saída com NUM_LEDS pixels em ordem lógica
+ */
+extern void effect_render(Effect *effect, RGBColor8 *pixels);
+
+/**
+ * Passo para o escalonador (período EFFECT_PERIOD_US): desenha no framebuffer e envia.
+ * @param state Ponteiro para Effect
+ * @return false depois de effect->frames frames
+ */
+extern bool effect_step(void *state);
+
+/**
+ * Nome e orçamento de um efeito.
+ * @param type Efeito
+ * @return Descrição constante
+ */
+extern const EffectInfo *effect_info(EffectType type);
+
+/**
+ * Orçamento do efeito para a matriz configurada.
+ * @param type Efeito
+ * @return Ciclos por frame (budget_base + budget_per_led * NUM_LEDS)
+ */
+extern uint32_t effect_budget_cycles(EffectType type);
+
+/**
+ * Procura um efeito pelo nome.
+ * @param name Nome (como em EffectInfo.name)
+ * @param type Saída
+ * @return false se o nome não existe
+ */
+extern bool effect_find(const char *name, EffectType *type);
+
+/**
+ * Seno inteiro por tabela: uma volta em 256 passos, saída de 0 a 255 (128 no zero).
+ * @param angle Ângulo (256 = volta completa)
+ * @return Valor do seno deslocado
+ */
+extern uint8_t effect_sin8(uint8_t angle);
+
+#endif
@@ -0,0 +1,120 @@
+#include "font.h"
+
+/**
+ * Lê um caractere UTF-8
+ * @param text Ponteiro para o texto
+ * @return Código Unicode (0 no fim)
+ */
+uint32_t font_decode_utf8(const char **text) {
+    const uint8_t *s = (const uint8_t *)*text;
+    uint32_t codepoint;
+    int extra;
+
+    if (s[0] == 0) return 0;
+
+    if (s[0] < 0x80) {
+        *text += 1;
+        return s[0];
+    } else if ((s[0] & 0xE0) == 0xC0) {
+        codepoint = s[0] & 0x1F;
+        extra = 1;
+    } else if ((s[0] & 0xF0) == 0xE0) {
+        codepoint = s[0] & 0x0F;
+        extra = 2;
+    } else if ((s[0] & 0xF8) == 0xF0) {
+        codepoint = s[0] & 0x07;
+        extra = 3;
+    } else {
+        // Byte de continuação solto ou inválido: consome só ele
+        *text += 1;
+        return FONT_REPLACEMENT;
+    }
+
+    for (int i = 1; i <= extra; i++) {
+        if ((s[i] & 0xC0) != 0x80) {
+            // Sequência cortada: para antes do byte que não pertence a ela (inclusive o fim)
+            *text += i;
+            return FONT_REPLACEMENT;
+        }
+        codepoint = (codepoint << 6) | (s[i] & 0x3F);
+    }
+    *text += extra + 1;
+
+    // Formas longas, substitutos UTF-16 e códigos além de U+10FFFF não são válidos
+    static const uint32_t minimum[4] = {0, 0x80, 0x800, 0x10000};
+    if (codepoint < minimum[extra] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        return FONT_REPLACEMENT;
+    }
+    return codepoint;
+}
+
+/**
+ * Busca binária nas faixas
+ * @param font Fonte
+ * @param codepoint Código Unicode
+ * @return Glifo
+ */
+uint16_t font_find_glyph(const Font *font, uint32_t codepoint) {
+    int low = 0, high = font->range_count - 1;
+
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        const FontRange *range = &font->ranges[middle];
+
+        if (codepoint < range->first) {
+            high = middle - 1;
+        } else if (codepoint >= range->first + range->count) {
+            low = middle + 1;
+        } else {
+            return (uint16_t)(range->glyph + (codepoint - range->first));
+        }
+    }
+    return font->fallback;
+}
+
+/**
+ * Busca binária nos pares de kerning
+ * @param font Fonte
+ * @param left Glifo da esquerda
+ * @param right Glifo da direita
+ * @return Ajuste em colunas
+ */
+int font_kerning(const Font *font, uint16_t left, uint16_t right) {
+    uint32_t pair = ((uint32_t)left << 16) | right;
+    int low = 0, high = font->kerning_count - 1;
+
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        uint32_t key = font->kerning[middle].pair;
+
+        if (pair < key) {
+            high = middle - 1;
+        } else if (pair > key) {
+            low = middle + 1;
+        } else {
+            return font->kerning[middle].adjust;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Largura do texto
+ * @param font Fonte
+ * @param text Texto UTF-8
+ * @param spacing Colunas entre glifos
+ * @return Largura em colunas
+ */
+int font_text_width(const Font *font, const char *text, int spacing) {
+    int width = 0;
+    int previous = -1;
+    uint32_t codepoint;
+
+    while ((codepoint = font_decode_utf8(&text)) != 0) {
+        uint16_t glyph = font_find_glyph(font, codepoint);
+        if (previous >= 0) width += spacing + font_kerning(font, (uint16_t)previous, glyph);
+        width += font_glyph_width(font, glyph);
+        previous = glyph;
+    }
+    return width;
+}
@@ -0,0 +1,102 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include "pico/stdlib.h"
+
+/**
+ * Fontes compiladas por font_compile.py (BDF ou folha PNG) em tabelas const,
+ * residentes na flash. Cada glifo é uma sequência de colunas de até 32 bits
+ * (bit y = linha y, linha 0 no bit 0) com largura própria; o texto é UTF-8 e o
+ * código Unicode é procurado em faixas ordenadas (índice esparso). Pares de
+ * kerning ajustam o avanço entre dois glifos. Toda consulta acontece quando o
+ * texto é preparado, nunca por frame.
+ */
+
+#define FONT_MAX_HEIGHT 32               // Linhas por glifo (uma coluna é uma máscara de 32 bits)
+#define FONT_REPLACEMENT 0xFFFD          // Código devolvido para sequências UTF-8 inválidas
+
+typedef struct {
+    uint16_t column;                     // Primeira coluna em Font.columns
+    uint8_t width;                       // Colunas do glifo (avanço sem espaçamento)
+} FontGlyph;
+
+typedef struct {
+    uint32_t first;                      // Primeiro código Unicode da faixa
+    uint16_t count;                      // Códigos seguidos
+    uint16_t glyph;                      // Glifo do primeiro código (os seguintes são consecutivos)
+} FontRange;
+
+typedef struct {
+    uint32_t pair;                       // Glifo da esquerda << 16 | glifo da direita
+    int8_t adjust;                       // Colunas somadas ao avanço (negativo aproxima)
+} FontKerning;
+
+typedef struct {
+    const char *name;                    // Nome da fonte
+    uint8_t height;                      // Linhas de todos os glifos
+    uint16_t fallback;                   // Glifo para códigos ausentes
+    uint16_t range_count;                // Faixas em ranges
+    uint16_t kerning_count;              // Pares em kerning
+    const uint32_t *columns;             // Colunas de todos os glifos
+    const FontGlyph *glyphs;             // Glifos
+    const FontRange *ranges;             // Faixas ordenadas por código
+    const FontKerning *kerning;          // Pares ordenados por pair
+} Font;
+
+// === FONTES COMPILADAS (font_compile() no CMakeLists.txt) ===
+extern const Font font_5x5;              // 5 linhas, largura variável, ASCII e acentos do português
+
+/**
+ * Lê um caractere UTF-8 e avança o ponteiro.
+ * @param text Ponteiro para o texto (avançado até o próximo caractere)
+ * @return Código Unicode, 0 no fim do texto ou FONT_REPLACEMENT se inválido
+ */
+extern uint32_t font_decode_utf8(const char **text);
+
+/**
+ * Procura o glifo de um código Unicode.
+ * @param font Fonte
+ * @param codepoint Código Unicode
+ * @return Índice do glifo (font->fallback se a fonte não tiver o código)
+ */
+extern uint16_t font_find_glyph(const Font *font, uint32_t codepoint);
+
+/**
+ * Ajuste de kerning entre dois glifos.
+ * @param font Fonte
+ * @param left Glifo da esquerda
+ * @param right Glifo da direita
+ * @return Colunas somadas ao avanço (0 sem par)
+ */
+extern int font_kerning(const Font *font, uint16_t left, uint16_t right);
+
+/**
+ * Largura do texto em colunas, com espaçamento e kerning.
+ * @param font Fonte
+ * @param text Texto UTF-8
+ * @param spacing Colunas vazias entre glifos
+ * @return Largura
+ */
+extern int font_text_width(const Font *font, const char *text, int spacing);
+
+/**
+ * Colunas de um glifo.
+ * @param font Fonte
+ * @param glyph Índice do glifo
+ * @return Primeira coluna (font->glyphs[glyph].width colunas)
+ */
+static inline const uint32_t *font_glyph_columns(const Font *font, uint16_t glyph) {
+    return &font->columns[font->glyphs[glyph].column];
+}
+
+/**
+ * Largura de um glifo.
+ * @param font Fonte
+ * @param glyph Índice do glifo
+ * @return Colunas
+ */
+static inline int font_glyph_width(const Font *font, uint16_t glyph) {
+    return font->glyphs[glyph].width;
+}
+
+#endif
@@ -0,0 +1,34 @@
+# Compila fontes BDF/PNG em tabelas C const (flash) com font_compile.py
+#
+#   font_compile(VARIAVEL NOME ENTRADA [KERNING ARQUIVO] [OPTIONS opções...])
+#
+# Gera ${CMAKE_CURRENT_BINARY_DIR}/fonts/NOME.c e o acrescenta à lista VARIAVEL.
+# O .c é refeito quando a fonte, o kerning ou o compilador mudam; a variável
+# Font NOME deve estar declarada em font.h.
+
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+set(FONT_COMPILER ${CMAKE_CURRENT_LIST_DIR}/font_compile.py)
+
+function(font_compile out_var name source)
+    cmake_parse_arguments(FONT "" "KERNING" "OPTIONS" ${ARGN})
+
+    set(output ${CMAKE_CURRENT_BINARY_DIR}/fonts/${name}.c)
+    set(arguments ${source} --nome ${name} -o ${output} ${FONT_OPTIONS})
+    set(depends ${FONT_COMPILER} ${source})
+    if(FONT_KERNING)
+        list(APPEND arguments --kerning ${FONT_KERNING})
+        list(APPEND depends ${FONT_KERNING})
+    endif()
+
+    add_custom_command(
+        OUTPUT ${output}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${CMAKE_CURRENT_BINARY_DIR}/fonts
+        COMMAND ${Python3_EXECUTABLE} ${FONT_COMPILER} ${arguments}
+        DEPENDS ${depends}
+        COMMENT "Compilando a fonte ${name}"
+        VERBATIM
+    )
+
+    set(${out_var} ${${out_var}} ${output} PARENT_SCOPE)
+endfunction()
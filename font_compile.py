@@ -0,0 +1,317 @@
+import argparse
+import os
+import sys
+import unicodedata
+
+# COMPILADOR DE FONTES PARA A MATRIZ (tabelas lidas por font.c)
+# Converte uma fonte BDF ou uma folha PNG de glifos em tabelas C const (flash):
+# colunas de cada glifo, larguras, faixas de códigos Unicode e pares de kerning.
+# Roda no build pela função font_compile() de font_compile.cmake, mas também à mão:
+#   python font_compile.py font_5x5.bdf --nome font_5x5 --kerning font_5x5.kern -o font_5x5.c
+#   python font_compile.py folha.png --celula 6x8 --caracteres " ABC..." --nome font_6x8 -o font_6x8.c
+# PNG precisa do Pillow (pip install pillow); BDF não tem dependências.
+
+ALTURA_MAXIMA = 32       # FONT_MAX_HEIGHT: uma coluna é uma máscara de 32 bits
+LIMIAR_PNG = 128         # Luminância a partir da qual um pixel da folha está aceso
+
+
+def ler_bdf(caminho):
+    """Lê um BDF e retorna (altura, {código: [colunas]})."""
+    glifos = {}
+    ascendente = descendente = None
+    caixa_fonte = None
+    codigo = largura = caixa = None
+    linhas_bitmap = None
+
+    for numero, linha in enumerate(open(caminho, encoding='latin-1'), 1):
+        partes = linha.split()
+        if not partes:
+            continue
+        chave = partes[0]
+
+        if linhas_bitmap is not None and chave != 'ENDCHAR':
+            linhas_bitmap.append(int(chave, 16))
+        elif chave == 'FONTBOUNDINGBOX':
+            caixa_fonte = [int(p) for p in partes[1:5]]
+        elif chave == 'FONT_ASCENT':
+            ascendente = int(partes[1])
+        elif chave == 'FONT_DESCENT':
+            descendente = int(partes[1])
+        elif chave == 'STARTCHAR':
+            codigo = largura = caixa = None
+        elif chave == 'ENCODING':
+            codigo = int(partes[1])
+        elif chave == 'DWIDTH':
+            largura = int(partes[1])
+        elif chave == 'BBX':
+            caixa = [int(p) for p in partes[1:5]]
+        elif chave == 'BITMAP':
+            linhas_bitmap = []
+        elif chave == 'ENDCHAR':
+            if codigo is None or codigo < 0 or caixa is None:
+                sys.exit(f"❌ {caminho}:{numero}: glifo sem ENCODING ou BBX")
+            glifos[codigo] = (largura if largura is not None else caixa[0], caixa, linhas_bitmap)
+            linhas_bitmap = None
+
+    # Linha de base: ascendente acima dela, descendente abaixo
+    if ascendente is None or descendente is None:
+        if caixa_fonte is None:
+            sys.exit(f"❌ {caminho}: sem FONT_ASCENT/FONT_DESCENT nem FONTBOUNDINGBOX")
+        ascendente = caixa_fonte[1] + caixa_fonte[3]
+        descendente = -caixa_fonte[3]
+    altura = ascendente + descendente
+
+    fonte = {}
+    for codigo, (avanco, (w, h, xo, yo), bitmap) in glifos.items():
+        largura = max(avanco, xo + w, 0)
+        colunas = [0] * largura
+        bytes_por_linha = (w + 7) // 8
+        for linha, bits in enumerate(bitmap[:h]):
+            # Linha do glifo na célula, contando do topo
+            y = ascendente - (yo + h) + linha
+            if not 0 <= y < altura:
+                continue
+            for x in range(w):
+                if bits >> (bytes_por_linha * 8 - 1 - x) & 1 and 0 <= xo + x < largura:
+                    colunas[xo + x] |= 1 << y
+        fonte[codigo] = colunas
+    return altura, fonte
+
+
+def ler_png(caminho, celula, caracteres, largura_espaco):
+    """Lê uma folha de glifos em grade e retorna (altura, {código: [colunas]})."""
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("❌ PNG precisa do Pillow: pip install pillow")
+
+    cw, ch = celula
+    imagem = Image.open(caminho).convert('LA')
+    por_linha = imagem.size[0] // cw
+    fonte = {}
+
+    for indice, caractere in enumerate(caracteres):
+        cx, cy = (indice % por_linha) * cw, (indice // por_linha) * ch
+        if cy + ch > imagem.size[1]:
+            sys.exit(f"❌ {caminho}: a folha tem menos células que --caracteres")
+
+        colunas = []
+        for x in range(cw):
+            mascara = 0
+            for y in range(ch):
+                luz, alfa = imagem.getpixel((cx + x, cy + y))
+                if luz >= LIMIAR_PNG and alfa >= LIMIAR_PNG:
+                    mascara |= 1 << y
+            colunas.append(mascara)
+
+        # Largura proporcional: colunas vazias das bordas saem (o espaço tem largura fixa)
+        while colunas and colunas[-1] == 0:
+            colunas.pop()
+        while colunas and colunas[0] == 0:
+            colunas.pop(0)
+        fonte[ord(caractere)] = colunas or [0] * largura_espaco
+    return ch, fonte
+
+
+def ler_kerning(caminho, fonte):
+    """Lê pares 'AB -1' (um por linha, # comenta) e retorna {(código, código): ajuste}."""
+    pares = {}
+    for numero, linha in enumerate(open(caminho, encoding='utf-8'), 1):
+        linha = linha.split('#', 1)[0].strip()
+        if not linha:
+            continue
+        partes = linha.split()
+        if len(partes) != 2 or len(partes[0]) != 2:
+            sys.exit(f"❌ {caminho}:{numero}: esperado 'AB ajuste'")
+        esquerda, direita = (ord(c) for c in partes[0])
+        for codigo in (esquerda, direita):
+            if codigo not in fonte:
+                sys.exit(f"❌ {caminho}:{numero}: '{chr(codigo)}' não existe na fonte")
+        pares[(esquerda, direita)] = int(partes[1])
+    return pares
+
+
+def apelidos_maiusculas(fonte):
+    """Códigos ausentes cuja maiúscula existe apontam para o glifo dela (sem custo na placa)."""
+    apelidos = {}
+    for codigo in fonte:
+        minuscula = chr(codigo).lower()
+        if len(minuscula) == 1 and ord(minuscula) not in fonte and minuscula.upper() == chr(codigo):
+            apelidos[ord(minuscula)] = codigo
+    return apelidos
+
+
+def montar_tabelas(fonte, apelidos, pares):
+    """Ordena glifos por código e agrupa códigos seguidos com glifos seguidos em faixas."""
+    codigos = sorted(fonte)
+    indice = {codigo: i for i, codigo in enumerate(codigos)}
+
+    # Todos os códigos (glifos próprios e apelidos) com o glifo de cada um
+    mapa = dict(indice)
+    for codigo, destino in apelidos.items():
+        mapa[codigo] = indice[destino]
+
+    faixas = []
+    for codigo in sorted(mapa):
+        glifo = mapa[codigo]
+        if faixas:
+            primeiro, quantidade, inicio = faixas[-1]
+            if codigo == primeiro + quantidade and glifo == inicio + quantidade and quantidade < 0xFFFF:
+                faixas[-1] = (primeiro, quantidade + 1, inicio)
+                continue
+        faixas.append((codigo, 1, glifo))
+
+    # Pares valem para os apelidos também, por serem pares de glifos
+    kerning = sorted(((indice[e] << 16) | indice[d], ajuste) for (e, d), ajuste in pares.items() if ajuste)
+    return codigos, faixas, kerning
+
+
+def caixa_5x5(colunas):
+    """Glifo no formato antigo de letters.h: 25 bits, linha 0 nos bits 24-20, centralizado."""
+    deslocamento = (5 - len(colunas)) // 2
+    mascara = 0
+    for x, coluna in enumerate(colunas):
+        for y in range(5):
+            if coluna >> y & 1:
+                mascara |= 1 << (24 - (y * 5 + x + deslocamento))
+    return mascara
+
+
+def nome_caractere(codigo):
+    """Comentário legível para cada glifo."""
+    caractere = chr(codigo)
+    if caractere.isprintable() and caractere not in "\\*/'":
+        return f"'{caractere}'"
+    return unicodedata.name(caractere, f'U+{codigo:04X}')
+
+
+def escrever_c(caminho, nome, origem, altura, fonte, codigos, faixas, kerning, fallback, ascii_5x5, apelidos):
+    """Grava as tabelas como arrays C const."""
+    colunas_por_glifo = [fonte[c] for c in codigos]
+    tamanho = 0
+
+    with open(caminho, 'w', encoding='utf-8') as f:
+        f.write(f"// Gerado por font_compile.py a partir de {origem}. Não editar à mão.\n")
+        f.write('#include "font.h"\n')
+        if ascii_5x5:
+            f.write('#include "letters.h"\n')
+
+        f.write(f"\n// Colunas dos glifos: bit y = linha y\nstatic const uint32_t {nome}_columns[] = {{\n")
+        for codigo, colunas in zip(codigos, colunas_por_glifo):
+            valores = ", ".join(f"0x{c:0{(altura + 3) // 4}X}" for c in colunas) or "0"
+            f.write(f"    {valores},  // {nome_caractere(codigo)}\n")
+        f.write("};\n")
+        tamanho += 4 * max(1, sum(len(c) for c in colunas_por_glifo))
+
+        f.write(f"\nstatic const FontGlyph {nome}_glyphs[] = {{\n")
+        coluna = 0
+        for codigo, colunas in zip(codigos, colunas_por_glifo):
+            f.write(f"    {{{coluna}, {len(colunas)}}},  // {nome_caractere(codigo)}\n")
+            coluna += len(colunas)
+        f.write("};\n")
+        tamanho += 4 * len(codigos)
+
+        f.write(f"\nstatic const FontRange {nome}_ranges[] = {{\n")
+        for primeiro, quantidade, glifo in faixas:
+            ultimo = primeiro + quantidade - 1
+            comentario = nome_caractere(primeiro) + (f" a {nome_caractere(ultimo)}" if quantidade > 1 else "")
+            f.write(f"    {{0x{primeiro:04X}, {quantidade}, {glifo}}},  // {comentario}\n")
+        f.write("};\n")
+        tamanho += 8 * len(faixas)
+
+        if kerning:
+            f.write(f"\nstatic const FontKerning {nome}_kerning[] = {{\n")
+            for par, ajuste in kerning:
+                esquerda, direita = codigos[par >> 16], codigos[par & 0xFFFF]
+                f.write(f"    {{0x{par:08X}, {ajuste}}},  // {nome_caractere(esquerda)} {nome_caractere(direita)}\n")
+            f.write("};\n")
+            tamanho += 8 * len(kerning)
+
+        f.write(f"\nconst Font {nome} = {{\n"
+                f"    .name = \"{nome}\",\n"
+                f"    .height = {altura},\n"
+                f"    .fallback = {fallback},\n"
+                f"    .range_count = {len(faixas)},\n"
+                f"    .kerning_count = {len(kerning)},\n"
+                f"    .columns = {nome}_columns,\n"
+                f"    .glyphs = {nome}_glyphs,\n"
+                f"    .ranges = {nome}_ranges,\n"
+                f"    .kerning = {'{}_kerning'.format(nome) if kerning else 'NULL'},\n"
+                f"}};\n")
+
+        if ascii_5x5:
+            # Tabela direta do caminho de largura fixa (glyph_for_char()): O(1) por caractere.
+            # Códigos sem glifo (ou largos demais para 5 colunas) usam o mesmo substituto da fonte
+            substituto = codigos[fallback]
+            mascara_substituto = caixa_5x5(fonte[substituto]) if len(fonte[substituto]) <= 5 else 0
+            f.write(f"\n// ASCII -> glifo 5x5 de 25 bits (letters.h); sem glifo vale o substituto "
+                    f"({nome_caractere(substituto)})\n"
+                    f"const uint32_t {nome}_ascii[128] = {{\n")
+            for codigo in range(128):
+                origem_codigo = apelidos.get(codigo, codigo)
+                if origem_codigo in fonte and len(fonte[origem_codigo]) <= 5:
+                    mascara = caixa_5x5(fonte[origem_codigo])
+                else:
+                    mascara = mascara_substituto
+                if mascara:
+                    f.write(f"    [0x{codigo:02X}] = 0x{mascara:07X},  // {nome_caractere(codigo)}\n")
+            f.write("};\n")
+            f.write(f"\n// Bytes fora do ASCII (cada byte de um caractere UTF-8)\n"
+                    f"const uint32_t {nome}_ascii_fallback = 0x{mascara_substituto:07X};\n")
+            tamanho += 4 * 129
+    return tamanho
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compila fontes BDF/PNG em tabelas C para a matriz de LEDs')
+    parser.add_argument('entrada', help='Fonte .bdf ou folha .png')
+    parser.add_argument('-o', '--saida', required=True, help='Arquivo .c gerado')
+    parser.add_argument('--nome', required=True, help='Nome da variável Font (declarada em font.h)')
+    parser.add_argument('--kerning', help="Pares de kerning, uma linha 'AB -1' por par")
+    parser.add_argument('--maiusculas', action='store_true', help='Minúsculas ausentes usam o glifo da maiúscula')
+    parser.add_argument('--substituto', default='?', help='Caractere para códigos ausentes (padrão ?)')
+    parser.add_argument('--ascii-5x5', action='store_true',
+                        help='Gera também NOME_ascii[128], a tabela de largura fixa de letters.h')
+    parser.add_argument('--celula', default='5x5', help='PNG: tamanho de cada célula LxA')
+    parser.add_argument('--caracteres', help='PNG: caracteres da folha, na ordem das células')
+    parser.add_argument('--largura-espaco', type=int, default=3, help='PNG: largura de células vazias')
+    args = parser.parse_args()
+
+    if args.entrada.lower().endswith('.png'):
+        if not args.caracteres:
+            sys.exit("❌ Folhas PNG precisam de --caracteres")
+        celula = tuple(int(v) for v in args.celula.lower().split('x'))
+        altura, fonte = ler_png(args.entrada, celula, args.caracteres, args.largura_espaco)
+    else:
+        altura, fonte = ler_bdf(args.entrada)
+
+    if not fonte:
+        sys.exit("❌ Nenhum glifo na entrada")
+    if altura > ALTURA_MAXIMA:
+        sys.exit(f"❌ Altura {altura} acima de {ALTURA_MAXIMA} linhas")
+    if args.ascii_5x5 and altura != 5:
+        sys.exit("❌ --ascii-5x5 exige uma fonte de 5 linhas")
+    largura_maxima = max(len(c) for c in fonte.values())
+    if largura_maxima > 255:
+        sys.exit("❌ Glifo com mais de 255 colunas")
+
+    apelidos = apelidos_maiusculas(fonte) if args.maiusculas else {}
+    pares = ler_kerning(args.kerning, fonte) if args.kerning else {}
+    codigos, faixas, kerning = montar_tabelas(fonte, apelidos, pares)
+
+    substituto = ord(args.substituto)
+    if substituto not in fonte:
+        substituto = 0x20 if 0x20 in fonte else codigos[0]
+    fallback = codigos.index(substituto)
+
+    origem = os.path.basename(args.entrada)
+    tamanho = escrever_c(args.saida, args.nome, origem, altura, fonte, codigos, faixas, kerning, fallback,
+                         args.ascii_5x5, apelidos)
+
+    print(f"✅ {args.nome}: {len(codigos)} glifos + {len(apelidos)} apelidos, altura {altura}, "
+          f"largura até {largura_maxima} -> {args.saida}")
+    print(f"   {len(faixas)} faixas de códigos, {len(kerning)} pares de kerning, {tamanho} bytes na flash")
+
+
+if __name__ == '__main__':
+    main()
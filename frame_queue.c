@@ -0,0 +1,79 @@
+#include "hardware/sync.h"
+#include "frame_queue.h"
+
+#define FRAME_QUEUE_MASK (FRAME_QUEUE_DEPTH - 1)
+
+// === ANEL DE FRAMEBUFFERS ===
+static QueuedFrame slots[FRAME_QUEUE_DEPTH];
+static volatile uint32_t head = 0;  // Próximo slot a publicar (escrito só pelo produtor)
+static volatile uint32_t tail = 0;  // Próximo slot a consumir (escrito só pelo consumidor)
+
+/**
+ * Esvazia a fila
+ */
+void frame_queue_reset(void) {
+    head = 0;
+    tail = 0;
+}
+
+/**
+ * Obtém o slot livre do produtor
+ * @return Slot livre ou NULL se cheia
+ */
+QueuedFrame *frame_queue_acquire(void) {
+    // Os índices crescem livremente; a diferença dá a ocupação mesmo após overflow
+    if (head - tail >= FRAME_QUEUE_DEPTH) return NULL;
+    return &slots[head & FRAME_QUEUE_MASK];
+}
+
+/**
+ * Obtém o slot livre, dormindo até o consumidor liberar espaço
+ * @return Slot livre
+ */
+QueuedFrame *frame_queue_acquire_blocking(void) {
+    QueuedFrame *frame;
+    while ((frame = frame_queue_acquire()) == NULL) {
+        __wfe();
+    }
+    return frame;
+}
+
+/**
+ * Publica o slot preenchido
+ */
+void frame_queue_publish(void) {
+    // Garante que o conteúdo do frame fica visível antes do novo head
+    __dmb();
+    head = head + 1;
+    __sev();
+}
+
+/**
+ * Retorna o frame mais antigo sem removê-lo
+ * @return Frame ou NULL se vazia
+ */
+const QueuedFrame *frame_queue_peek(void) {
+    if (tail == head) return NULL;
+
+    // Lê o conteúdo só depois de observar o head atualizado
+    __dmb();
+    return &slots[tail & FRAME_QUEUE_MASK];
+}
+
+/**
+ * Libera o frame consumido
+ */
+void frame_queue_release(void) {
+    // Termina as leituras do slot antes de devolvê-lo ao produtor
+    __dmb();
+    tail = tail + 1;
+    __sev();
+}
+
+/**
+ * Ocupação atual da fila
+ * @return Número de frames publicados
+ */
+uint frame_queue_count(void) {
+    return head - tail;
+}
@@ -0,0 +1,59 @@
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#include "pico/stdlib.h"
+#include "led_functions.h"
+
+#define FRAME_QUEUE_DEPTH 4              // Número de framebuffers no anel (potência de 2)
+
+typedef struct {
+    RGBColor8 pixels[NUM_LEDS];          // Pixels em ordem lógica (linha a linha)
+    uint16_t intensity;                  // Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+} QueuedFrame;
+
+/**
+ * Anel SPSC (um produtor, um consumidor) de framebuffers, sem locks.
+ * O produtor (núcleo 0) só escreve em head; o consumidor (núcleo 1) só escreve em tail.
+ * Os frames são escritos e lidos direto no anel, sem cópia extra.
+ */
+
+/**
+ * Esvazia a fila. Só deve ser chamada antes de os dois lados começarem a usá-la.
+ */
+extern void frame_queue_reset(void);
+
+/**
+ * Produtor: obtém o próximo slot livre para desenhar um frame.
+ * @return Ponteiro para o slot, ou NULL se a fila estiver cheia
+ */
+extern QueuedFrame *frame_queue_acquire(void);
+
+/**
+ * Produtor: publica o slot obtido em frame_queue_acquire() e acorda o consumidor.
+ */
+extern void frame_queue_publish(void);
+
+/**
+ * Produtor: como frame_queue_acquire(), mas dorme (__wfe) até haver espaço.
+ * @return Ponteiro para o slot livre
+ */
+extern QueuedFrame *frame_queue_acquire_blocking(void);
+
+/**
+ * Consumidor: retorna o frame mais antigo publicado, sem removê-lo.
+ * @return Ponteiro para o frame, ou NULL se a fila estiver vazia
+ */
+extern const QueuedFrame *frame_queue_peek(void);
+
+/**
+ * Consumidor: libera o frame obtido em frame_queue_peek() e acorda o produtor.
+ */
+extern void frame_queue_release(void);
+
+/**
+ * Quantidade de frames publicados e ainda não consumidos.
+ * @return Número de frames na fila
+ */
+extern uint frame_queue_count(void);
+
+#endif
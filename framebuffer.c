@@ -0,0 +1,144 @@
+#include <string.h>
+#include "framebuffer.h"
+
+// === BUFFERS ===
+// Back e front são ponteiros para que um frame recebido no front (framebuffer_spare())
+// entre no lugar do back sem cópia
+static RGBColor8 buffers[2][NUM_LEDS];
+static RGBColor8 *back = buffers[0];   // Buffer de desenho
+static RGBColor8 *front = buffers[1];  // Último frame enviado
+static int32_t front_intensity = -1;   // Intensidade do último envio (-1 = nada enviado)
+static bool dirty = true;              // Houve escrita desde o último commit
+static bool spare_lent = false;        // Front emprestado por framebuffer_spare()
+
+/**
+ * Escreve um pixel, marcando sujo só quando o valor muda
+ * @param index Índice lógico
+ * @param color Cor do pixel
+ */
+static inline void write_pixel(int index, RGBColor8 color) {
+    RGBColor8 *pixel = &back[index];
+
+    if (pixel->r != color.r || pixel->g != color.g || pixel->b != color.b) {
+        *pixel = color;
+        dirty = true;
+    }
+}
+
+/**
+ * Acende um pixel por coordenada
+ * @param x Coluna
+ * @param y Linha
+ * @param color Cor do pixel
+ */
+void framebuffer_set_pixel(int x, int y, RGBColor8 color) {
+    if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT) return;
+    write_pixel(y * MATRIX_WIDTH + x, color);
+}
+
+/**
+ * Lê um pixel por coordenada
+ * @param x Coluna
+ * @param y Linha
+ * @return Cor do pixel
+ */
+RGBColor8 framebuffer_get_pixel(int x, int y) {
+    if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT) return (RGBColor8){0, 0, 0};
+    return back[y * MATRIX_WIDTH + x];
+}
+
+/**
+ * Acende um pixel por índice lógico
+ * @param index Índice lógico
+ * @param color Cor do pixel
+ */
+void framebuffer_set_index(int index, RGBColor8 color) {
+    if (index < 0 || index >= NUM_LEDS) return;
+    write_pixel(index, color);
+}
+
+/**
+ * Preenche o buffer de desenho
+ * @param color Cor de preenchimento
+ */
+void framebuffer_fill(RGBColor8 color) {
+    for (int i = 0; i < NUM_LEDS; i++) {
+        write_pixel(i, color);
+    }
+}
+
+/**
+ * Acesso direto ao buffer de desenho
+ * @return Ponteiro para o back buffer
+ */
+RGBColor8 *framebuffer_back(void) {
+    return back;
+}
+
+/**
+ * Empresta o front para receber um frame inteiro
+ * @return Ponteiro para o buffer livre
+ */
+RGBColor8 *framebuffer_spare(void) {
+    spare_lent = true;
+    front_intensity = -1;
+    return front;
+}
+
+/**
+ * Troca o buffer livre pelo de desenho
+ */
+void framebuffer_swap_in(void) {
+    RGBColor8 *received = front;
+    front = back;
+    back = received;
+
+    spare_lent = false;
+    front_intensity = -1;
+    dirty = true;
+}
+
+/**
+ * Devolve o buffer livre sem usá-lo
+ */
+void framebuffer_spare_release(void) {
+    spare_lent = false;
+}
+
+/**
+ * Marca o buffer de desenho como alterado
+ */
+void framebuffer_mark_dirty(void) {
+    dirty = true;
+}
+
+/**
+ * Força o reenvio no próximo commit
+ */
+void framebuffer_invalidate(void) {
+    front_intensity = -1;
+    dirty = true;
+}
+
+/**
+ * Envia o frame se algo mudou
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param intensity Intensidade em ponto fixo
+ * @return true se enviou
+ */
+bool framebuffer_commit(PIO pio, uint sm, uint16_t intensity) {
+    if (!dirty && front_intensity == intensity) return false;
+    dirty = false;
+
+    // Escritas que voltaram ao valor anterior não geram envio
+    if (front_intensity == intensity && memcmp(back, front, NUM_LEDS * sizeof(RGBColor8)) == 0) return false;
+
+    display_pixels_fixed(back, pio, sm, intensity);
+
+    // Com o front emprestado, o próximo commit também envia
+    if (spare_lent) return true;
+    memcpy(front, back, NUM_LEDS * sizeof(RGBColor8));
+    front_intensity = intensity;
+    return true;
+}
@@ -0,0 +1,91 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "led_functions.h"
+
+/**
+ * Framebuffer persistente com buffer duplo:
+ * - back: onde as funções de desenho escrevem (o conteúdo permanece entre frames)
+ * - front: o que foi enviado aos LEDs no último commit
+ * O commit só envia quando o back difere do front, então em regime estacionário
+ * nenhum dado trafega no barramento.
+ */
+
+/**
+ * Acende um pixel no buffer de desenho.
+ * @param x Coluna (0 a MATRIX_WIDTH - 1)
+ * @param y Linha (0 a MATRIX_HEIGHT - 1)
+ * @param color Cor do pixel
+ */
+extern void framebuffer_set_pixel(int x, int y, RGBColor8 color);
+
+/**
+ * Lê um pixel do buffer de desenho.
+ * @param x Coluna (0 a MATRIX_WIDTH - 1)
+ * @param y Linha (0 a MATRIX_HEIGHT - 1)
+ * @return Cor do pixel (preto fora dos limites)
+ */
+extern RGBColor8 framebuffer_get_pixel(int x, int y);
+
+/**
+ * Acende um pixel pelo índice lógico (linha a linha, 0 = canto superior esquerdo).
+ * @param index Índice lógico (0 a NUM_LEDS - 1)
+ * @param color Cor do pixel
+ */
+extern void framebuffer_set_index(int index, RGBColor8 color);
+
+/**
+ * Preenche todo o buffer de desenho com uma cor.
+ * @param color Cor de preenchimento
+ */
+extern void framebuffer_fill(RGBColor8 color);
+
+/**
+ * Acesso direto ao buffer de desenho (NUM_LEDS pixels em ordem lógica).
+ * Quem escreve por aqui deve chamar framebuffer_mark_dirty().
+ * @return Ponteiro para os pixels do back buffer
+ */
+extern RGBColor8 *framebuffer_back(void);
+
+/**
+ * Empresta o buffer do último envio (front) para receber um frame inteiro fora do
+ * buffer de desenho. Enquanto emprestado, todo commit envia o frame, sem comparar.
+ * O empréstimo termina com framebuffer_swap_in() ou framebuffer_spare_release().
+ * @return Ponteiro para NUM_LEDS pixels livres
+ */
+extern RGBColor8 *framebuffer_spare(void);
+
+/**
+ * Troca os ponteiros: o buffer livre, já preenchido, vira o buffer de desenho (sem
+ * cópia) e marca o frame como alterado.
+ */
+extern void framebuffer_swap_in(void);
+
+/**
+ * Devolve o buffer livre sem usá-lo (pacote descartado).
+ */
+extern void framebuffer_spare_release(void);
+
+/**
+ * Marca o buffer de desenho como alterado.
+ */
+extern void framebuffer_mark_dirty(void);
+
+/**
+ * Esquece o conteúdo enviado, forçando o próximo commit a reenviar o frame.
+ * Usar quando outra rotina escreveu nos LEDs sem passar pelo framebuffer.
+ */
+extern void framebuffer_invalidate(void);
+
+/**
+ * Envia o buffer de desenho aos LEDs se ele mudou desde o último commit.
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ * @return true se um frame foi enviado, false se nada mudou
+ */
+extern bool framebuffer_commit(PIO pio, uint sm, uint16_t intensity);
+
+#endif
@@ -1,19 +1,9 @@
 #include "frames.h"
 
-double clear[NUM_LEDS] =
-{
-        0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0
-};
+double clear[NUM_LEDS] = {0};
 
+// Todos os LEDs acesos, qualquer que seja o tamanho configurado da matriz
 double full[NUM_LEDS] =
 {
-        1, 1, 1, 1, 1,
-        1, 1, 1, 1, 1,
-        1, 1, 1, 1, 1,
-        1, 1, 1, 1, 1,
-        1, 1, 1, 1, 1
-};
\ No newline at end of file
+        [0 ... NUM_LEDS - 1] = 1
+};
@@ -3,7 +3,7 @@
 
 #include "pico/stdlib.h"
 
-#define NUM_LEDS 25
+#include "matrix_config.h"
 
 extern double full[NUM_LEDS];
 extern double clear[NUM_LEDS];
@@ -0,0 +1,80 @@
+#include "gamma_dither.h"
+
+/**
+ * Tabela de gama com a intensidade aplicada, recalculada só quando a intensidade muda
+ * @param intensity Intensidade em ponto fixo (0-256)
+ * @return Tabela de 256 entradas em 16 bits
+ */
+const uint16_t *gamma_table(uint16_t intensity) {
+    static uint16_t base[256];               // Curva de gama com intensidade total
+    static uint16_t table[256];
+    static bool base_ready = false;
+    static int32_t table_intensity = -1;     // Força o cálculo na primeira chamada
+
+    // Ponto flutuante só aqui, uma vez por boot: o caminho por pixel é inteiro
+    if (!base_ready) {
+        for (int v = 0; v < 256; v++) {
+            base[v] = (uint16_t)(pow(v / 255.0, GAMMA_DITHER_GAMMA) * 65535.0 + 0.5);
+        }
+        base_ready = true;
+    }
+
+    if (intensity > INTENSITY_FIXED_MAX) intensity = INTENSITY_FIXED_MAX;
+
+    if (table_intensity != intensity) {
+        for (int v = 0; v < 256; v++) {
+            table[v] = (uint16_t)(((uint32_t)base[v] * intensity) >> 8);
+        }
+        table_intensity = intensity;
+    }
+
+    return table;
+}
+
+/**
+ * Zera os acumuladores com fase espalhada entre os LEDs
+ * @param state Estado do dithering
+ */
+void gamma_dither_reset(DitherState *state) {
+    for (int i = 0; i < NUM_LEDS; i++) {
+        // Passo ímpar: percorre as 256 fases antes de repetir
+        uint8_t phase = (uint8_t)(i * 97);
+        state->error[i][0] = phase;
+        state->error[i][1] = phase + 85;
+        state->error[i][2] = phase + 170;
+    }
+}
+
+/**
+ * Soma a fração ao acumulador e retorna o nível do fio
+ * @param linear Valor linear em 8.8
+ * @param error Acumulador do canal
+ * @return Nível de 8 bits deste frame
+ */
+static inline uint32_t dither_channel(uint16_t linear, uint8_t *error) {
+    uint32_t acc = (uint32_t)linear + *error;
+    *error = (uint8_t)acc;
+
+    // Só o topo da escala pode transbordar
+    uint32_t level = acc >> 8;
+    return level > 255 ? 255 : level;
+}
+
+/**
+ * Converte pixels RGB com gama e dithering temporal
+ * @param pixels Pixels em ordem lógica, NUM_LEDS posições
+ * @param table Tabela de gamma_table()
+ * @param state Acumuladores
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+void pack_pixels_dithered(const RGBColor8 *pixels, const uint16_t *table, DitherState *state, uint32_t *words) {
+    for (int i = 0; i < NUM_LEDS; i++) {
+        RGBColor8 pixel = pixels[map_index_to_position(i)];
+        uint8_t *error = state->error[i];
+
+        uint32_t r = dither_channel(table[pixel.r], &error[0]);
+        uint32_t g = dither_channel(table[pixel.g], &error[1]);
+        uint32_t b = dither_channel(table[pixel.b], &error[2]);
+        words[i] = (g << 24) | (r << 16) | (b << 8);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef GAMMA_DITHER_H
+#define GAMMA_DITHER_H
+
+#include "pico/stdlib.h"
+#include "led_functions.h"
+
+/**
+ * Saída com correção de gama e dithering temporal.
+ * Cada canal passa por uma tabela de gama para um espaço linear de 16 bits
+ * (8 bits inteiros no fio + 8 bits de fração), já com a intensidade aplicada.
+ * A fração vai para um acumulador de erro por LED e canal: somada frame a frame,
+ * ela acende o nível seguinte na proporção certa, então a média no tempo
+ * atinge os níveis intermediários que um único frame de 8 bits não tem.
+ * Só funciona com a matriz sendo reenviada em alta frequência, o que o núcleo 1
+ * faz quando o dithering está ligado (output_core_set_dither()).
+ */
+
+#ifndef GAMMA_DITHER_GAMMA
+#define GAMMA_DITHER_GAMMA 2.2           // Expoente da curva de gama
+#endif
+
+#ifndef GAMMA_DITHER_REFRESH_HZ
+#define GAMMA_DITHER_REFRESH_HZ 400      // Frequência alvo de reenvio (limitada pelo tempo de fio)
+#endif
+
+typedef struct {
+    uint8_t error[NUM_LEDS][3];          // Fração acumulada por LED (ordem física) e canal
+} DitherState;
+
+/**
+ * Retorna a tabela de gama (256 entradas, linear em 16 bits) para a intensidade informada.
+ * A curva base é calculada uma vez; a tabela só é refeita quando a intensidade muda.
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ * @return Tabela com tabela[v] = 65535 * (v / 255)^gama * intensity / 256
+ */
+extern const uint16_t *gamma_table(uint16_t intensity);
+
+/**
+ * Zera os acumuladores, espalhando a fase inicial entre os LEDs para que áreas
+ * de cor uniforme não pisquem em sincronia.
+ * @param state Estado do dithering
+ */
+extern void gamma_dither_reset(DitherState *state);
+
+/**
+ * Converte pixels RGB de 8 bits (ordem lógica) nas palavras G|R|B (ordem física)
+ * com gama e dithering temporal. Só inteiros: por canal, uma consulta, uma soma e um deslocamento.
+ * @param pixels Pixels em ordem lógica (NUM_LEDS posições)
+ * @param table Tabela de gama_table()
+ * @param state Acumuladores, atualizados a cada chamada
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+extern void pack_pixels_dithered(const RGBColor8 *pixels, const uint16_t *table, DitherState *state, uint32_t *words);
+
+#endif
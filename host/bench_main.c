@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include "benchmark.h"
+#include "matrix_geometry.h"
+#include "led_functions.h"
+#include "emulator.h"
+
+// Benchmark do caminho de renderização no host. Cada executável é compilado
+// para um tamanho de matriz (MATRIX_WIDTH x MATRIX_HEIGHT) e escreve CSV:
+//   ./build_host/led_bench_5x5 > bench_5x5.csv
+
+static RGBColor8 dma_pixels[NUM_LEDS];   // Frame enviado pelo caso de DMA
+
+/**
+ * Monta um frame no buffer livre e dispara o DMA simulado (espera o latch do anterior)
+ * @param context Não usado
+ * @return Primeira palavra enviada
+ */
+static uint32_t bench_dma_submit_frame(void *context) {
+    (void)context;
+    pack_pixels_fixed(dma_pixels, 26, led_dma_get_back_buffer());
+    led_dma_submit(NUM_LEDS);
+    return led_dma_get_front_buffer()[0];
+}
+
+int main(void) {
+    matrix_geometry_init(NULL);
+    benchmark_run_all(stdout);
+
+    // Envio por DMA: tempo de CPU por frame no host e, no relógio virtual, o período
+    // entre frames imposto pelo fio e pelo latch (DMA,period_us,wire_us,latch_us)
+    for (int i = 0; i < NUM_LEDS; i++) {
+        dma_pixels[i] = (RGBColor8){(uint8_t)i, (uint8_t)(i * 3), (uint8_t)(i * 7)};
+    }
+    emulator_set_capture(false);
+    if (led_dma_init(pio0, 0)) {
+        BenchmarkResult result = benchmark_measure("dma_submit_frame", bench_dma_submit_frame, NULL);
+        benchmark_print(stdout, &result, true);
+
+        uint64_t virtual_start_us = time_us_64();
+        for (int i = 0; i < 16; i++) bench_dma_submit_frame(NULL);
+        uint64_t period_us = (time_us_64() - virtual_start_us) / 16;
+        printf("DMA,%llu,%d,%d\n", (unsigned long long)period_us, NUM_LEDS * EMULATOR_WORD_US, LED_DMA_LATCH_US);
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include <stdlib.h>
+#include <string.h>
+#include "emulator.h"
+#include "matrix_geometry.h"
+
+// === ESTADO DO DECODIFICADOR ===
+static EmulatorFrame *frames = NULL;   // Frames travados
+static uint frame_count = 0;           // Frames válidos
+static uint frame_capacity = 0;        // Capacidade alocada
+static EmulatorFrame pending;          // Frame recebendo palavras
+static bool has_pending = false;       // Há palavras desde o último latch
+static uint64_t wire_end_us = 0;       // Fim da última palavra no fio
+static uint32_t leds[NUM_LEDS];        // Cor atual de cada LED da cadeia
+static bool capture = true;            // Guarda os frames travados
+
+/**
+ * Descarta os frames capturados e apaga os LEDs
+ */
+void emulator_reset(void) {
+    free(frames);
+    frames = NULL;
+    frame_count = 0;
+    frame_capacity = 0;
+    has_pending = false;
+    wire_end_us = 0;
+    memset(leds, 0, sizeof(leds));
+}
+
+/**
+ * Trava o frame pendente: as palavras recebidas passam a valer nos LEDs
+ * @param latch_us Instante do latch
+ */
+static void emulator_latch(uint64_t latch_us) {
+    if (!has_pending) return;
+
+    // LEDs além das palavras recebidas mantêm a cor anterior
+    memcpy(leds, pending.words, pending.count * sizeof(uint32_t));
+    has_pending = false;
+    if (!capture) return;
+
+    if (frame_count == frame_capacity) {
+        frame_capacity = frame_capacity ? frame_capacity * 2 : 256;
+        frames = realloc(frames, frame_capacity * sizeof(EmulatorFrame));
+    }
+
+    EmulatorFrame *frame = &frames[frame_count++];
+    frame->time_us = latch_us;
+    frame->count = pending.count;
+    memcpy(frame->words, leds, sizeof(leds));
+}
+
+/**
+ * Liga ou desliga a gravação dos frames
+ * @param enabled Gravação ligada
+ */
+void emulator_set_capture(bool enabled) {
+    capture = enabled;
+}
+
+/**
+ * Recebe uma palavra do PIO simulado
+ * @param start_us Início da palavra no fio
+ * @param word Palavra G|R|B
+ */
+void emulator_put_word(uint64_t start_us, uint32_t word) {
+    // Linha parada tempo suficiente: os LEDs travaram o frame anterior
+    if (has_pending && start_us >= wire_end_us + EMULATOR_LATCH_US) {
+        emulator_latch(wire_end_us + EMULATOR_LATCH_US);
+    }
+
+    if (!has_pending) {
+        pending.count = 0;
+        has_pending = true;
+    }
+
+    // Palavras além do último LED saem pela ponta da cadeia
+    if (pending.count < NUM_LEDS) {
+        pending.words[pending.count++] = word;
+    }
+
+    wire_end_us = start_us + EMULATOR_WORD_US;
+}
+
+/**
+ * Fecha o frame pendente
+ */
+void emulator_flush(void) {
+    emulator_latch(wire_end_us + EMULATOR_LATCH_US);
+}
+
+/**
+ * Quantidade de frames capturados
+ * @return Número de frames
+ */
+uint emulator_frame_count(void) {
+    return frame_count;
+}
+
+/**
+ * Acessa um frame capturado
+ * @param index Índice do frame
+ * @return Frame ou NULL
+ */
+const EmulatorFrame *emulator_frame(uint index) {
+    return index < frame_count ? &frames[index] : NULL;
+}
+
+/**
+ * Converte para RGB na ordem lógica
+ * @param frame Frame capturado
+ * @param rgb Saída R, G, B por pixel
+ */
+void emulator_frame_to_rgb(const EmulatorFrame *frame, uint8_t rgb[NUM_LEDS][3]) {
+    for (int i = 0; i < NUM_LEDS; i++) {
+        uint32_t word = frame->words[i];
+        uint8_t *pixel = rgb[map_index_to_position(i)];
+
+        pixel[0] = (uint8_t)(word >> 16);  // R
+        pixel[1] = (uint8_t)(word >> 24);  // G
+        pixel[2] = (uint8_t)(word >> 8);   // B
+    }
+}
+
+/**
+ * Desenha o frame com cores ANSI
+ * @param out Arquivo de saída
+ * @param frame Frame capturado
+ * @param gain Multiplicador de brilho
+ */
+void emulator_print_ansi(FILE *out, const EmulatorFrame *frame, uint gain) {
+    uint8_t rgb[NUM_LEDS][3];
+    emulator_frame_to_rgb(frame, rgb);
+
+    fprintf(out, "t=%llu us\n", (unsigned long long)frame->time_us);
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+        for (int x = 0; x < MATRIX_WIDTH; x++) {
+            const uint8_t *pixel = rgb[y * MATRIX_WIDTH + x];
+            uint channels[3];
+            for (int c = 0; c < 3; c++) {
+                channels[c] = pixel[c] * gain > 255 ? 255 : pixel[c] * gain;
+            }
+            fprintf(out, "\x1b[48;2;%u;%u;%um  ", channels[0], channels[1], channels[2]);
+        }
+        fprintf(out, "\x1b[0m\n");
+    }
+}
+
+/**
+ * Grava o frame em PPM
+ * @param path Caminho do arquivo
+ * @param frame Frame capturado
+ * @return true em caso de sucesso
+ */
+bool emulator_write_ppm(const char *path, const EmulatorFrame *frame) {
+    uint8_t rgb[NUM_LEDS][3];
+    emulator_frame_to_rgb(frame, rgb);
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    fprintf(file, "P6\n%d %d\n255\n", MATRIX_WIDTH, MATRIX_HEIGHT);
+    bool ok = fwrite(rgb, sizeof(rgb), 1, file) == 1;
+    return fclose(file) == 0 && ok;
+}
+
+/**
+ * Compara o frame com um PPM de referência
+ * @param path Caminho do arquivo
+ * @param frame Frame capturado
+ * @return true se idênticos
+ */
+bool emulator_compare_ppm(const char *path, const EmulatorFrame *frame) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+
+    int width = 0, height = 0, max = 0;
+    uint8_t golden[NUM_LEDS][3];
+    bool ok = fscanf(file, "P6 %d %d %d", &width, &height, &max) == 3 && fgetc(file) != EOF &&
+              width == MATRIX_WIDTH && height == MATRIX_HEIGHT && max == 255 &&
+              fread(golden, sizeof(golden), 1, file) == 1;
+    fclose(file);
+    if (!ok) return false;
+
+    uint8_t rgb[NUM_LEDS][3];
+    emulator_frame_to_rgb(frame, rgb);
+    return memcmp(rgb, golden, sizeof(rgb)) == 0;
+}
@@ -0,0 +1,88 @@
+#ifndef EMULATOR_H
+#define EMULATOR_H
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "matrix_config.h"
+
+#define EMULATOR_WORD_US 30              // Duração de uma palavra de 24 bits no fio (800 kHz)
+#define EMULATOR_LATCH_US 50             // Linha parada por esse tempo trava o frame (reset do WS2812)
+#define EMULATOR_FIFO_DEPTH 8            // Palavras no TX FIFO (juntado) antes de pio_sm_put_blocking bloquear
+
+typedef struct {
+    uint64_t time_us;                    // Instante virtual do latch
+    uint32_t words[NUM_LEDS];            // Estado de cada LED da cadeia (G|R|B), após o latch
+    uint count;                          // Palavras recebidas neste frame
+} EmulatorFrame;
+
+/**
+ * Descarta todos os frames capturados.
+ */
+extern void emulator_reset(void);
+
+/**
+ * Liga ou desliga a gravação dos frames (ligada por padrão). Desligada, os
+ * LEDs continuam sendo atualizados, mas nada é guardado: para execuções longas
+ * como os benchmarks.
+ * @param enabled false para não guardar os frames
+ */
+extern void emulator_set_capture(bool enabled);
+
+/**
+ * Recebe uma palavra do PIO simulado. Um intervalo de pelo menos EMULATOR_LATCH_US
+ * sem dados fecha o frame anterior; LEDs que não receberam palavra mantêm a cor.
+ * @param start_us Instante virtual em que a palavra começa a sair no fio
+ * @param word Palavra no formato G|R|B (bits 31-8)
+ */
+extern void emulator_put_word(uint64_t start_us, uint32_t word);
+
+/**
+ * Fecha o frame pendente (fim da captura).
+ */
+extern void emulator_flush(void);
+
+/**
+ * Quantidade de frames travados até agora.
+ * @return Número de frames
+ */
+extern uint emulator_frame_count(void);
+
+/**
+ * Acessa um frame capturado.
+ * @param index Índice do frame (0 = primeiro)
+ * @return Ponteiro para o frame, ou NULL fora do intervalo
+ */
+extern const EmulatorFrame *emulator_frame(uint index);
+
+/**
+ * Converte o frame para RGB na ordem lógica da imagem (desfaz o mapeamento da cadeia).
+ * @param frame Frame capturado
+ * @param rgb Saída com NUM_LEDS trios R, G, B
+ */
+extern void emulator_frame_to_rgb(const EmulatorFrame *frame, uint8_t rgb[NUM_LEDS][3]);
+
+/**
+ * Desenha o frame no terminal com cores ANSI de 24 bits.
+ * @param out Arquivo de saída
+ * @param frame Frame capturado
+ * @param gain Multiplicador de brilho para visualizar intensidades baixas (1 = original)
+ */
+extern void emulator_print_ansi(FILE *out, const EmulatorFrame *frame, uint gain);
+
+/**
+ * Grava o frame em PPM binário (P6), uma célula por LED.
+ * @param path Caminho do arquivo
+ * @param frame Frame capturado
+ * @return false se não foi possível gravar
+ */
+extern bool emulator_write_ppm(const char *path, const EmulatorFrame *frame);
+
+/**
+ * Compara o frame com um PPM de referência (golden).
+ * @param path Caminho do arquivo de referência
+ * @param frame Frame capturado
+ * @return true se o arquivo existe e os pixels são idênticos
+ */
+extern bool emulator_compare_ppm(const char *path, const EmulatorFrame *frame);
+
+#endif
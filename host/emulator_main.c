@@ -0,0 +1,427 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "led_functions.h"
+#include "emulator.h"
+#include "animation.h"
+#include "animations.h"
+#include "scroll.h"
+#include "compositor.h"
+#include "framebuffer.h"
+#include "input.h"
+#include "mode_machine.h"
+#include "effects.h"
+#include "transition.h"
+
+// === CONFIGURAÇÕES PADRÃO (as mesmas de main.c) ===
+#define INTENSITY 0.1
+#define SPEED 150
+#define DEMO_SPEED 500
+#define COLOR_LED_R 100
+#define COLOR_LED_G 156
+#define COLOR_LED_B 255
+#define INPUT_FRAME_US 16667             // Frame a 60 fps: limite da latência de despacho
+
+/**
+ * Lê um arquivo inteiro (container de animação gerado por anim_encode.py)
+ * @param path Caminho do arquivo
+ * @param size Tamanho lido
+ * @return Conteúdo alocado com malloc, ou NULL
+ */
+static uint8_t *read_file(const char *path, uint32_t *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    uint8_t *data = length > 0 ? malloc((size_t)length) : NULL;
+    if (data && fread(data, 1, (size_t)length, f) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+
+    *size = (uint32_t)length;
+    return data;
+}
+
+/**
+ * Converte o nome de uma direção de rolagem
+ * @param name left, right, up ou down
+ * @param direction Direção lida
+ * @return false se o nome for desconhecido
+ */
+static bool parse_direction(const char *name, ScrollDirection *direction) {
+    static const char *names[] = {"left", "right", "up", "down"};
+    for (int i = 0; i < 4; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            *direction = (ScrollDirection)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Fundo da demonstração de camadas: gradiente vertical que pulsa devagar
+ * @param state Contador de frames (uint32_t)
+ * @param pixels Saída 0x00RRGGBB
+ */
+static void layers_background(void *state, uint32_t *pixels) {
+    uint32_t frame = (*(uint32_t *)state)++;
+    uint32_t pulse = frame & 31;
+    if (pulse > 15) pulse = 31 - pulse;
+
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+        uint32_t blue = 64 + (uint32_t)y * 128 / MATRIX_HEIGHT + pulse * 4;
+        for (int x = 0; x < MATRIX_WIDTH; x++) {
+            pixels[y * MATRIX_WIDTH + x] = (32u << 8) | blue;
+        }
+    }
+}
+
+// === LINHAS DO TEMPO SINTÉTICAS DOS BOTÕES (comando input) ===
+typedef struct {
+    uint32_t time_us;                    // Instante da borda desde o início da linha
+    uint8_t button;                      // MODE_BUTTON_A ou MODE_BUTTON_B
+    bool pressed;                        // Nível depois da borda
+} TimelineEdge;
+
+typedef struct {
+    InputEventType type;                 // Gesto esperado
+    uint8_t button;                      // Botão esperado
+    Mode mode;                           // Modo depois do evento
+} TimelineEvent;
+
+typedef struct {
+    const char *name;                    // Descrição
+    const TimelineEdge *edges;           // Bordas em ordem de tempo
+    int edge_count;
+    const TimelineEvent *expected;       // Eventos esperados, em ordem, com o modo que cada um deixa
+    int expected_count;
+    Mode start;                          // Modo antes da primeira borda
+} Timeline;
+
+#define A MODE_BUTTON_A
+#define B MODE_BUTTON_B
+static const TimelineEdge bounce_click[] = {{0, A, true},      {1500, A, false},   {3000, A, true},
+                                            {4200, A, false},  {5000, A, true},    {120000, A, false},
+                                            {121000, A, true}, {123000, A, false}};
+static const TimelineEvent bounce_click_events[] = {{INPUT_PRESS, A, MODE_IDLE}, {INPUT_CLICK, A, MODE_DEMO}};
+static const TimelineEdge double_click[] = {{0, B, true}, {90000, B, false}, {200000, B, true}, {290000, B, false}};
+static const TimelineEvent double_click_events[] = {
+    {INPUT_PRESS, B, MODE_IDLE}, {INPUT_PRESS, B, MODE_IDLE}, {INPUT_DOUBLE_CLICK, B, MODE_ANIMATION}};
+static const TimelineEdge effect_click[] = {{0, A, true}, {80000, A, false}, {180000, A, true}, {260000, A, false}};
+static const TimelineEvent effect_click_events[] = {
+    {INPUT_PRESS, A, MODE_MESSAGE}, {INPUT_PRESS, A, MODE_MESSAGE}, {INPUT_DOUBLE_CLICK, A, MODE_EFFECT}};
+static const TimelineEdge long_press[] = {{0, A, true}, {1000000, A, false}};
+static const TimelineEvent long_press_events[] = {{INPUT_PRESS, A, MODE_MESSAGE}, {INPUT_LONG_PRESS, A, MODE_IDLE}};
+static const TimelineEdge bounce_release[] = {{0, B, true}, {4000, B, false}, {9000, B, true}, {15000, B, false}};
+static const TimelineEvent bounce_release_events[] = {{INPUT_PRESS, B, MODE_IDLE}, {INPUT_CLICK, B, MODE_MESSAGE}};
+static const TimelineEdge two_buttons[] = {{0, A, true}, {50000, B, true}, {100000, A, false}, {150000, B, false}};
+static const TimelineEvent two_buttons_events[] = {{INPUT_PRESS, A, MODE_IDLE}, {INPUT_PRESS, B, MODE_IDLE},
+                                                   {INPUT_CLICK, A, MODE_DEMO}, {INPUT_CLICK, B, MODE_MESSAGE}};
+#undef A
+#undef B
+
+#define TIMELINE(name, edges, events, start) {name, edges, count_of(edges), events, count_of(events), start}
+static const Timeline timelines[] = {
+    TIMELINE("clique com ruído", bounce_click, bounce_click_events, MODE_IDLE),
+    TIMELINE("duplo clique", double_click, double_click_events, MODE_IDLE),
+    TIMELINE("duplo clique no A", effect_click, effect_click_events, MODE_MESSAGE),
+    TIMELINE("toque longo", long_press, long_press_events, MODE_MESSAGE),
+    TIMELINE("ruído até o fim do bloqueio", bounce_release, bounce_release_events, MODE_IDLE),
+    TIMELINE("dois botões", two_buttons, two_buttons_events, MODE_IDLE),
+};
+
+/**
+ * Passa as linhas do tempo pela fila de bordas, pelo reconhecimento de gestos e
+ * pela máquina de modos, com o laço principal acordando só a cada frame (pior
+ * caso: sem acordar pela borda nem pelo alarme do gesto). Confere os eventos,
+ * o modo depois de cada um e a latência entre o gesto e a troca de modo.
+ * @return Quantidade de falhas
+ */
+static int input_check(void) {
+    static const char *const names[INPUT_EVENT_TYPES] = {"TOQUE", "CLIQUE", "DUPLO CLIQUE", "TOQUE LONGO"};
+    static const uint pins[] = {5, 6};
+    int failures = 0;
+
+    for (uint t = 0; t < count_of(timelines); t++) {
+        const Timeline *line = &timelines[t];
+        uint32_t base = time_us_32();
+        uint32_t end = line->edges[line->edge_count - 1].time_us + INPUT_LONG_PRESS_US + INPUT_DOUBLE_CLICK_US;
+        uint32_t max_latency = 0;
+        Mode mode = line->start;
+        int next_edge = 0, seen = 0;
+
+        input_init(pins, count_of(pins));
+        printf("%s\n", line->name);
+
+        for (uint32_t now = 0; now <= end; now += INPUT_FRAME_US) {
+            // Bordas que a interrupção carimbou desde o último frame
+            while (next_edge < line->edge_count && line->edges[next_edge].time_us <= now) {
+                const TimelineEdge *edge = &line->edges[next_edge++];
+                input_push_edge(edge->button, edge->pressed, base + edge->time_us);
+            }
+
+            InputEvent event;
+            while (input_poll(base + now, &event)) {
+                uint32_t latency = base + now - event.time_us;
+                mode_dispatch(mode, &event, &mode);
+                bool match = seen < line->expected_count && line->expected[seen].type == event.type &&
+                             line->expected[seen].button == event.button && line->expected[seen].mode == mode;
+                if (latency > max_latency) max_latency = latency;
+
+                printf("  %8.1f ms  %-13s botão %c  latência %5.1f ms  modo %s%s\n",
+                       (event.time_us - base) / 1000.0, names[event.type], 'A' + event.button, latency / 1000.0,
+                       mode_name(mode), match ? "" : "  (inesperado)");
+                if (!match && seen < line->expected_count) {
+                    const TimelineEvent *expected = &line->expected[seen];
+                    printf("  %8s    esperado %-13s botão %c  modo %s\n", "", names[expected->type],
+                           'A' + expected->button, mode_name(expected->mode));
+                }
+                if (!match) failures++;
+                seen++;
+            }
+        }
+
+        if (seen < line->expected_count) {
+            printf("  faltaram %d eventos\n", line->expected_count - seen);
+            failures++;
+        }
+        if (max_latency > INPUT_FRAME_US) {
+            printf("  latência %.1f ms acima de um frame\n", max_latency / 1000.0);
+            failures++;
+        }
+        sleep_us(end);
+    }
+
+    printf("linhas do tempo: %u  falhas: %d  bordas perdidas: %lu\n", (uint)count_of(timelines), failures,
+           (unsigned long)input_dropped());
+    return failures;
+}
+
+/**
+ * Mostra o uso da ferramenta
+ */
+static void usage(const char *program) {
+    fprintf(stderr,
+            "uso: %s [opções] message \"TEXTO\" | demo | anim [ARQUIVO.bin]\n"
+            "       %s [opções] scroll \"TEXTO\" [left|right|up|down] [ESPAÇAMENTO] [LINHAS_POR_PASSO]\n"
+            "       %s [opções] layers \"TEXTO\"\n"
+            "       %s [opções] effect rainbow|plasma|fire|twinkle|breathing|wipe [FRAMES]\n"
+            "       %s [opções] transition cut|crossfade|wipe-right|wipe-left|wipe-down|wipe-up|dissolve [FRAMES]\n"
+            "       %s input   (linhas do tempo dos botões; código 1 se um evento ou latência falhar)\n"
+            "  --ansi          desenha cada frame no terminal\n"
+            "  --gain N        multiplica o brilho no terminal (padrão 8)\n"
+            "  --ppm DIR       grava cada frame em DIR/frame_NNNN.ppm\n"
+            "  --check DIR     compara cada frame com DIR/frame_NNNN.ppm (código 1 se algum difere ou falta)\n"
+            "  --smooth        rolagem com sub-passo (mistura as linhas nas posições fracionárias)\n",
+            program, program, program, program, program, program);
+}
+
+int main(int argc, char **argv) {
+    bool ansi = false;
+    uint gain = 8;
+    const char *ppm_dir = NULL;
+    const char *check_dir = NULL;
+    bool smooth = false;
+    int arg = 1;
+
+    // Opções
+    for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; arg++) {
+        if (strcmp(argv[arg], "--ansi") == 0) {
+            ansi = true;
+        } else if (strcmp(argv[arg], "--gain") == 0 && arg + 1 < argc) {
+            gain = (uint)atoi(argv[++arg]);
+        } else if (strcmp(argv[arg], "--ppm") == 0 && arg + 1 < argc) {
+            ppm_dir = argv[++arg];
+        } else if (strcmp(argv[arg], "--check") == 0 && arg + 1 < argc) {
+            check_dir = argv[++arg];
+        } else if (strcmp(argv[arg], "--smooth") == 0) {
+            smooth = true;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (arg >= argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Entrada dos botões: não gera frames
+    if (strcmp(argv[arg], "input") == 0) {
+        return input_check() ? 1 : 0;
+    }
+
+    matrix_geometry_init(NULL);
+    emulator_reset();
+
+    // Executa a animação escolhida com o PIO simulado (tempo virtual)
+    clock_t started = clock();
+    if (strcmp(argv[arg], "message") == 0 && arg + 1 < argc) {
+        RGBColor color = {COLOR_LED_R, COLOR_LED_G, COLOR_LED_B};
+        show_message(argv[arg + 1], color, pio0, 0, INTENSITY, SPEED);
+    } else if (strcmp(argv[arg], "scroll") == 0 && arg + 1 < argc) {
+        RGBColor color = {COLOR_LED_R, COLOR_LED_G, COLOR_LED_B};
+        ScrollDirection direction = SCROLL_LEFT;
+        if (arg + 2 < argc && !parse_direction(argv[arg + 2], &direction)) {
+            usage(argv[0]);
+            return 2;
+        }
+        int spacing = arg + 3 < argc ? atoi(argv[arg + 3]) : TEXT_SPACING;
+        double lines_per_step = arg + 4 < argc ? atof(argv[arg + 4]) : 1.0;
+        if (lines_per_step <= 0.0) lines_per_step = 1.0;
+
+        // O período acompanha a velocidade: a mensagem anda SPEED ms por linha
+        static ScrollAnimation scroll;
+        scroll_animation_init(&scroll, argv[arg + 1], direction, spacing, color, pio0, 0, INTENSITY);
+        scroll_animation_set_speed(&scroll, (uint16_t)(lines_per_step * SCROLL_SPEED_ONE + 0.5), smooth);
+        uint period_ms = (uint)(SPEED * lines_per_step + 0.5);
+        while (scroll_animation_step(&scroll)) {
+            sleep_ms(period_ms ? period_ms : 1);
+        }
+    } else if (strcmp(argv[arg], "layers") == 0 && arg + 1 < argc) {
+        // Compositor: fundo em gradiente, texto rolando à esquerda e um indicador fixo no canto
+        static ScrollAnimation text;
+        scroll_animation_init(&text, argv[arg + 1], SCROLL_LEFT, TEXT_SPACING, (RGBColor){255, 255, 255}, pio0, 0,
+                              INTENSITY);
+        scroll_animation_set_speed(&text, SCROLL_SPEED_ONE / 2, smooth);
+
+        static const RGBColor8 status_pixels[1] = {{255, 0, 0}};
+        static const Sprite status = {1, 1, status_pixels, NULL};
+        uint32_t frame = 0;
+
+        Compositor compositor;
+        compositor_init(&compositor);
+        compositor_add_effect(&compositor, layers_background, &frame)->opacity = 160;
+        Layer *text_layer = compositor_add_text(&compositor, &text, (RGBColor8){255, 200, 0});
+        compositor_add_sprite(&compositor, &status, MATRIX_WIDTH - 1, 0);
+
+        // O texto não passa por cima do indicador
+        layer_set_clip(text_layer, 0, 1, 0, 0);
+
+        do {
+            compositor_render(&compositor, framebuffer_back());
+            framebuffer_mark_dirty();
+            framebuffer_commit(pio0, 0, intensity_to_fixed(INTENSITY));
+            sleep_ms(SPEED / 2);
+        } while (scroll_animation_advance(&text));
+    } else if (strcmp(argv[arg], "effect") == 0 && arg + 1 < argc) {
+        // Efeito procedural no ritmo de EFFECT_FPS (padrão: 2 segundos)
+        EffectType type;
+        if (!effect_find(argv[arg + 1], &type)) {
+            usage(argv[0]);
+            return 2;
+        }
+        uint32_t frames = arg + 2 < argc ? (uint32_t)atoi(argv[arg + 2]) : 2 * EFFECT_FPS;
+
+        static Effect effect;
+        effect_init(&effect, type, (RGBColor8){COLOR_LED_R, COLOR_LED_G, COLOR_LED_B}, frames ? frames : 1, pio0, 0,
+                    intensity_to_fixed(INTENSITY));
+        while (effect_step(&effect)) {
+            sleep_us(EFFECT_PERIOD_US);
+        }
+    } else if (strcmp(argv[arg], "transition") == 0 && arg + 1 < argc) {
+        // Do arco-íris para uma mensagem lenta: entre os passos da rolagem o laço
+        // reenvia a mistura como main.c, com transition_poll() (padrão: 30 frames)
+        TransitionType type;
+        if (!transition_find(argv[arg + 1], &type)) {
+            usage(argv[0]);
+            return 2;
+        }
+        uint frames = arg + 2 < argc ? (uint)atoi(argv[arg + 2]) : 30;
+
+        static Effect effect;
+        effect_init(&effect, EFFECT_RAINBOW, (RGBColor8){COLOR_LED_R, COLOR_LED_G, COLOR_LED_B}, 1, pio0, 0,
+                    intensity_to_fixed(INTENSITY));
+        effect_step(&effect);
+        sleep_ms(SPEED);
+
+        static ScrollAnimation scroll;
+        scroll_animation_init(&scroll, "OI", SCROLL_LEFT, TEXT_SPACING,
+                              (RGBColor){COLOR_LED_R, COLOR_LED_G, COLOR_LED_B}, pio0, 0, INTENSITY);
+        transition_start(type, frames);
+
+        bool more = true;
+        uint64_t next_step_us = time_us_64();
+        while (more) {
+            more = scroll_animation_step(&scroll);
+            next_step_us += SPEED * 1000;
+            while (time_us_64() < next_step_us) {
+                transition_poll(pio0, 0);
+                uint64_t remaining = next_step_us - time_us_64();
+                sleep_us(remaining < TRANSITION_PERIOD_US ? remaining : TRANSITION_PERIOD_US);
+            }
+        }
+    } else if (strcmp(argv[arg], "demo") == 0) {
+        show_demo1(pio0, 0, DEMO_SPEED);
+    } else if (strcmp(argv[arg], "anim") == 0) {
+        // Animação embutida ou um container gravado por anim_encode.py
+        const uint8_t *data = anim_pulse;
+        uint32_t size = anim_pulse_size;
+        if (arg + 1 < argc && !(data = read_file(argv[arg + 1], &size))) {
+            fprintf(stderr, "erro ao ler %s\n", argv[arg + 1]);
+            return 1;
+        }
+
+        AnimationPlayer player;
+        if (!animation_open(&player, data, size, pio0, 0, intensity_to_fixed(INTENSITY), 1)) {
+            fprintf(stderr, "animação inválida para uma matriz %dx%d\n", MATRIX_WIDTH, MATRIX_HEIGHT);
+            return 1;
+        }
+        animation_play(&player);
+    } else {
+        usage(argv[0]);
+        return 2;
+    }
+    emulator_flush();
+    double real_ms = (double)(clock() - started) * 1000.0 / CLOCKS_PER_SEC;
+
+    // Saídas por frame
+    uint mismatches = 0;
+    for (uint i = 0; i < emulator_frame_count(); i++) {
+        const EmulatorFrame *frame = emulator_frame(i);
+        char path[512];
+
+        if (ansi) {
+            emulator_print_ansi(stdout, frame, gain);
+        }
+        if (ppm_dir) {
+            snprintf(path, sizeof(path), "%s/frame_%04u.ppm", ppm_dir, i);
+            if (!emulator_write_ppm(path, frame)) {
+                fprintf(stderr, "erro ao gravar %s\n", path);
+                return 1;
+            }
+        }
+        if (check_dir) {
+            snprintf(path, sizeof(path), "%s/frame_%04u.ppm", check_dir, i);
+            if (!emulator_compare_ppm(path, frame)) {
+                fprintf(stderr, "frame %u difere de %s\n", i, path);
+                mismatches++;
+            }
+        }
+    }
+
+    // Referência com mais frames que a execução: a animação terminou antes da hora
+    if (check_dir) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/frame_%04u.ppm", check_dir, emulator_frame_count());
+        FILE *extra = fopen(path, "rb");
+        if (extra) {
+            fclose(extra);
+            fprintf(stderr, "faltam frames: %s não foi gerado\n", path);
+            mismatches++;
+        }
+    }
+
+    const EmulatorFrame *last = emulator_frame(emulator_frame_count() - 1);
+    printf("frames: %u  tempo virtual: %.1f ms  tempo real: %.1f ms\n", emulator_frame_count(),
+           last ? last->time_us / 1000.0 : 0.0, real_ms);
+
+    return mismatches ? 1 : 0;
+}
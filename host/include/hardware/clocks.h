@@ -0,0 +1,9 @@
+#ifndef HOST_HARDWARE_CLOCKS_H
+#define HOST_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+enum { clk_sys = 5 };
+static inline uint32_t clock_get_hz(int clock) { (void)clock; return 128000000; }
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+
+// DMA simulado (host/mock_pico.c): um canal ligado a um TX FIFO despeja o buffer no
+// fio do state machine no ritmo das palavras, sem ocupar a CPU, e levanta DMA_IRQ_0
+// no instante virtual em que escreveria a última palavra no FIFO
+#define NUM_DMA_CHANNELS 12
+
+typedef struct { uint32_t ctrl; } dma_channel_config;
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+#define DMA_CONFIG_SIZE_MASK 0x3u
+#define DMA_CONFIG_READ_INCR 0x4u
+#define DMA_CONFIG_WRITE_INCR 0x8u
+
+static inline dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    return (dma_channel_config){DMA_SIZE_32 | DMA_CONFIG_READ_INCR};
+}
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->ctrl = (c->ctrl & ~DMA_CONFIG_SIZE_MASK) | (uint32_t)size;
+}
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? c->ctrl | DMA_CONFIG_READ_INCR : c->ctrl & ~DMA_CONFIG_READ_INCR;
+}
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? c->ctrl | DMA_CONFIG_WRITE_INCR : c->ctrl & ~DMA_CONFIG_WRITE_INCR;
+}
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void)c; (void)dreq; }
+
+extern int dma_claim_unused_channel(bool required);
+extern void dma_channel_unclaim(uint channel);
+extern void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                                  const volatile void *read_addr, uint count, bool trigger);
+extern void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t count);
+extern void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+extern void dma_channel_set_trans_count(uint channel, uint32_t count, bool trigger);
+extern void dma_start_channel_mask(uint32_t mask);
+extern bool dma_channel_is_busy(uint channel);
+extern void dma_channel_wait_for_finish_blocking(uint channel);
+extern void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+extern bool dma_channel_get_irq0_status(uint channel);
+extern void dma_channel_acknowledge_irq0(uint channel);
+
+#endif
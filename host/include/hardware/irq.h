@@ -0,0 +1,14 @@
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+// Interrupções simuladas: os tratadores rodam quando o relógio virtual passa pelo evento (host/mock_pico.c)
+typedef void (*irq_handler_t)(void);
+enum { DMA_IRQ_0 = 11, DMA_IRQ_1 = 12 };
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+extern void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t priority);
+extern void irq_remove_handler(uint num, irq_handler_t handler);
+extern void irq_set_enabled(uint num, bool enabled);
+
+#endif
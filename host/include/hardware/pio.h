@@ -0,0 +1,31 @@
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+// PIO simulado: cada palavra escrita no TX FIFO vai para o emulador (host/emulator.h)
+struct pio_hw {
+    volatile uint32_t txf[4];
+};
+
+typedef struct { uint32_t clkdiv; } pio_sm_config;
+typedef struct { const uint16_t *instructions; uint8_t length; int8_t origin; } pio_program_t;
+
+extern void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+extern bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm);
+extern int pio_claim_unused_sm(PIO pio, bool required);
+extern void pio_sm_unclaim(PIO pio, uint sm);
+static inline uint pio_get_index(PIO pio) { return pio == pio1 ? 1 : 0; }
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { return pio_get_index(pio) * 8 + (is_tx ? 0 : 4) + sm; }
+// Os programas não ocupam memória de instruções: só a quantidade carregada é contada
+extern uint pio_add_program(PIO pio, const pio_program_t *program);
+static inline bool pio_can_add_program(PIO pio, const pio_program_t *program) { (void)pio; (void)program; return true; }
+extern void pio_remove_program(PIO pio, const pio_program_t *program, uint offset);
+static inline void pio_clkdiv_restart_sm_mask(PIO pio, uint32_t mask) { (void)pio; (void)mask; }
+
+// Um state machine parado não tira palavras do FIFO: o DMA disparado para ele só
+// começa a sair no fio quando o state machine é habilitado
+extern void pio_set_sm_mask_enabled(PIO pio, uint32_t mask, bool enabled);
+extern void pio_enable_sm_mask_in_sync(PIO pio, uint32_t mask);
+
+#endif
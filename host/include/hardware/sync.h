@@ -0,0 +1,14 @@
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include <sched.h>
+
+// Barreira completa do compilador e da CPU, como o DMB do Cortex-M0+
+static inline void __dmb(void) { __sync_synchronize(); }
+
+// Sem registrador de eventos no host: __wfe() só cede a CPU, para que a outra thread
+// (o "núcleo" do outro lado da fila nos testes) avance mesmo com um único processador
+static inline void __sev(void) {}
+static inline void __wfe(void) { sched_yield(); }
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef HOST_MAIN_PIO_H
+#define HOST_MAIN_PIO_H
+
+// Substituto do cabeçalho gerado pelo pioasm a partir de main.pio.
+// No host os programas não são executados: o PIO simulado recebe as palavras já prontas.
+
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+
+static const pio_program_t main_program = {0};
+static const pio_program_t ws2812_program = {0};
+static const pio_program_t ws2812_v5_program = {0};
+static const pio_program_t parallel8_program = {0};
+
+static inline void main_program_prepare(PIO pio, uint sm, uint offset, uint pin) {
+    (void)pio; (void)sm; (void)offset; (void)pin;
+}
+
+static inline void main_program_init(PIO pio, uint sm, uint offset, uint pin) {
+    main_program_prepare(pio, sm, offset, pin);
+}
+
+static inline void ws2812_program_prepare(PIO pio, uint sm, uint offset, uint pin) {
+    (void)pio; (void)sm; (void)offset; (void)pin;
+}
+
+static inline void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin) {
+    ws2812_program_prepare(pio, sm, offset, pin);
+}
+
+static inline void ws2812_v5_program_prepare(PIO pio, uint sm, uint offset, uint pin) {
+    (void)pio; (void)sm; (void)offset; (void)pin;
+}
+
+static inline void ws2812_v5_program_init(PIO pio, uint sm, uint offset, uint pin) {
+    ws2812_v5_program_prepare(pio, sm, offset, pin);
+}
+
+static inline void parallel8_program_init(PIO pio, uint sm, uint offset, uint base_pin, uint pin_count) {
+    (void)pio; (void)sm; (void)offset; (void)base_pin; (void)pin_count;
+}
+
+#endif
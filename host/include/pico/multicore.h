@@ -0,0 +1,9 @@
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+// O emulador é de núcleo único: o núcleo 1 nunca é lançado
+static inline void multicore_launch_core1(void (*entry)(void)) { (void)entry; }
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// === SUBSTITUTO DO PICO SDK PARA O EMULADOR NO HOST ===
+// Apenas o necessário para compilar a biblioteca no Linux. O tempo é virtual:
+// sleep_ms()/sleep_us() avançam um relógio simulado, sem esperar de verdade.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PICO_ON_DEVICE 0  // Igual ao build "host" do SDK
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+
+extern PIO pio0;
+extern PIO pio1;
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+
+// Relógio virtual
+extern uint64_t time_us_64(void);
+extern uint32_t time_us_32(void);
+extern void sleep_us(uint64_t us);
+extern void sleep_ms(uint32_t ms);
+extern void busy_wait_us(uint64_t us);
+extern absolute_time_t get_absolute_time(void);
+extern absolute_time_t from_us_since_boot(uint64_t us);
+extern uint64_t to_us_since_boot(absolute_time_t t);
+extern int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+extern void tight_loop_contents(void);  // Avança o relógio virtual (laços de espera terminam)
+
+// GPIO e stdio (sem efeito no host)
+#define GPIO_IN 0
+#define GPIO_OUT 1
+#define GPIO_IRQ_EDGE_FALL 0x4u
+#define GPIO_IRQ_EDGE_RISE 0x8u
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+static inline void gpio_init(uint gpio) { (void)gpio; }
+static inline void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+static inline bool gpio_get(uint gpio) { (void)gpio; return true; }
+static inline void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled,
+                                                      gpio_irq_callback_t callback) {
+    (void)gpio; (void)events; (void)enabled; (void)callback;
+}
+static inline bool stdio_init_all(void) { return true; }
+
+// stdio da USB: sem porta ligada (mock_stdio_attach() em mock_hw.h) nada chega e
+// putchar_raw() escreve na saída padrão
+#define PICO_ERROR_TIMEOUT (-1)
+extern int getchar_timeout_us(uint32_t timeout_us);
+extern int putchar_raw(int c);
+extern void stdio_flush(void);
+static inline bool set_sys_clock_khz(uint32_t khz, bool required) { (void)khz; (void)required; return true; }
+
+// Alarmes (o emulador roda as animações no modo bloqueante)
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+static inline alarm_id_t add_alarm_at(absolute_time_t t, alarm_callback_t cb, void *user_data, bool fire_if_past) {
+    (void)t; (void)cb; (void)user_data; (void)fire_if_past;
+    return 0;
+}
+static inline bool cancel_alarm(alarm_id_t id) { (void)id; return false; }
+
+#include "hardware/sync.h"
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef MOCK_HW_H
+#define MOCK_HW_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+
+/**
+ * Inspeção do PIO e do DMA simulados (host/mock_pico.c), para os testes do host.
+ * O relógio é virtual: o DMA não ocupa a CPU, e as conclusões e interrupções
+ * acontecem quando sleep_us(), tight_loop_contents() ou um put bloqueante
+ * avançam o relógio até o instante delas.
+ */
+
+#define MOCK_DMA_LOG_SIZE 64             // Disparos de DMA guardados (os mais antigos são descartados)
+
+typedef struct {
+    uint channel;                        // Canal disparado
+    const void *read_addr;               // Endereço de leitura no disparo
+    uint32_t count;                      // Palavras transferidas
+    PIO pio;                             // TX FIFO de destino (NULL se não for um FIFO de PIO)
+    uint sm;                             // State machine de destino
+    uint64_t start_us;                   // Instante do disparo
+    uint64_t first_word_us;              // Início da primeira palavra no fio (com o state machine habilitado)
+    uint64_t wire_end_us;                // Fim da última palavra no fio
+    uint64_t done_us;                    // Última palavra escrita no FIFO (conclusão e interrupção)
+} MockDmaStart;
+
+typedef struct {
+    PIO pio;                             // Bloco
+    uint32_t mask;                       // State machines habilitados juntos
+    uint64_t time_us;                    // Instante da habilitação
+} MockSmStart;
+
+/**
+ * Libera state machines e canais DMA, habilita todos os state machines e descarta
+ * transferências, tratadores de interrupção e registros. O relógio virtual
+ * continua de onde estava.
+ */
+extern void mock_hw_reset(void);
+
+/**
+ * Disparos de DMA registrados desde o último mock_hw_reset().
+ * @return Quantidade (pode passar de MOCK_DMA_LOG_SIZE)
+ */
+extern uint mock_dma_start_count(void);
+
+/**
+ * Acessa um disparo registrado.
+ * @param index Índice (0 = primeiro desde o reset)
+ * @return Registro, ou NULL se foi descartado ou não existe
+ */
+extern const MockDmaStart *mock_dma_start(uint index);
+
+/**
+ * Chamadas de dma_start_channel_mask() desde o último mock_hw_reset().
+ * @return Quantidade
+ */
+extern uint mock_dma_mask_start_count(void);
+
+/**
+ * Máscara de uma chamada de dma_start_channel_mask().
+ * @param index Índice (0 = primeira desde o reset)
+ * @return Máscara de canais, ou 0 se foi descartada ou não existe
+ */
+extern uint32_t mock_dma_mask_start(uint index);
+
+/**
+ * Chamadas de pio_enable_sm_mask_in_sync() desde o último mock_hw_reset().
+ * @return Quantidade
+ */
+extern uint mock_pio_sync_start_count(void);
+
+/**
+ * Acessa uma chamada de pio_enable_sm_mask_in_sync().
+ * @param index Índice (0 = primeira desde o reset)
+ * @return Registro, ou NULL se foi descartado ou não existe
+ */
+extern const MockSmStart *mock_pio_sync_start(uint index);
+
+/**
+ * Canais DMA reivindicados.
+ * @return Máscara com um bit por canal
+ */
+extern uint32_t mock_dma_claimed_mask(void);
+
+/**
+ * State machines reivindicados em um bloco.
+ * @param pio Bloco PIO
+ * @return Máscara com um bit por state machine
+ */
+extern uint32_t mock_pio_claimed_mask(PIO pio);
+
+/**
+ * Tratadores registrados em uma interrupção (irq_add_shared_handler() menos irq_remove_handler()).
+ * @param num Número da interrupção
+ * @return Quantidade de tratadores
+ */
+extern uint mock_irq_handler_count(uint num);
+
+/**
+ * Programas carregados em um bloco (pio_add_program() menos pio_remove_program()).
+ * @param pio Bloco PIO
+ * @return Quantidade de programas
+ */
+extern uint mock_pio_program_count(PIO pio);
+
+/**
+ * Liga o stdio da USB (getchar_timeout_us, putchar_raw, stdio_flush) a um descritor
+ * aberto com O_NONBLOCK, como o lado mestre de um pseudo-terminal.
+ * @param fd Descritor (-1 desliga: nada chega e a saída vai para stdout)
+ */
+extern void mock_stdio_attach(int fd);
+
+#endif
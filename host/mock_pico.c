@@ -0,0 +1,528 @@
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "emulator.h"
+#include "mock_hw.h"
+
+#define MOCK_PIO_SMS 4                   // State machines por bloco
+#define MOCK_IRQS 32                     // Números de interrupção
+#define MOCK_IRQ_HANDLERS 4              // Tratadores compartilhados por interrupção
+
+typedef struct {
+    bool claimed;
+    uint32_t ctrl;                       // dma_channel_config
+    PIO pio;                             // TX FIFO de destino (NULL: outro endereço, não simulado)
+    uint sm;
+    const volatile void *read_addr;
+    uint32_t trans_count;
+    bool busy;                           // Transferência em andamento
+    bool stalled;                        // Esperando o state machine de destino ser habilitado
+    uint log_index;                      // Registro do disparo em andamento
+    uint64_t done_us;                    // Instante da última escrita no FIFO
+    bool irq0_enabled;
+    bool irq0_status;                    // Interrupção pendente (até o acknowledge)
+} MockDmaChannel;
+
+// === PIO E RELÓGIO SIMULADOS ===
+static pio_hw_t pio_blocks[2];
+PIO pio0 = &pio_blocks[0];
+PIO pio1 = &pio_blocks[1];
+
+static uint64_t now_us = 0;                          // Relógio virtual
+static uint64_t wire_busy_us[2][MOCK_PIO_SMS];       // Fim da última palavra enfileirada em cada state machine
+static uint32_t sm_claimed[2];                       // State machines reivindicados por bloco
+static uint32_t sm_disabled[2];                      // State machines parados (os demais contam como habilitados)
+static uint programs_loaded[2];                      // Programas carregados por bloco
+static MockSmStart sync_log[MOCK_DMA_LOG_SIZE];
+static uint sync_log_count = 0;
+
+// === DMA E INTERRUPÇÕES SIMULADOS ===
+static MockDmaChannel dma_channels[NUM_DMA_CHANNELS];
+static irq_handler_t irq_handlers[MOCK_IRQS][MOCK_IRQ_HANDLERS];
+static uint32_t irq_enabled = 0;                     // Uma máscara de bits por número de interrupção
+static bool in_irq = false;                          // Tratadores em execução (sem reentrada)
+static MockDmaStart dma_log[MOCK_DMA_LOG_SIZE];
+static uint dma_log_count = 0;
+static uint32_t mask_log[MOCK_DMA_LOG_SIZE];
+static uint mask_log_count = 0;
+
+static void mock_dma_drain(uint c);
+
+/**
+ * Chama os tratadores de DMA_IRQ_0 se algum canal tem interrupção pendente
+ */
+static void mock_irq_dispatch(void) {
+    if (in_irq || !(irq_enabled & (1u << DMA_IRQ_0))) return;
+
+    bool pending = false;
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) pending |= dma_channels[c].irq0_status;
+    if (!pending) return;
+
+    in_irq = true;
+    for (uint h = 0; h < MOCK_IRQ_HANDLERS; h++) {
+        if (irq_handlers[DMA_IRQ_0][h]) irq_handlers[DMA_IRQ_0][h]();
+    }
+    in_irq = false;
+}
+
+/**
+ * Conclui as transferências que terminaram até o instante atual
+ */
+static void mock_dma_complete_due(void) {
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+        MockDmaChannel *channel = &dma_channels[c];
+        if (!channel->busy || channel->stalled || channel->done_us > now_us) continue;
+
+        channel->busy = false;
+        if (channel->irq0_enabled) channel->irq0_status = true;
+    }
+    mock_irq_dispatch();
+}
+
+/**
+ * Avança o relógio, parando em cada conclusão de DMA no caminho para que as
+ * interrupções vejam o instante certo
+ * @param target_us Novo instante
+ */
+static void mock_advance_to(uint64_t target_us) {
+    while (1) {
+        uint64_t next_us = UINT64_MAX;
+        for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+            const MockDmaChannel *channel = &dma_channels[c];
+            if (channel->busy && !channel->stalled && channel->done_us < next_us) next_us = channel->done_us;
+        }
+        if (next_us > target_us) break;
+
+        if (next_us > now_us) now_us = next_us;
+        mock_dma_complete_due();
+    }
+    if (target_us > now_us) now_us = target_us;
+}
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)now_us;
+}
+
+void sleep_us(uint64_t us) {
+    mock_advance_to(now_us + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    mock_advance_to(now_us + (uint64_t)ms * 1000);
+}
+
+void tight_loop_contents(void) {
+    mock_advance_to(now_us + 1);
+}
+
+void busy_wait_us(uint64_t us) {
+    mock_advance_to(now_us + us);
+}
+
+absolute_time_t get_absolute_time(void) {
+    return now_us;
+}
+
+absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+    return (int64_t)(to - from);
+}
+
+/**
+ * Coloca uma palavra no fio do state machine: ela começa assim que a anterior termina
+ * @param pio Bloco PIO
+ * @param sm State machine
+ * @param data Palavra G|R|B
+ * @return Instante em que a palavra termina no fio
+ */
+static uint64_t mock_wire_put(PIO pio, uint sm, uint32_t data) {
+    uint64_t *busy_us = &wire_busy_us[pio_get_index(pio)][sm % MOCK_PIO_SMS];
+    uint64_t start = *busy_us > now_us ? *busy_us : now_us;
+    *busy_us = start + EMULATOR_WORD_US;
+
+    emulator_put_word(start, data);
+    return *busy_us;
+}
+
+/**
+ * Escreve no TX FIFO simulado: a palavra sai no fio assim que o anterior termina,
+ * e a chamada só "bloqueia" (avança o relógio) quando o FIFO está cheio
+ */
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    uint64_t end_us = mock_wire_put(pio, sm, data);
+
+    // FIFO cheio: espera (virtualmente) até caber a palavra
+    uint64_t fifo_us = (uint64_t)EMULATOR_FIFO_DEPTH * EMULATOR_WORD_US;
+    if (end_us > now_us + fifo_us) {
+        mock_advance_to(end_us - fifo_us);
+    }
+}
+
+/**
+ * FIFO vazio: a última palavra já passou para o registrador de saída (pode ainda estar no fio)
+ * e nenhum DMA parado à espera do state machine encheu o FIFO
+ */
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm) {
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+        const MockDmaChannel *channel = &dma_channels[c];
+        if (channel->stalled && channel->pio == pio && channel->sm == sm) return false;
+    }
+    return wire_busy_us[pio_get_index(pio)][sm % MOCK_PIO_SMS] <= now_us + EMULATOR_WORD_US;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    (void)required;
+    uint32_t *claimed = &sm_claimed[pio_get_index(pio)];
+    for (uint sm = 0; sm < MOCK_PIO_SMS; sm++) {
+        if (!(*claimed & (1u << sm))) {
+            *claimed |= 1u << sm;
+            return (int)sm;
+        }
+    }
+    return -1;
+}
+
+void pio_sm_unclaim(PIO pio, uint sm) {
+    sm_claimed[pio_get_index(pio)] &= ~(1u << sm);
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    (void)program;
+    programs_loaded[pio_get_index(pio)]++;
+    return 0;
+}
+
+void pio_remove_program(PIO pio, const pio_program_t *program, uint offset) {
+    (void)program; (void)offset;
+    programs_loaded[pio_get_index(pio)]--;
+}
+
+void pio_set_sm_mask_enabled(PIO pio, uint32_t mask, bool enabled) {
+    uint32_t *disabled = &sm_disabled[pio_get_index(pio)];
+    *disabled = enabled ? *disabled & ~mask : *disabled | mask;
+
+    // DMAs parados à espera destes state machines começam a sair no fio
+    if (!enabled) return;
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+        MockDmaChannel *channel = &dma_channels[c];
+        if (channel->stalled && channel->pio == pio && (mask & (1u << channel->sm))) mock_dma_drain(c);
+    }
+    mock_dma_complete_due();
+}
+
+void pio_enable_sm_mask_in_sync(PIO pio, uint32_t mask) {
+    sync_log[sync_log_count++ % MOCK_DMA_LOG_SIZE] = (MockSmStart){pio, mask, now_us};
+    pio_set_sm_mask_enabled(pio, mask, true);
+}
+
+// === DMA ===
+
+int dma_claim_unused_channel(bool required) {
+    (void)required;
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+        if (!dma_channels[c].claimed) {
+            memset(&dma_channels[c], 0, sizeof(dma_channels[c]));
+            dma_channels[c].claimed = true;
+            return (int)c;
+        }
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    dma_channels[channel].claimed = false;
+}
+
+/**
+ * Despeja a transferência do canal no fio do state machine de destino, no ritmo
+ * do DREQ (o FIFO aceita EMULATOR_FIFO_DEPTH palavras à frente do fio)
+ * @param c Canal
+ */
+static void mock_dma_drain(uint c) {
+    MockDmaChannel *channel = &dma_channels[c];
+    const volatile uint32_t *read = (const volatile uint32_t *)channel->read_addr;
+    bool increment = channel->ctrl & DMA_CONFIG_READ_INCR;
+    uint64_t first_us = now_us, end_us = now_us;
+
+    if (channel->pio) {
+        uint64_t *busy_us = &wire_busy_us[pio_get_index(channel->pio)][channel->sm % MOCK_PIO_SMS];
+        first_us = *busy_us > now_us ? *busy_us : now_us;
+        end_us = first_us;
+        for (uint32_t i = 0; i < channel->trans_count; i++) {
+            end_us = mock_wire_put(channel->pio, channel->sm, read[increment ? i : 0]);
+        }
+    }
+
+    // A última escrita no FIFO acontece quando sobra espaço para ela
+    uint64_t fifo_us = (uint64_t)EMULATOR_FIFO_DEPTH * EMULATOR_WORD_US;
+    channel->done_us = end_us > now_us + fifo_us ? end_us - fifo_us : now_us;
+    channel->stalled = false;
+
+    MockDmaStart *entry = (MockDmaStart *)mock_dma_start(channel->log_index);
+    if (entry) {
+        entry->first_word_us = first_us;
+        entry->wire_end_us = end_us;
+        entry->done_us = channel->done_us;
+    }
+}
+
+/**
+ * Dispara um canal. Com o state machine de destino parado, o DMA enche o FIFO e
+ * espera: as palavras só saem quando ele for habilitado
+ * @param c Canal
+ */
+static void mock_dma_trigger(uint c) {
+    MockDmaChannel *channel = &dma_channels[c];
+
+    channel->busy = true;
+    channel->log_index = dma_log_count;
+    dma_log[dma_log_count++ % MOCK_DMA_LOG_SIZE] =
+        (MockDmaStart){c, (const void *)channel->read_addr, channel->trans_count, channel->pio, channel->sm, now_us,
+                       0, 0, 0};
+
+    bool stalled = channel->pio && channel->trans_count > 0 &&
+                   (sm_disabled[pio_get_index(channel->pio)] & (1u << channel->sm));
+    if (stalled) {
+        channel->stalled = true;
+        return;
+    }
+    mock_dma_drain(c);
+
+    // Transferência vazia (ou fora de um FIFO) termina no ato
+    mock_dma_complete_due();
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint count, bool trigger) {
+    MockDmaChannel *state = &dma_channels[channel];
+    state->ctrl = config->ctrl;
+    state->read_addr = read_addr;
+    state->trans_count = count;
+
+    // Destino: um dos TX FIFOs dos dois blocos
+    state->pio = NULL;
+    for (uint b = 0; b < 2; b++) {
+        PIO pio = b ? pio1 : pio0;
+        for (uint sm = 0; sm < MOCK_PIO_SMS; sm++) {
+            if (write_addr == (volatile void *)&pio->txf[sm]) {
+                state->pio = pio;
+                state->sm = sm;
+            }
+        }
+    }
+
+    if (trigger) mock_dma_trigger(channel);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t count) {
+    dma_channels[channel].read_addr = read_addr;
+    dma_channels[channel].trans_count = count;
+    mock_dma_trigger(channel);
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) {
+    dma_channels[channel].read_addr = read_addr;
+    if (trigger) mock_dma_trigger(channel);
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t count, bool trigger) {
+    dma_channels[channel].trans_count = count;
+    if (trigger) mock_dma_trigger(channel);
+}
+
+void dma_start_channel_mask(uint32_t mask) {
+    mask_log[mask_log_count++ % MOCK_DMA_LOG_SIZE] = mask;
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+        if (mask & (1u << c)) mock_dma_trigger(c);
+    }
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return dma_channels[channel].busy;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+    while (dma_channels[channel].busy) {
+        tight_loop_contents();
+    }
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    dma_channels[channel].irq0_enabled = enabled;
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    return dma_channels[channel].irq0_status;
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    dma_channels[channel].irq0_status = false;
+}
+
+// === INTERRUPÇÕES ===
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t priority) {
+    (void)priority;
+    // Um tratador adicionado de novo ocupa outra posição, como um vazamento na placa
+    for (uint h = 0; h < MOCK_IRQ_HANDLERS; h++) {
+        if (!irq_handlers[num][h]) {
+            irq_handlers[num][h] = handler;
+            return;
+        }
+    }
+}
+
+void irq_remove_handler(uint num, irq_handler_t handler) {
+    for (uint h = 0; h < MOCK_IRQ_HANDLERS; h++) {
+        if (irq_handlers[num][h] == handler) {
+            irq_handlers[num][h] = NULL;
+            return;
+        }
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    irq_enabled = enabled ? irq_enabled | (1u << num) : irq_enabled & ~(1u << num);
+    if (enabled) mock_irq_dispatch();
+}
+
+// === STDIO DA USB ===
+static int stdio_fd = -1;                            // Descritor ligado por mock_stdio_attach()
+static uint8_t stdio_in[256], stdio_out[256];
+static uint stdio_in_head = 0, stdio_in_count = 0, stdio_out_count = 0;
+
+void mock_stdio_attach(int fd) {
+    stdio_fd = fd;
+    stdio_in_head = stdio_in_count = stdio_out_count = 0;
+}
+
+/**
+ * Lê o próximo byte do descritor ligado, sem bloquear (descritor em O_NONBLOCK)
+ * @return Byte lido ou PICO_ERROR_TIMEOUT
+ */
+static int mock_stdio_read(void) {
+    if (stdio_in_head == stdio_in_count) {
+        ssize_t n = stdio_fd < 0 ? 0 : read(stdio_fd, stdio_in, sizeof(stdio_in));
+        if (n <= 0) return PICO_ERROR_TIMEOUT;
+        stdio_in_head = 0;
+        stdio_in_count = (uint)n;
+    }
+    return stdio_in[stdio_in_head++];
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    int c = mock_stdio_read();
+    if (c != PICO_ERROR_TIMEOUT || timeout_us == 0) return c;
+
+    // Espera virtual pelo prazo e tenta de novo
+    sleep_us(timeout_us);
+    return mock_stdio_read();
+}
+
+int putchar_raw(int c) {
+    if (stdio_fd < 0) return putchar(c);
+
+    stdio_out[stdio_out_count++] = (uint8_t)c;
+    if (stdio_out_count == sizeof(stdio_out)) stdio_flush();
+    return c;
+}
+
+void stdio_flush(void) {
+    if (stdio_fd < 0) {
+        fflush(stdout);
+        return;
+    }
+
+    // A confirmação precisa sair inteira: repete enquanto o terminal estiver cheio
+    uint sent = 0;
+    while (sent < stdio_out_count) {
+        ssize_t n = write(stdio_fd, stdio_out + sent, stdio_out_count - sent);
+        if (n > 0) {
+            sent += (uint)n;
+        } else if (n < 0 && errno != EAGAIN) {
+            break;  // Do outro lado ninguém mais lê
+        } else {
+            usleep(100);
+        }
+    }
+    stdio_out_count = 0;
+}
+
+// === INSPEÇÃO (mock_hw.h) ===
+
+void mock_hw_reset(void) {
+    memset(dma_channels, 0, sizeof(dma_channels));
+    memset(irq_handlers, 0, sizeof(irq_handlers));
+    memset(sm_claimed, 0, sizeof(sm_claimed));
+    memset(sm_disabled, 0, sizeof(sm_disabled));
+    memset(programs_loaded, 0, sizeof(programs_loaded));
+    irq_enabled = 0;
+    dma_log_count = 0;
+    mask_log_count = 0;
+    sync_log_count = 0;
+}
+
+uint mock_dma_start_count(void) {
+    return dma_log_count;
+}
+
+const MockDmaStart *mock_dma_start(uint index) {
+    if (index >= dma_log_count || dma_log_count - index > MOCK_DMA_LOG_SIZE) return NULL;
+    return &dma_log[index % MOCK_DMA_LOG_SIZE];
+}
+
+uint mock_dma_mask_start_count(void) {
+    return mask_log_count;
+}
+
+uint32_t mock_dma_mask_start(uint index) {
+    if (index >= mask_log_count || mask_log_count - index > MOCK_DMA_LOG_SIZE) return 0;
+    return mask_log[index % MOCK_DMA_LOG_SIZE];
+}
+
+uint mock_pio_sync_start_count(void) {
+    return sync_log_count;
+}
+
+const MockSmStart *mock_pio_sync_start(uint index) {
+    if (index >= sync_log_count || sync_log_count - index > MOCK_DMA_LOG_SIZE) return NULL;
+    return &sync_log[index % MOCK_DMA_LOG_SIZE];
+}
+
+uint32_t mock_dma_claimed_mask(void) {
+    uint32_t mask = 0;
+    for (uint c = 0; c < NUM_DMA_CHANNELS; c++) {
+        if (dma_channels[c].claimed) mask |= 1u << c;
+    }
+    return mask;
+}
+
+uint32_t mock_pio_claimed_mask(PIO pio) {
+    return sm_claimed[pio_get_index(pio)];
+}
+
+uint mock_irq_handler_count(uint num) {
+    uint count = 0;
+    for (uint h = 0; h < MOCK_IRQ_HANDLERS; h++) count += irq_handlers[num][h] != NULL;
+    return count;
+}
+
+uint mock_pio_program_count(PIO pio) {
+    return programs_loaded[pio_get_index(pio)];
+}
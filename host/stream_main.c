@@ -0,0 +1,86 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "usb_stream.h"
+#include "matrix_geometry.h"
+#include "emulator.h"
+#include "mock_hw.h"
+
+// Placa simulada para o stream.py: usb_stream.c recebe os pacotes por um pseudo-terminal
+// e os frames saem pelo PIO simulado, com o relógio virtual preso ao tempo real (a
+// confirmação só volta depois do tempo de fio do frame anterior, como na placa).
+//   ./build_host/led_stream [segundos]       # imprime "porta /dev/pts/N"
+//   python stream.py --porta /dev/pts/N demo
+// Termina após os segundos pedidos (0 = sem limite) ou USB_STREAM_TIMEOUT_MS sem frames
+// depois do primeiro, e imprime os contadores da recepção.
+
+/**
+ * Tempo real desde a partida
+ * @param start Instante da partida
+ * @return Microssegundos decorridos
+ */
+static uint64_t real_us(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - start->tv_sec) * 1000000 + (now.tv_nsec - start->tv_nsec) / 1000;
+}
+
+int main(int argc, char **argv) {
+    uint64_t duration_us = argc > 1 ? (uint64_t)(atof(argv[1]) * 1e6) : 0;
+
+    // Lado mestre para a "placa"; o escravo fica aberto em modo cru para o stream.py
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+    const char *port = ptsname(master);
+    int slave = open(port, O_RDWR | O_NOCTTY);
+    struct termios raw;
+    tcgetattr(slave, &raw);
+    cfmakeraw(&raw);
+    tcsetattr(slave, TCSANOW, &raw);
+    fcntl(master, F_SETFL, O_NONBLOCK);
+    mock_stdio_attach(master);
+
+    matrix_geometry_init(NULL);
+    emulator_set_capture(false);
+    printf("porta %s\n", port);
+    fflush(stdout);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t virtual_start_us = time_us_64();
+    uint64_t last_frame_us = 0;
+    bool streaming = false;
+
+    while (duration_us == 0 || real_us(&start) < duration_us) {
+        bool shown = usb_stream_poll(pio0, 0);
+        if (shown) {
+            streaming = true;
+            last_frame_us = real_us(&start);
+        } else if (streaming && real_us(&start) - last_frame_us > USB_STREAM_TIMEOUT_MS * 1000ull) {
+            break;
+        }
+
+        // Relógio virtual e tempo real andam juntos: o fio ocupado segura a "placa"
+        uint64_t now_us = real_us(&start), board_us = time_us_64() - virtual_start_us;
+        if (board_us > now_us) {
+            usleep((useconds_t)(board_us - now_us));
+        } else {
+            sleep_us(now_us - board_us);
+            if (!shown) usleep(100);
+        }
+    }
+
+    const UsbStreamStats *stats = usb_stream_get_stats();
+    printf("RECEPCAO,frames=%u,crc=%u,tamanho=%u\n", stats->frames, stats->crc_errors, stats->length_errors);
+    mock_stdio_attach(-1);
+    close(slave);
+    close(master);
+    return 0;
+}
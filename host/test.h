@@ -0,0 +1,33 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+/**
+ * Verificação dos testes do host: registra a falha com arquivo e linha e
+ * continua, para que uma execução mostre todas as diferenças.
+ * Cada teste termina com "return test_report();".
+ */
+
+static int test_failures = 0;
+
+#define CHECK(condition, ...)                                                  \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            fprintf(stderr, "%s:%d: falhou: %s: ", __FILE__, __LINE__, #condition); \
+            fprintf(stderr, __VA_ARGS__);                                      \
+            fputc('\n', stderr);                                               \
+            test_failures++;                                                   \
+        }                                                                      \
+    } while (0)
+
+/**
+ * Resumo da execução
+ * @return Código de saída (1 se alguma verificação falhou)
+ */
+static inline int test_report(void) {
+    printf("%s: %d falha(s)\n", test_failures ? "FALHOU" : "ok", test_failures);
+    return test_failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,83 @@
+#include <string.h>
+#include "test.h"
+#include "animation.h"
+
+// Teste do player de animações (animation.c) com containers montados aqui: frames com
+// paleta decodificados nas cores certas e índices fora da paleta recusados sem ler além dela
+
+#define PALETTE_COLORS 3
+
+static const uint8_t palette[PALETTE_COLORS * 3] = {10, 20, 30, 200, 0, 100, 1, 2, 3};
+
+/**
+ * Monta o cabeçalho e a paleta de um container
+ * @param out Container
+ * @param frames Frames no container
+ * @return Bytes escritos
+ */
+static uint32_t put_header(uint8_t *out, uint16_t frames) {
+    memcpy(out, ANIMATION_MAGIC, 4);
+    out[4] = ANIMATION_VERSION;
+    out[5] = ANIMATION_FLAG_PALETTE;
+    out[6] = MATRIX_WIDTH;
+    out[7] = MATRIX_HEIGHT;
+    out[8] = (uint8_t)frames;
+    out[9] = (uint8_t)(frames >> 8);
+    out[10] = PALETTE_COLORS;
+    out[11] = 0;
+    memcpy(out + ANIMATION_HEADER_BYTES, palette, sizeof(palette));
+    return ANIMATION_HEADER_BYTES + sizeof(palette);
+}
+
+/**
+ * Acrescenta um frame ao container
+ * @param out Posição do frame
+ * @param type Tipo do frame
+ * @param data Dados
+ * @param length Tamanho dos dados
+ * @return Bytes escritos
+ */
+static uint32_t put_frame(uint8_t *out, AnimationFrameType type, const uint8_t *data, uint16_t length) {
+    out[0] = (uint8_t)type;
+    out[1] = 40;
+    out[2] = 0;
+    out[3] = (uint8_t)length;
+    out[4] = (uint8_t)(length >> 8);
+    memcpy(out + ANIMATION_FRAME_HEADER_BYTES, data, length);
+    return ANIMATION_FRAME_HEADER_BYTES + length;
+}
+
+int main(void) {
+    static uint8_t container[256 + 4 * NUM_LEDS];
+    static AnimationPlayer player;
+    RGBColor8 pixels[NUM_LEDS];
+    uint8_t indices[NUM_LEDS];
+
+    // Keyframe com todas as cores e um XOR que leva o pixel 0 ao índice 3 (fora da paleta)
+    for (int i = 0; i < NUM_LEDS; i++) indices[i] = (uint8_t)(i % PALETTE_COLORS);
+    const uint8_t to_three[] = {0x00, 0x03, 0x80 | (NUM_LEDS - 2), 0x00};
+    uint32_t size = put_header(container, 2);
+    size += put_frame(container + size, ANIMATION_FRAME_RAW, indices, NUM_LEDS);
+    size += put_frame(container + size, ANIMATION_FRAME_XOR_RLE, to_three, sizeof(to_three));
+
+    CHECK(animation_open(&player, container, size, pio0, 0, 256, 1), "container válido recusado");
+    CHECK(animation_decode_next(&player, pixels) == 40, "keyframe válido recusado");
+    for (int i = 0; i < NUM_LEDS; i++) {
+        const uint8_t *color = &palette[indices[i] * 3];
+        CHECK(pixels[i].r == color[0] && pixels[i].g == color[1] && pixels[i].b == color[2],
+              "pixel %d: %u,%u,%u", i, pixels[i].r, pixels[i].g, pixels[i].b);
+    }
+    CHECK(animation_decode_next(&player, pixels) == -1, "índice 3 aceito com paleta de %d cores", PALETTE_COLORS);
+
+    // Keyframe RLE inteiro com o maior índice possível
+    const uint8_t all_max[] = {0x80 | (NUM_LEDS - 1), 0xFF};
+    size = put_header(container, 1);
+    size += put_frame(container + size, ANIMATION_FRAME_RLE, all_max, sizeof(all_max));
+
+    CHECK(animation_open(&player, container, size, pio0, 0, 256, 0), "container válido recusado");
+    memset(pixels, 0x5A, sizeof(pixels));
+    CHECK(animation_decode_next(&player, pixels) == -1, "índice 255 aceito com paleta de %d cores", PALETTE_COLORS);
+    CHECK(pixels[0].r == 0x5A && pixels[NUM_LEDS - 1].b == 0x5A, "frame recusado alterou os pixels");
+
+    return test_report();
+}
@@ -0,0 +1,71 @@
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "benchmark.h"
+#include "matrix_geometry.h"
+
+// Teste do formato do benchmark (benchmark.c), com medições curtas (BENCHMARK_TARGET_NS
+// reduzido no CMakeLists): cada caso sai uma vez, com todas as colunas, iterações
+// medidas e o fps máximo limitado pelo fio. Os tempos em si não são conferidos.
+
+#define MAX_CASES 64
+
+static const char *const required[] = {
+    "rgb_matrix_fixed", "pack_frame_fixed", "pack_pixels_fixed", "parallel_transpose_frame",
+    "show_message_frame", "scroll_left_smooth_frame", "composite_4_layers_frame", "transition_crossfade_frame",
+};
+
+int main(void) {
+    static char names[MAX_CASES][64];
+    uint cases = 0;
+    bool header = false;
+    char line[256];
+
+    matrix_geometry_init(NULL);
+    FILE *out = tmpfile();
+    CHECK(out != NULL, "tmpfile");
+    if (!out) return test_report();
+    benchmark_run_all(out);
+    rewind(out);
+
+    // Limite do fio por frame, como em benchmark_print()
+    uint64_t wire_ns = ((uint64_t)NUM_LEDS * BENCHMARK_WIRE_US_PER_LED + BENCHMARK_LATCH_US) * 1000;
+    uint64_t wire_fps = 1000000000ull / wire_ns;
+
+    while (fgets(line, sizeof(line), out)) {
+        if (strncmp(line, "BENCH,", 6) != 0) continue;
+        if (strncmp(line, "BENCH,name,", 11) == 0) {
+            CHECK(!header && cases == 0, "cabeçalho repetido ou depois dos resultados");
+            header = true;
+            continue;
+        }
+
+        char name[64];
+        int width, height, leds;
+        unsigned long iterations;
+        unsigned long long ns, cycles, fps_cpu, fps_max;
+        int fields = sscanf(line, "BENCH,%63[^,],%d,%d,%d,%lu,%llu,%llu,%llu,%llu", name, &width, &height, &leds,
+                            &iterations, &ns, &cycles, &fps_cpu, &fps_max);
+        CHECK(fields == 9, "linha com %d colunas: %s", fields, line);
+        if (fields != 9) continue;
+
+        CHECK(width == MATRIX_WIDTH && height == MATRIX_HEIGHT && leds == NUM_LEDS, "%s: tamanho %dx%d (%d)", name,
+              width, height, leds);
+        CHECK(iterations > 0, "%s sem iterações", name);
+        CHECK(fps_max <= wire_fps && fps_max <= fps_cpu, "%s: fps máximo %llu acima do fio (%llu) ou da CPU (%llu)",
+              name, fps_max, (unsigned long long)wire_fps, fps_cpu);
+
+        for (uint i = 0; i < cases; i++) CHECK(strcmp(names[i], name) != 0, "%s repetido", name);
+        if (cases < MAX_CASES) strcpy(names[cases++], name);
+    }
+    fclose(out);
+
+    CHECK(header, "sem cabeçalho");
+    for (uint r = 0; r < count_of(required); r++) {
+        bool found = false;
+        for (uint i = 0; i < cases; i++) found |= strcmp(names[i], required[r]) == 0;
+        CHECK(found, "caso %s ausente", required[r]);
+    }
+
+    return test_report();
+}
@@ -0,0 +1,88 @@
+#include "test.h"
+#include "compositor.h"
+#include "scroll.h"
+
+// Teste dos pesos do compositor: cobertura 255 (texto aceso, sprite opaco) com opacidade
+// 255 substitui o fundo pela cor exata, e cobertura 0 deixa o fundo intacto
+
+static const RGBColor8 background = {40, 80, 120};
+
+static bool same_color(RGBColor8 a, RGBColor8 b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+/**
+ * Texto opaco sobre um fundo
+ * @param back Cor do fundo
+ */
+static void check_text(RGBColor8 back) {
+    static ScrollAnimation scroll;
+    static uint8_t coverage[NUM_LEDS];
+    RGBColor8 text_color = {255, 17, 200};
+
+    scroll_animation_init(&scroll, "VIRTUS CC", SCROLL_LEFT, TEXT_SPACING, (RGBColor){1, 1, 1}, NULL, 0, 0.1);
+
+    // Primeira posição inteira com alguma letra na janela
+    int lit = 0;
+    for (scroll.position = 0; scroll.position < 64 * 256 && lit == 0; scroll.position += 256) {
+        scroll_render_window(&scroll, scroll.position, coverage, 255);
+        lit = 0;
+        for (int i = 0; i < NUM_LEDS; i++) lit += coverage[i] == 255;
+    }
+    scroll.position -= 256;
+    CHECK(lit > 0, "nenhuma letra na janela");
+
+    Compositor compositor;
+    RGBColor8 out[NUM_LEDS];
+    compositor_init(&compositor);
+    compositor_add_solid(&compositor, back);
+    compositor_add_text(&compositor, &scroll, text_color);
+    compositor_render(&compositor, out);
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        if (coverage[i] == 255) {
+            CHECK(same_color(out[i], text_color), "texto em %d: %u,%u,%u", i, out[i].r, out[i].g, out[i].b);
+        } else if (coverage[i] == 0) {
+            CHECK(same_color(out[i], back), "fundo em %d: %u,%u,%u", i, out[i].r, out[i].g, out[i].b);
+        }
+    }
+}
+
+/**
+ * Sprite com alfa 255, 0 e sem alfa sobre um fundo
+ * @param back Cor do fundo
+ */
+static void check_sprite(RGBColor8 back) {
+    static const RGBColor8 pixels[4] = {{255, 255, 255}, {201, 3, 77}, {9, 250, 130}, {255, 0, 0}};
+    static const uint8_t alpha[4] = {255, 255, 0, 255};
+    const Sprite with_alpha = {2, 2, pixels, alpha};
+    const Sprite opaque = {2, 2, pixels, NULL};
+
+    Compositor compositor;
+    RGBColor8 out[NUM_LEDS];
+    compositor_init(&compositor);
+    compositor_add_solid(&compositor, back);
+    compositor_add_sprite(&compositor, &with_alpha, 0, 0);
+    compositor_add_sprite(&compositor, &opaque, 2, 2);
+    compositor_render(&compositor, out);
+
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 2; x++) {
+            int i = y * 2 + x;
+            RGBColor8 expected = alpha[i] ? pixels[i] : back;
+            RGBColor8 got = out[y * MATRIX_WIDTH + x];
+            CHECK(same_color(got, expected), "sprite com alfa, pixel %d: %u,%u,%u", i, got.r, got.g, got.b);
+
+            got = out[(y + 2) * MATRIX_WIDTH + x + 2];
+            CHECK(same_color(got, pixels[i]), "sprite opaco, pixel %d: %u,%u,%u", i, got.r, got.g, got.b);
+        }
+    }
+}
+
+int main(void) {
+    check_text((RGBColor8){0, 0, 0});
+    check_text(background);
+    check_sprite((RGBColor8){0, 0, 0});
+    check_sprite(background);
+    return test_report();
+}
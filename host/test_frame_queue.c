@@ -0,0 +1,124 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "frame_queue.h"
+#include "benchmark.h"
+
+// Fila SPSC (frame_queue.c) com uma thread produtora e uma consumidora no lugar
+// dos dois núcleos. Cada frame carrega um padrão derivado do número de sequência:
+// um frame lido antes de publicado, reescrito enquanto lido ou fora de ordem
+// não bate com o padrão. Com --bench, mede a vazão da passagem de frames.
+
+#define TEST_FRAMES 200000u              // Frames passados pela fila no teste
+
+typedef struct {
+    uint32_t frames;                     // Frames a passar
+    uint32_t mismatches;                 // Frames com conteúdo ou ordem errados (consumidor)
+    uint32_t first_bad;                  // Sequência do primeiro frame errado
+    uint32_t max_count;                  // Maior ocupação vista pelo consumidor
+} QueueRun;
+
+/**
+ * Byte do padrão de um frame
+ * @param sequence Número do frame
+ * @param index Byte dentro dos pixels
+ * @return Valor esperado
+ */
+static inline uint8_t pattern(uint32_t sequence, uint index) {
+    return (uint8_t)(sequence * 31u + index * 7u + (sequence >> 8));
+}
+
+/**
+ * Produtor (núcleo 0): desenha direto no slot e publica
+ */
+static void *producer(void *arg) {
+    QueueRun *run = arg;
+
+    for (uint32_t sequence = 0; sequence < run->frames; sequence++) {
+        QueuedFrame *frame = frame_queue_acquire_blocking();
+        uint8_t *bytes = (uint8_t *)frame->pixels;
+        for (uint i = 0; i < sizeof(frame->pixels); i++) {
+            bytes[i] = pattern(sequence, i);
+        }
+        frame->intensity = (uint16_t)sequence;
+        frame_queue_publish();
+    }
+    return NULL;
+}
+
+/**
+ * Consumidor (núcleo 1): confere cada frame antes de liberar o slot
+ */
+static void *consumer(void *arg) {
+    QueueRun *run = arg;
+
+    for (uint32_t sequence = 0; sequence < run->frames; sequence++) {
+        const QueuedFrame *frame;
+        while ((frame = frame_queue_peek()) == NULL) {
+            __wfe();
+        }
+
+        uint count = frame_queue_count();
+        if (count > run->max_count) run->max_count = count;
+
+        const uint8_t *bytes = (const uint8_t *)frame->pixels;
+        bool ok = frame->intensity == (uint16_t)sequence;
+        for (uint i = 0; i < sizeof(frame->pixels) && ok; i++) {
+            ok = bytes[i] == pattern(sequence, i);
+        }
+        if (!ok && run->mismatches++ == 0) run->first_bad = sequence;
+
+        frame_queue_release();
+    }
+    return NULL;
+}
+
+/**
+ * Passa os frames pela fila com as duas threads
+ * @param run Parâmetros e resultados
+ * @return Tempo total em ns
+ */
+static uint64_t queue_run(QueueRun *run) {
+    pthread_t threads[2];
+
+    frame_queue_reset();
+    uint64_t start = benchmark_now_ns();
+    pthread_create(&threads[0], NULL, consumer, run);
+    pthread_create(&threads[1], NULL, producer, run);
+    pthread_join(threads[1], NULL);
+    pthread_join(threads[0], NULL);
+    return benchmark_now_ns() - start;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        // Vazão: frames por segundo atravessando a fila (escrita e conferência incluídas)
+        QueueRun run = {TEST_FRAMES * 5, 0, 0, 0};
+        uint64_t elapsed = queue_run(&run);
+        BenchmarkResult result = {"frame_queue_handoff", run.frames, elapsed, elapsed / run.frames, 0};
+        benchmark_print(stdout, &result, true);
+        return run.mismatches ? 1 : 0;
+    }
+
+    QueueRun run = {TEST_FRAMES, 0, 0, 0};
+    queue_run(&run);
+
+    CHECK(run.mismatches == 0, "%u frames errados, o primeiro foi o %u", run.mismatches, run.first_bad);
+    CHECK(frame_queue_count() == 0, "%u frames sobrando na fila", frame_queue_count());
+    CHECK(run.max_count <= FRAME_QUEUE_DEPTH, "ocupação %u acima de FRAME_QUEUE_DEPTH", run.max_count);
+    CHECK(frame_queue_peek() == NULL, "fila vazia devolveu um frame");
+
+    // Fila cheia: o produtor não recebe slot até o consumidor liberar um
+    frame_queue_reset();
+    for (uint i = 0; i < FRAME_QUEUE_DEPTH; i++) {
+        CHECK(frame_queue_acquire() != NULL, "slot %u negado com a fila incompleta", i);
+        frame_queue_publish();
+    }
+    CHECK(frame_queue_acquire() == NULL, "slot entregue com a fila cheia");
+    frame_queue_peek();
+    frame_queue_release();
+    CHECK(frame_queue_acquire() != NULL, "slot negado depois da liberação");
+
+    return test_report();
+}
@@ -0,0 +1,127 @@
+#include <string.h>
+#include "test.h"
+#include "led_dma.h"
+#include "emulator.h"
+#include "mock_hw.h"
+
+// Teste do caminho DMA (led_dma.c) sobre o DMA simulado: disparo, interrupção de
+// conclusão, troca do buffer duplo, latch entre dois frames seguidos e reinicialização
+// sem vazar canal nem tratador
+
+static uint done_count = 0;               // Chamadas do callback de conclusão
+static uint64_t done_us = 0;              // Instante da última chamada
+
+static void on_done(void *user_data) {
+    (void)user_data;
+    done_count++;
+    done_us = time_us_64();
+}
+
+/**
+ * Preenche o buffer livre com um padrão por frame
+ * @param buffer Buffer livre
+ * @param frame Número do frame
+ */
+static void fill(uint32_t *buffer, uint frame) {
+    for (int i = 0; i < NUM_LEDS; i++) {
+        buffer[i] = ((uint32_t)(frame * 64 + i) & 0xFF) << (8 * (frame + 1));
+    }
+}
+
+int main(void) {
+    mock_hw_reset();
+    emulator_reset();
+
+    CHECK(led_dma_init(pio0, 0), "sem canal DMA");
+    CHECK(led_dma_is_attached(pio0, 0), "DMA não ligado ao pio0/sm0");
+    CHECK(!led_dma_is_attached(pio1, 0), "DMA ligado ao bloco errado");
+
+    // Mesma ligação de novo (matrix_init chamada outra vez): nada muda
+    uint32_t claimed = mock_dma_claimed_mask();
+    CHECK(led_dma_init(pio0, 0), "reinicialização falhou");
+    CHECK(mock_dma_claimed_mask() == claimed, "canais 0x%x, antes 0x%x", mock_dma_claimed_mask(), claimed);
+    CHECK(mock_irq_handler_count(DMA_IRQ_0) == 1, "%u tratadores em DMA_IRQ_0", mock_irq_handler_count(DMA_IRQ_0));
+    led_dma_set_callback(on_done, NULL);
+
+    // Linha parada desde o boot: o primeiro envio não espera latch
+    sleep_us(LED_DMA_IDLE_US);
+
+    // Frame 0: o envio retorna sem esperar o fio
+    uint32_t *first = led_dma_get_back_buffer();
+    fill(first, 0);
+    uint64_t submit0_us = time_us_64();
+    led_dma_submit(NUM_LEDS);
+    CHECK(time_us_64() == submit0_us, "envio ocupou a CPU por %llu us",
+          (unsigned long long)(time_us_64() - submit0_us));
+    CHECK(led_dma_is_busy(), "transferência não está em andamento");
+    CHECK(led_dma_get_front_buffer() == first, "o buffer enviado não virou o da frente");
+    CHECK(led_dma_get_back_buffer() != first, "o buffer livre é o que está no fio");
+
+    const MockDmaStart *start0 = mock_dma_start(0);
+    CHECK(start0 && start0->read_addr == first && start0->count == NUM_LEDS, "disparo do frame 0 errado");
+    CHECK(start0 && start0->pio == pio0 && start0->sm == 0, "DMA do frame 0 fora do TX FIFO do sm0");
+
+    // Frame 1 montado enquanto o 0 sai; o envio espera o latch do anterior
+    uint32_t *second = led_dma_get_back_buffer();
+    fill(second, 1);
+    led_dma_submit(NUM_LEDS);
+    uint64_t submit1_us = time_us_64();
+
+    CHECK(done_count == 1, "interrupção do frame 0 chamada %u vezes", done_count);
+    if (start0) {
+        // A interrupção vem quando o DMA escreve a última palavra, com o FIFO ainda cheio
+        uint64_t fifo_us = (uint64_t)EMULATOR_FIFO_DEPTH * EMULATOR_WORD_US;
+        CHECK(done_us + fifo_us == start0->wire_end_us, "interrupção em %llu us, fio termina em %llu us",
+              (unsigned long long)done_us, (unsigned long long)start0->wire_end_us);
+    }
+
+    const MockDmaStart *start1 = mock_dma_start(1);
+    CHECK(mock_dma_start_count() == 2, "%u disparos", mock_dma_start_count());
+    CHECK(start1 && start1->read_addr == second, "frame 1 não saiu do outro buffer");
+    if (start0 && start1) {
+        CHECK(start1->first_word_us >= start0->wire_end_us + LED_RESET_US,
+              "linha parada %llu us entre os frames, reset pede %d us",
+              (unsigned long long)(start1->first_word_us - start0->wire_end_us), LED_RESET_US);
+        CHECK(submit1_us < start1->wire_end_us, "o segundo envio esperou o próprio frame");
+    }
+    CHECK(led_dma_get_back_buffer() == first, "os buffers não alternaram");
+
+    // Fim do frame 1
+    led_dma_wait();
+    CHECK(!led_dma_is_busy(), "ainda ocupado depois de led_dma_wait()");
+    CHECK(done_count == 2, "interrupção do frame 1 chamada %u vezes no total", done_count);
+
+    // O emulador remonta os dois frames, separados pelo latch
+    emulator_flush();
+    CHECK(emulator_frame_count() == 2, "%u frames no fio", emulator_frame_count());
+    if (emulator_frame_count() == 2) {
+        uint32_t expected[NUM_LEDS];
+        fill(expected, 0);
+        CHECK(memcmp(emulator_frame(0)->words, expected, sizeof(expected)) == 0, "frame 0 chegou diferente");
+        fill(expected, 1);
+        CHECK(memcmp(emulator_frame(1)->words, expected, sizeof(expected)) == 0, "frame 1 chegou diferente");
+    }
+
+    // Outro state machine: o canal anterior é devolvido e o tratador continua único
+    fill(led_dma_get_back_buffer(), 2);
+    led_dma_submit(NUM_LEDS);
+    CHECK(led_dma_init(pio0, 1), "ligação ao sm1 falhou");
+    CHECK(!led_dma_is_busy(), "canal trocado com o frame 2 ainda no fio");
+    CHECK(led_dma_is_attached(pio0, 1) && !led_dma_is_attached(pio0, 0), "ligação não trocou para o sm1");
+    CHECK(__builtin_popcount(mock_dma_claimed_mask()) == 1, "canais 0x%x reivindicados", mock_dma_claimed_mask());
+    CHECK(mock_irq_handler_count(DMA_IRQ_0) == 1, "%u tratadores em DMA_IRQ_0", mock_irq_handler_count(DMA_IRQ_0));
+
+    uint starts = mock_dma_start_count();
+    led_dma_submit(NUM_LEDS);
+    const MockDmaStart *start3 = mock_dma_start(starts);
+    CHECK(start3 && start3->pio == pio0 && start3->sm == 1, "frame depois da troca fora do sm1");
+    led_dma_wait();
+    CHECK(done_count == 4, "interrupção chamada %u vezes em 4 frames", done_count);
+
+    led_dma_deinit();
+    CHECK(mock_dma_claimed_mask() == 0, "canais 0x%x depois de led_dma_deinit()", mock_dma_claimed_mask());
+    CHECK(mock_irq_handler_count(DMA_IRQ_0) == 0, "tratador ficou em DMA_IRQ_0");
+    CHECK(!led_dma_is_attached(pio0, 1), "ainda ligado depois de led_dma_deinit()");
+
+    return test_report();
+}
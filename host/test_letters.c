@@ -0,0 +1,28 @@
+#include "test.h"
+#include "letters.h"
+#include "font.h"
+
+// Caminho de largura fixa (letters.h): caracteres sem glifo e bytes fora do ASCII
+// usam o mesmo substituto da fonte de largura variável (font.h)
+
+int main(void) {
+    uint32_t question = glyph_for_char('?');
+    CHECK(question != 0, "substituto apagado");
+    CHECK(glyph_for_char(' ') == 0, "espaço aceso");
+    CHECK(glyph_for_char('A') != question, "'A' virou substituto");
+    CHECK(glyph_for_char('a') == glyph_for_char('A'), "minúscula não usa a maiúscula");
+
+    // "É" em UTF-8 (C3 89): cada byte vira o substituto, nunca uma letra ASCII
+    CHECK(glyph_for_char('\xC3') == question, "0xC3 virou 0x%07lX", (unsigned long)glyph_for_char('\xC3'));
+    CHECK(glyph_for_char('\x89') == question, "0x89 virou 0x%07lX", (unsigned long)glyph_for_char('\x89'));
+    CHECK(glyph_for_char('\xC3') != glyph_for_char('C'), "0xC3 desenha 'C'");
+
+    // Códigos ASCII sem glifo na fonte ficam com o substituto nos dois caminhos
+    for (int c = 1; c < 128; c++) {
+        if (font_find_glyph(&font_5x5, (uint32_t)c) == font_5x5.fallback) {
+            CHECK(glyph_for_char((char)c) == question, "código 0x%02X sem o substituto", c);
+        }
+    }
+
+    return test_report();
+}
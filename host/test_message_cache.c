@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <string.h>
+#include "test.h"
+#include "message_cache.h"
+#include "scroll.h"
+
+// Teste do cache de mensagens (message_cache.c): máscaras vindas da arena iguais às de
+// uma montagem nova, chave completa (texto, fonte, eixo, espaçamento) e descarte LRU
+// com a arena compactada sem corromper as entradas que ficam
+
+static const char *const texts[] = {"VIRTUS CC", "Ação às 10h: VIRTUS CC!", "A", "", "12345 67890"};
+
+/**
+ * Máscaras de uma mensagem montadas de novo, sem o cache
+ * @param anim Rolagem com o resultado
+ * @param text Texto
+ * @param direction Sentido
+ * @param spacing Espaçamento
+ */
+static void build_fresh(ScrollAnimation *anim, const char *text, ScrollDirection direction, int spacing) {
+    message_cache_clear();
+    anim->direction = direction;
+    scroll_animation_set_text(anim, text, SCROLL_FONT, spacing);
+}
+
+/**
+ * Linhas sintéticas de uma mensagem, diferentes para cada semente
+ * @param lines Saída
+ * @param count Linhas
+ * @param seed Semente
+ */
+static void fill_lines(uint32_t *lines, int count, uint32_t seed) {
+    for (int i = 0; i < count; i++) lines[i] = seed * 2654435761u + (uint32_t)i * 40503u;
+}
+
+/**
+ * Confere uma entrada do cache contra as linhas sintéticas
+ * @param text Texto
+ * @param count Linhas esperadas
+ * @param seed Semente usada no put
+ * @return true se a entrada está no cache
+ */
+static bool cached(const char *text, int count, uint32_t seed) {
+    static uint32_t lines[SCROLL_MAX_LINES], expected[SCROLL_MAX_LINES];
+    int got = message_cache_get(text, SCROLL_FONT, 0, lines, SCROLL_MAX_LINES);
+    if (got < 0) return false;
+
+    fill_lines(expected, count, seed);
+    CHECK(got == count && memcmp(lines, expected, count * sizeof(uint32_t)) == 0, "\"%s\" voltou diferente", text);
+    return true;
+}
+
+int main(void) {
+    static ScrollAnimation fresh, hit;
+    static const ScrollDirection directions[] = {SCROLL_LEFT, SCROLL_UP};
+    MessageCacheStats stats;
+
+    // Acerto igual à montagem nova, nos dois eixos e com espaçamentos diferentes
+    for (uint t = 0; t < count_of(texts); t++) {
+        for (uint d = 0; d < count_of(directions); d++) {
+            for (int spacing = 0; spacing <= 2; spacing++) {
+                build_fresh(&fresh, texts[t], directions[d], spacing);
+
+                // Popula o cache com a mesma chave e com chaves vizinhas
+                hit.direction = directions[d];
+                scroll_animation_set_text(&hit, texts[t], SCROLL_FONT, spacing);
+                scroll_animation_set_text(&hit, texts[t], SCROLL_FONT, spacing + 1);
+                hit.direction = directions[d] == SCROLL_LEFT ? SCROLL_UP : SCROLL_LEFT;
+                scroll_animation_set_text(&hit, texts[t], SCROLL_FONT, spacing);
+
+                message_cache_stats(&stats);
+                uint32_t hits_before = stats.hits;
+                hit.direction = directions[d];
+                memset(hit.lines, 0xFF, sizeof(hit.lines));
+                scroll_animation_set_text(&hit, texts[t], SCROLL_FONT, spacing);
+                message_cache_stats(&stats);
+
+                CHECK(stats.hits == hits_before + 1, "\"%s\" (%u, %d) não veio do cache", texts[t], d, spacing);
+                CHECK(hit.count == fresh.count && memcmp(hit.lines, fresh.lines, fresh.count * sizeof(uint32_t)) == 0,
+                      "\"%s\" (%u, %d): máscaras do cache diferentes da montagem", texts[t], d, spacing);
+            }
+        }
+    }
+
+    // Residência LRU: a entrada tocada por último sobrevive ao descarte
+    static uint32_t lines[SCROLL_MAX_LINES];
+    static char names[MESSAGE_CACHE_ENTRIES + 1][8];
+    message_cache_clear();
+    for (int i = 0; i < MESSAGE_CACHE_ENTRIES; i++) {
+        snprintf(names[i], sizeof(names[i]), "m%d", i);
+        fill_lines(lines, 10 + i, (uint32_t)i);
+        message_cache_put(names[i], SCROLL_FONT, 0, lines, 10 + i);
+    }
+    CHECK(cached(names[0], 10, 0), "m0 fora do cache antes do descarte");
+
+    snprintf(names[MESSAGE_CACHE_ENTRIES], sizeof(names[0]), "m%d", MESSAGE_CACHE_ENTRIES);
+    fill_lines(lines, 5, MESSAGE_CACHE_ENTRIES);
+    message_cache_put(names[MESSAGE_CACHE_ENTRIES], SCROLL_FONT, 0, lines, 5);
+
+    message_cache_stats(&stats);
+    CHECK(stats.evictions == 1 && stats.entries == MESSAGE_CACHE_ENTRIES, "%u descartes, %u entradas", stats.evictions,
+          stats.entries);
+    CHECK(!cached(names[1], 11, 1), "m1, a menos usada, continua no cache");
+    CHECK(cached(names[0], 10, 0), "m0, usada por último, saiu do cache");
+    for (int i = 2; i < MESSAGE_CACHE_ENTRIES; i++) {
+        CHECK(cached(names[i], 10 + i, (uint32_t)i), "m%d saiu do cache", i);
+    }
+    CHECK(cached(names[MESSAGE_CACHE_ENTRIES], 5, MESSAGE_CACHE_ENTRIES), "a nova entrada não ficou");
+
+    // Falta de espaço na arena: sai a menos usada e as outras descem intactas
+    message_cache_clear();
+    // Três cabem na arena (texto de 9 bytes = 3 palavras), a quarta não
+    int big = MESSAGE_CACHE_WORDS / 3 - 3;
+    if (big > SCROLL_MAX_LINES) big = SCROLL_MAX_LINES;
+    const char *big_names[] = {"grande 0", "grande 1", "grande 2", "grande 3"};
+    for (int i = 0; i < 4; i++) {
+        if (i == 3) cached(big_names[0], big, 100);  // grande 0 passa à frente de grande 1
+        fill_lines(lines, big, 100 + (uint32_t)i);
+        message_cache_put(big_names[i], SCROLL_FONT, 0, lines, big);
+    }
+    message_cache_stats(&stats);
+    CHECK(stats.used_words <= MESSAGE_CACHE_WORDS, "arena com %u palavras", stats.used_words);
+    if (4 * (big + 3) > MESSAGE_CACHE_WORDS) {
+        CHECK(!cached(big_names[1], big, 101), "grande 1 deveria ter saído");
+    }
+    CHECK(cached(big_names[0], big, 100), "grande 0 saiu ou foi corrompida");
+    CHECK(cached(big_names[2], big, 102), "grande 2 saiu ou foi corrompida na compactação");
+    CHECK(cached(big_names[3], big, 103), "grande 3 não ficou");
+
+    return test_report();
+}
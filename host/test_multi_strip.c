@@ -0,0 +1,145 @@
+#include "test.h"
+#include "multi_strip.h"
+#include "led_dma.h"
+#include "matrix_geometry.h"
+#include "emulator.h"
+#include "mock_hw.h"
+
+// Teste das fitas paralelas (multi_strip.c) sobre o PIO e o DMA simulados: segmento
+// e tamanho de cada canal, partida única por máscara, habilitação sincronizada dos
+// state machines e limpeza quando a inicialização falha no meio ou é refeita
+
+#define STRIPS 6                          // Ocupa os 4 SMs de pio0 e 2 de pio1
+
+static const StripConfig configs[STRIPS] = {
+    {2, 0, 4}, {3, 4, 4}, {4, 8, 4}, {5, 12, 4}, {6, 16, 4}, {7, 20, NUM_LEDS - 20},
+};
+
+static RGBColor8 pixels[NUM_LEDS];
+
+/**
+ * Disparo registrado de um canal dentro de um envio
+ * @param first Primeiro registro do envio
+ * @param channel Canal
+ * @return Registro, ou NULL se o canal não foi disparado
+ */
+static const MockDmaStart *find_start(uint first, uint channel) {
+    for (uint i = first; i < mock_dma_start_count(); i++) {
+        const MockDmaStart *start = mock_dma_start(i);
+        if (start && start->channel == channel) return start;
+    }
+    return NULL;
+}
+
+/**
+ * Confere um envio: cada canal lê o próprio segmento do mesmo buffer, com o tamanho da fita
+ * @param first Primeiro registro do envio
+ * @return Início do buffer lido (NULL se algum canal faltou)
+ */
+static const uint8_t *check_submit(uint first) {
+    CHECK(mock_dma_start_count() - first == STRIPS, "%u disparos no envio", mock_dma_start_count() - first);
+
+    const MockDmaStart *base = find_start(first, 0);
+    CHECK(base != NULL, "canal 0 não disparou");
+    if (!base) return NULL;
+
+    for (uint i = 0; i < STRIPS; i++) {
+        const MockDmaStart *start = find_start(first, i);
+        CHECK(start != NULL, "canal %u não disparou", i);
+        if (!start) continue;
+
+        long offset = (const uint8_t *)start->read_addr - (const uint8_t *)base->read_addr;
+        CHECK(offset == (long)(configs[i].first_led * sizeof(uint32_t)), "canal %u lê no byte %ld", i, offset);
+        CHECK(start->count == configs[i].led_count, "canal %u transfere %u palavras", i, start->count);
+        CHECK(start->pio == (i < 4 ? pio0 : pio1) && start->sm == i % 4, "canal %u no state machine errado", i);
+
+        // Ninguém sai no fio antes da habilitação conjunta
+        CHECK(start->first_word_us == base->first_word_us, "fita %u começou em %llu us, a 0 em %llu us", i,
+              (unsigned long long)start->first_word_us, (unsigned long long)base->first_word_us);
+    }
+    return (const uint8_t *)base->read_addr;
+}
+
+int main(void) {
+    matrix_geometry_init(NULL);
+    emulator_set_capture(false);
+    for (int i = 0; i < NUM_LEDS; i++) pixels[i] = (RGBColor8){(uint8_t)i, (uint8_t)(i * 3), (uint8_t)(i * 7)};
+
+    // Falta canal DMA na terceira fita: nada fica reivindicado
+    mock_hw_reset();
+    for (int c = 0; c < NUM_DMA_CHANNELS - 2; c++) dma_claim_unused_channel(true);
+    uint32_t dma_before = mock_dma_claimed_mask();
+    CHECK(!multi_strip_init(configs, STRIPS), "inicializou sem canais DMA suficientes");
+    CHECK(mock_dma_claimed_mask() == dma_before, "canais DMA vazados: 0x%x", mock_dma_claimed_mask());
+    CHECK(mock_pio_claimed_mask(pio0) == 0 && mock_pio_claimed_mask(pio1) == 0, "state machines vazados");
+    CHECK(mock_pio_program_count(pio0) == 0, "programa vazado em pio0");
+    CHECK(!multi_strip_is_busy(), "fitas parciais ficaram ativas");
+
+    // Segmento fora de NUM_LEDS na quarta fita
+    mock_hw_reset();
+    StripConfig bad[STRIPS];
+    for (int i = 0; i < STRIPS; i++) bad[i] = configs[i];
+    bad[3].led_count = NUM_LEDS;
+    CHECK(!multi_strip_init(bad, STRIPS), "aceitou segmento fora da cadeia");
+    CHECK(mock_dma_claimed_mask() == 0, "canais DMA vazados: 0x%x", mock_dma_claimed_mask());
+    CHECK(mock_pio_claimed_mask(pio0) == 0 && mock_pio_claimed_mask(pio1) == 0, "state machines vazados");
+
+    // Configuração válida
+    mock_hw_reset();
+    CHECK(multi_strip_init(configs, STRIPS), "inicialização falhou");
+    CHECK(mock_pio_claimed_mask(pio0) == 0xF && mock_pio_claimed_mask(pio1) == 0x3, "state machines 0x%x/0x%x",
+          mock_pio_claimed_mask(pio0), mock_pio_claimed_mask(pio1));
+    CHECK(mock_dma_claimed_mask() == 0x3F, "canais DMA 0x%x", mock_dma_claimed_mask());
+
+    // Frame 0: uma única partida por máscara e uma habilitação sincronizada por bloco
+    sleep_us(LED_DMA_IDLE_US);
+    multi_strip_submit(pixels, INTENSITY_FIXED_MAX);
+    CHECK(mock_dma_mask_start_count() == 1, "%u partidas por máscara", mock_dma_mask_start_count());
+    CHECK(mock_dma_mask_start(0) == 0x3F, "máscara 0x%x", mock_dma_mask_start(0));
+    CHECK(mock_pio_sync_start_count() == 2, "%u habilitações sincronizadas", mock_pio_sync_start_count());
+    const MockSmStart *sync0 = mock_pio_sync_start(0), *sync1 = mock_pio_sync_start(1);
+    CHECK(sync0 && sync0->pio == pio0 && sync0->mask == 0xF, "pio0 não habilitou os 4 SMs juntos");
+    CHECK(sync1 && sync1->pio == pio1 && sync1->mask == 0x3, "pio1 não habilitou os 2 SMs juntos");
+    const uint8_t *buffer0 = check_submit(0);
+
+    // Frame 1: espera o latch da fita mais longa e lê o outro buffer
+    multi_strip_submit(pixels, INTENSITY_FIXED_MAX);
+    CHECK(mock_dma_mask_start_count() == 2, "%u partidas por máscara", mock_dma_mask_start_count());
+    const uint8_t *buffer1 = check_submit(STRIPS);
+    CHECK(buffer0 && buffer1 && buffer0 != buffer1, "os dois frames saíram do mesmo buffer");
+
+    uint64_t last_end_us = 0;
+    for (uint i = 0; i < STRIPS; i++) {
+        const MockDmaStart *start = find_start(0, i);
+        if (start && start->wire_end_us > last_end_us) last_end_us = start->wire_end_us;
+    }
+    const MockDmaStart *next = find_start(STRIPS, 0);
+    CHECK(next && next->first_word_us >= last_end_us + LED_RESET_US, "linha parada %llu us entre os frames",
+          next ? (unsigned long long)(next->first_word_us - last_end_us) : 0ULL);
+
+    multi_strip_wait();
+    CHECK(!multi_strip_is_busy(), "ainda ocupado depois de multi_strip_wait()");
+
+    // Nova configuração com duas fitas, com um frame ainda no fio: a anterior é devolvida
+    multi_strip_submit(pixels, INTENSITY_FIXED_MAX);
+    CHECK(multi_strip_init(configs, 2), "reinicialização com 2 fitas falhou");
+    CHECK(mock_pio_claimed_mask(pio0) == 0x3 && mock_pio_claimed_mask(pio1) == 0,
+          "state machines 0x%x/0x%x depois de reinicializar", mock_pio_claimed_mask(pio0), mock_pio_claimed_mask(pio1));
+    CHECK(mock_dma_claimed_mask() == 0x3, "canais DMA 0x%x depois de reinicializar", mock_dma_claimed_mask());
+    CHECK(mock_pio_program_count(pio0) == 1 && mock_pio_program_count(pio1) == 0, "programas %u/%u carregados",
+          mock_pio_program_count(pio0), mock_pio_program_count(pio1));
+
+    // De volta às seis fitas, e uma configuração inválida que desfaz tudo
+    CHECK(multi_strip_init(configs, STRIPS), "reinicialização com %d fitas falhou", STRIPS);
+    CHECK(mock_pio_claimed_mask(pio0) == 0xF && mock_pio_claimed_mask(pio1) == 0x3 && mock_dma_claimed_mask() == 0x3F,
+          "recursos 0x%x/0x%x, DMA 0x%x", mock_pio_claimed_mask(pio0), mock_pio_claimed_mask(pio1),
+          mock_dma_claimed_mask());
+    CHECK(mock_pio_program_count(pio0) == 1 && mock_pio_program_count(pio1) == 1, "programas %u/%u carregados",
+          mock_pio_program_count(pio0), mock_pio_program_count(pio1));
+    CHECK(!multi_strip_init(bad, STRIPS), "aceitou segmento fora da cadeia");
+    CHECK(mock_dma_claimed_mask() == 0 && mock_pio_claimed_mask(pio0) == 0 && mock_pio_claimed_mask(pio1) == 0,
+          "recursos vazados depois da falha");
+    CHECK(mock_pio_program_count(pio0) == 0 && mock_pio_program_count(pio1) == 0, "programas vazados");
+
+    return test_report();
+}
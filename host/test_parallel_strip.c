@@ -0,0 +1,95 @@
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "parallel_strip.h"
+
+// Teste da transposição das 8 fitas (parallel_strip.c) contra uma referência bit a bit,
+// com segmentos completos e com o último segmento incompleto (posições apagadas)
+
+#define MAX_LEDS_PER_LANE (PARALLEL_LEDS_PER_LANE > 16 ? PARALLEL_LEDS_PER_LANE : 16) // Maior segmento testado
+
+/**
+ * Referência: o byte b do LED led tem, no bit k, o bit 31 - b da palavra da fita k
+ * @param words Palavras G|R|B na ordem da cadeia
+ * @param count Palavras válidas
+ * @param leds_per_lane LEDs por fita
+ * @param out Bytes de saída
+ */
+static void reference_transpose(const uint32_t *words, uint count, uint leds_per_lane, uint8_t *out) {
+    for (uint led = 0; led < leds_per_lane; led++) {
+        for (uint bit = 0; bit < PARALLEL_BYTES_PER_LED; bit++) {
+            uint8_t byte = 0;
+            for (uint lane = 0; lane < PARALLEL_LANES; lane++) {
+                uint index = lane * leds_per_lane + led;
+                uint32_t word = index < count ? words[index] : 0;
+                byte |= (uint8_t)(((word >> (31 - bit)) & 1) << lane);
+            }
+            out[led * PARALLEL_BYTES_PER_LED + bit] = byte;
+        }
+    }
+}
+
+/**
+ * Compara kernel e referência para um tamanho de frame
+ * @param words Palavras de entrada
+ * @param count Palavras válidas
+ * @param leds_per_lane LEDs por fita
+ */
+static void check_frame(const uint32_t *words, uint count, uint leds_per_lane) {
+    uint8_t expected[MAX_LEDS_PER_LANE * PARALLEL_BYTES_PER_LED + 1];
+    uint8_t actual[MAX_LEDS_PER_LANE * PARALLEL_BYTES_PER_LED + 1];
+    uint size = leds_per_lane * PARALLEL_BYTES_PER_LED;
+
+    reference_transpose(words, count, leds_per_lane, expected);
+    memset(actual, 0xA5, sizeof(actual));
+    parallel_transpose(words, count, leds_per_lane, actual);
+
+    for (uint i = 0; i < size; i++) {
+        if (actual[i] != expected[i]) {
+            CHECK(false, "%u LEDs, %u por fita: byte %u (LED %u, bit %u) = 0x%02x, esperado 0x%02x", count,
+                  leds_per_lane, i, i / PARALLEL_BYTES_PER_LED, i % PARALLEL_BYTES_PER_LED, actual[i], expected[i]);
+            return;
+        }
+    }
+    CHECK(actual[size] == 0xA5, "%u LEDs, %u por fita: escreveu além do plano", count, leds_per_lane);
+}
+
+int main(void) {
+    uint32_t words[PARALLEL_LANES * MAX_LEDS_PER_LANE];
+
+    // Um bit aceso por vez: cada bit de cada fita cai em um único bit da saída
+    for (uint lane = 0; lane < PARALLEL_LANES; lane++) {
+        for (uint bit = 8; bit < 32; bit++) {
+            uint32_t lane_words[PARALLEL_LANES] = {0};
+            uint8_t out[PARALLEL_BYTES_PER_LED];
+            lane_words[lane] = 1u << bit;
+            transpose8_grb(lane_words, out);
+
+            for (uint b = 0; b < PARALLEL_BYTES_PER_LED; b++) {
+                uint8_t expected = b == 31 - bit ? (uint8_t)(1u << lane) : 0;
+                CHECK(out[b] == expected, "fita %u, bit %u: byte %u = 0x%02x", lane, bit, b, out[b]);
+            }
+        }
+    }
+
+    // Frames aleatórios (os 8 bits baixos, fora do fio, também vão preenchidos)
+    srand(1);
+    for (uint i = 0; i < count_of(words); i++) {
+        words[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    }
+    for (uint leds_per_lane = 1; leds_per_lane <= MAX_LEDS_PER_LANE; leds_per_lane++) {
+        uint full = PARALLEL_LANES * leds_per_lane;
+
+        // Segmentos completos, último segmento incompleto e fitas finais vazias
+        check_frame(words, full, leds_per_lane);
+        check_frame(words, full - 1, leds_per_lane);
+        check_frame(words, full - leds_per_lane / 2 - 1, leds_per_lane);
+        check_frame(words, (PARALLEL_LANES - 3) * leds_per_lane + 1, leds_per_lane);
+        check_frame(words, 0, leds_per_lane);
+    }
+
+    // Tamanho usado pelo firmware
+    check_frame(words, NUM_LEDS, PARALLEL_LEDS_PER_LANE);
+
+    return test_report();
+}
@@ -0,0 +1,54 @@
+import os
+import re
+import subprocess
+import sys
+
+# stream.py contra a placa simulada (led_stream): usb_stream.c recebe pelo pseudo-terminal,
+# o stream.py mostra fps e latência, e nenhum frame pode ser recusado ou perdido.
+# Uso:
+#   python host/test_stream.py build_host/led_stream [segundos]
+
+RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def main():
+    placa_bin = sys.argv[1]
+    duracao = float(sys.argv[2]) if len(sys.argv) > 2 else 3.0
+    ambiente = dict(os.environ, PYTHONIOENCODING='utf-8')
+
+    placa = subprocess.Popen([placa_bin, '0'], stdout=subprocess.PIPE, text=True)
+    porta = placa.stdout.readline().split()[1]
+
+    envio = subprocess.run([sys.executable, os.path.join(RAIZ, 'stream.py'), '--porta', porta,
+                            '--duracao', str(duracao), 'demo'],
+                           capture_output=True, text=True, encoding='utf-8', env=ambiente, timeout=duracao + 30)
+    print(envio.stdout, end='')
+
+    # A placa encerra sozinha USB_STREAM_TIMEOUT_MS depois do último frame
+    recepcao, _ = placa.communicate(timeout=30)
+    print(recepcao, end='')
+
+    resumo = re.search(r'(\d+) frames em [\d.]+ s: ([\d.]+) fps.*?erros (\d+)\s+perdidos (\d+)', envio.stdout, re.S)
+    contadores = re.search(r'RECEPCAO,frames=(\d+),crc=(\d+),tamanho=(\d+)', recepcao)
+    falhas = []
+    if envio.returncode != 0 or not resumo:
+        falhas.append(f"stream.py não confirmou frames:\n{envio.stderr}")
+    if not contadores:
+        falhas.append("a placa simulada não mostrou os contadores")
+    if resumo and contadores:
+        confirmados, erros, perdidos = int(resumo[1]), int(resumo[3]), int(resumo[4])
+        exibidos, crc, tamanho = (int(contadores[i]) for i in (1, 2, 3))
+        if erros or perdidos or crc or tamanho:
+            falhas.append(f"erros {erros}, perdidos {perdidos}, CRC {crc}, tamanho {tamanho}")
+
+        # Só os frames ainda sem confirmação (até a janela) podem faltar no stream.py
+        if not 0 <= exibidos - confirmados <= 8:
+            falhas.append(f"{exibidos} frames exibidos, {confirmados} confirmados")
+
+    for falha in falhas:
+        print(f"❌ {falha}")
+    return 1 if falhas else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
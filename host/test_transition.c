@@ -0,0 +1,53 @@
+#include "test.h"
+
+// A interpolação é estática: o teste compila transition.c junto, e as funções
+// públicas daqui tomam o lugar das da biblioteca na ligação
+#include "transition.c"
+
+// Teste exaustivo de lerp_word(): todos os pares de canal (0-255) em todos os pesos
+// (0-256) contra a conta por canal, com G, R e B diferentes na mesma palavra para
+// pegar vazamento entre as faixas
+
+/**
+ * Referência por canal: a + (b - a) * alpha / 256, arredondada para baixo
+ * @param a Canal de origem
+ * @param b Canal de destino
+ * @param alpha Peso do destino (0-256)
+ * @return Canal interpolado
+ */
+static uint32_t reference_lerp(int a, int b, int alpha) {
+    int delta = (b - a) * alpha;
+    return (uint32_t)(a + (delta >= 0 ? delta / 256 : -((-delta + 255) / 256)));
+}
+
+static uint32_t word(uint32_t g, uint32_t r, uint32_t b) {
+    return (g << 24) | (r << 16) | (b << 8);
+}
+
+int main(void) {
+    uint32_t failures = 0;
+
+    for (int a = 0; a < 256 && failures < 8; a++) {
+        for (int b = 0; b < 256 && failures < 8; b++) {
+            // O azul anda ao contrário e o vermelho deslocado: as três faixas diferem
+            uint32_t from = word((uint32_t)a, (uint32_t)(a ^ 0x5A), (uint32_t)(255 - a));
+            uint32_t to = word((uint32_t)b, (uint32_t)(b ^ 0x5A), (uint32_t)(255 - b));
+
+            for (int alpha = 0; alpha <= 256 && failures < 8; alpha++) {
+                uint32_t expected = word(reference_lerp(a, b, alpha), reference_lerp(a ^ 0x5A, b ^ 0x5A, alpha),
+                                         reference_lerp(255 - a, 255 - b, alpha));
+                uint32_t got = lerp_word(from, to, (uint32_t)alpha);
+                if (got != expected) {
+                    CHECK(false, "lerp(0x%08x, 0x%08x, %d) = 0x%08x, esperado 0x%08x", from, to, alpha, got, expected);
+                    failures++;
+                }
+            }
+        }
+    }
+
+    // Extremos exatos: 0 mantém a origem e 256 chega ao destino
+    CHECK(lerp_word(word(255, 0, 255), word(0, 255, 0), 0) == word(255, 0, 255), "peso 0 mudou a origem");
+    CHECK(lerp_word(word(255, 0, 255), word(0, 255, 0), 256) == word(0, 255, 0), "peso 256 não chegou ao destino");
+
+    return test_report();
+}
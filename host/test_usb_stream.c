@@ -0,0 +1,141 @@
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "test.h"
+#include "usb_stream.h"
+#include "framebuffer.h"
+#include "matrix_geometry.h"
+#include "mock_hw.h"
+
+// Teste da recepção de frames (usb_stream.c) com o stdio ligado a um socket: confirmação
+// de cada pacote e buffer de desenho intacto quando o CRC ou o tamanho não conferem
+
+static int host_fd;                        // Lado do "computador"
+static uint8_t packet[8 + USB_STREAM_FRAME_BYTES];
+static uint sent;                          // Bytes do pacote já escritos
+
+static uint16_t crc16(const uint8_t *data, uint size) {
+    uint16_t crc = 0xFFFF;
+    for (uint i = 0; i < size; i++) {
+        uint8_t x = (uint8_t)((crc >> 8) ^ data[i]);
+        x ^= x >> 4;
+        crc = (uint16_t)((crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x);
+    }
+    return crc;
+}
+
+/**
+ * Envia um pacote de frame, como o stream.py
+ * @param seq Número de sequência
+ * @param pixels NUM_LEDS pixels R,G,B
+ * @param length Tamanho declarado do payload
+ * @param corrupt Inverte um bit do payload depois do CRC
+ * @param count Bytes a escrever agora (o resto vai com send_rest())
+ */
+static void send_packet(uint8_t seq, const uint8_t *pixels, uint16_t length, bool corrupt, uint count) {
+    uint8_t *body = &packet[2];
+
+    packet[0] = USB_STREAM_SYNC0;
+    packet[1] = USB_STREAM_SYNC1;
+    body[0] = USB_STREAM_FRAME;
+    body[1] = seq;
+    body[2] = (uint8_t)length;
+    body[3] = (uint8_t)(length >> 8);
+    body[4] = 26;                          // Intensidade
+    body[5] = 0;
+    memcpy(&body[6], pixels, NUM_LEDS * 3);
+
+    // Com tamanho errado, a placa recusa no cabeçalho e o resto vira lixo ignorado
+    uint size = 4 + USB_STREAM_FRAME_BYTES;
+    uint16_t crc = crc16(body, size);
+    body[size] = (uint8_t)crc;
+    body[size + 1] = (uint8_t)(crc >> 8);
+    if (corrupt) body[6 + NUM_LEDS] ^= 0x10;
+
+    CHECK(write(host_fd, packet, count) == (ssize_t)count, "envio incompleto");
+    sent = count;
+}
+
+/**
+ * Escreve o resto do pacote
+ */
+static void send_rest(void) {
+    CHECK(write(host_fd, packet + sent, sizeof(packet) - sent) == (ssize_t)(sizeof(packet) - sent),
+          "envio incompleto");
+    sent = sizeof(packet);
+}
+
+/**
+ * Processa a recepção e lê a confirmação
+ * @param seq Sequência esperada
+ * @param status Resultado esperado
+ * @return true se algum frame foi exibido
+ */
+static bool poll_and_ack(uint8_t seq, UsbStreamStatus status) {
+    bool shown = false;
+    for (int i = 0; i < 8; i++) shown |= usb_stream_poll(pio0, 0);
+
+    uint8_t ack[8];
+    CHECK(read(host_fd, ack, sizeof(ack)) == (ssize_t)sizeof(ack), "sem confirmação do pacote %u", seq);
+    CHECK(ack[0] == 0xA5 && ack[1] == 0x5A && ack[2] == USB_STREAM_ACK && ack[3] == 2 && ack[4] == 0,
+          "cabeçalho da confirmação %u errado", seq);
+    CHECK(ack[5] == seq && ack[6] == status, "confirmação seq %u status %u, esperado %u/%u", ack[5], ack[6], seq,
+          status);
+    CHECK(ack[7] == (uint8_t)(ack[2] + ack[3] + ack[4] + ack[5] + ack[6]), "checksum da confirmação errado");
+    return shown;
+}
+
+int main(void) {
+    int fds[2];
+    CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, "socketpair");
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    host_fd = fds[1];
+    mock_stdio_attach(fds[0]);
+    matrix_geometry_init(NULL);
+
+    uint8_t frame[NUM_LEDS * 3];
+    for (uint i = 0; i < sizeof(frame); i++) frame[i] = (uint8_t)(i * 7 + 1);
+
+    // Desenho em andamento de outro modo
+    RGBColor8 drawing = {10, 20, 30};
+    framebuffer_fill(drawing);
+
+    // CRC inválido: descartado sem tocar no buffer de desenho
+    send_packet(1, frame, USB_STREAM_FRAME_BYTES, true, sizeof(packet));
+    CHECK(!poll_and_ack(1, USB_STREAM_BAD_CRC), "frame com CRC inválido exibido");
+    for (int i = 0; i < NUM_LEDS; i++) {
+        RGBColor8 pixel = framebuffer_back()[i];
+        if (pixel.r != drawing.r || pixel.g != drawing.g || pixel.b != drawing.b) {
+            CHECK(false, "pixel %d alterado pelo pacote com CRC inválido", i);
+            break;
+        }
+    }
+
+    // Tamanho de outra matriz
+    send_packet(2, frame, USB_STREAM_FRAME_BYTES + 3, false, sizeof(packet));
+    CHECK(!poll_and_ack(2, USB_STREAM_BAD_LENGTH), "frame com tamanho inválido exibido");
+
+    // Pacote íntegro logo depois, chegando em duas partes com um frame desenhado e enviado
+    // no meio: a recepção se ressincroniza e o buffer livre entra no lugar do de desenho
+    RGBColor8 *drawing_buffer = framebuffer_back();
+    send_packet(3, frame, USB_STREAM_FRAME_BYTES, false, 8 + NUM_LEDS);
+    CHECK(!usb_stream_poll(pio0, 0), "frame exibido pela metade");
+    framebuffer_fill((RGBColor8){1, 2, 3});
+    CHECK(framebuffer_commit(pio0, 0, 256), "commit com o buffer livre emprestado não enviou");
+    send_rest();
+    CHECK(poll_and_ack(3, USB_STREAM_OK), "frame válido não exibido");
+    CHECK(memcmp(framebuffer_back(), frame, sizeof(frame)) == 0, "buffer de desenho diferente do payload");
+    CHECK(framebuffer_back() != drawing_buffer, "payload copiado em vez de trocado");
+
+    // Depois da troca o front volta a valer: sem mudança, nada é reenviado
+    CHECK(!framebuffer_commit(pio0, 0, 26), "frame recebido reenviado sem mudança");
+
+    const UsbStreamStats *stats = usb_stream_get_stats();
+    CHECK(stats->frames == 1 && stats->crc_errors == 1 && stats->length_errors == 1,
+          "contadores %u frames, %u CRC, %u tamanho", stats->frames, stats->crc_errors, stats->length_errors);
+
+    mock_stdio_attach(-1);
+    return test_report();
+}
@@ -0,0 +1,195 @@
+#include <string.h>
+#include "indexed_framebuffer.h"
+
+// === BUFFERS ===
+static uint8_t pixels[INDEXED_BYTES];          // Índices em ordem lógica
+static RGBColor8 palette[INDEXED_COLORS];      // Paleta atual
+static const RGBColor8 *fade_target = NULL;    // Paleta de destino da mistura (NULL = sem mistura)
+static uint16_t fade_mix = 0;                  // Proporção do destino (0-256)
+static int32_t sent_intensity = -1;            // Intensidade do último envio (-1 = nada enviado)
+static bool dirty = true;                      // Pixels ou paleta mudaram desde o último commit
+
+/**
+ * Escreve um índice, marcando sujo só quando o valor muda
+ * @param position Índice lógico
+ * @param index Índice da paleta
+ */
+static inline void write_index(int position, uint8_t index) {
+#if INDEXED_BITS == 8
+    if (pixels[position] != index) {
+        pixels[position] = index;
+        dirty = true;
+    }
+#else
+    uint8_t *byte = &pixels[position >> 1];
+    uint8_t shift = (position & 1) << 2;
+    uint8_t value = (*byte & ~(0x0F << shift)) | ((index & 0x0F) << shift);
+
+    if (*byte != value) {
+        *byte = value;
+        dirty = true;
+    }
+#endif
+}
+
+/**
+ * Escreve um pixel por coordenada
+ * @param x Coluna
+ * @param y Linha
+ * @param index Índice da paleta
+ */
+void indexed_framebuffer_set_pixel(int x, int y, uint8_t index) {
+    if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT) return;
+    write_index(y * MATRIX_WIDTH + x, index);
+}
+
+/**
+ * Lê um pixel por coordenada
+ * @param x Coluna
+ * @param y Linha
+ * @return Índice da paleta
+ */
+uint8_t indexed_framebuffer_get_pixel(int x, int y) {
+    if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT) return 0;
+
+    int position = y * MATRIX_WIDTH + x;
+#if INDEXED_BITS == 8
+    return pixels[position];
+#else
+    return (pixels[position >> 1] >> ((position & 1) << 2)) & 0x0F;
+#endif
+}
+
+/**
+ * Preenche todos os pixels
+ * @param index Índice da paleta
+ */
+void indexed_framebuffer_fill(uint8_t index) {
+    // Byte inteiro de uma vez: com 4 bits, dois pixels por byte
+    uint8_t value = INDEXED_BITS == 8 ? index : (uint8_t)((index & 0x0F) * 0x11);
+
+    for (int i = 0; i < INDEXED_BYTES; i++) {
+        if (pixels[i] != value) {
+            pixels[i] = value;
+            dirty = true;
+        }
+    }
+}
+
+/**
+ * Define uma cor da paleta
+ * @param index Entrada
+ * @param color Cor
+ */
+void indexed_framebuffer_set_color(uint8_t index, RGBColor8 color) {
+    if (index >= INDEXED_COLORS) return;
+
+    RGBColor8 *entry = &palette[index];
+    if (entry->r != color.r || entry->g != color.g || entry->b != color.b) {
+        *entry = color;
+        dirty = true;
+    }
+}
+
+/**
+ * Copia uma paleta a partir da entrada 0
+ * @param colors Cores
+ * @param count Quantidade
+ */
+void indexed_framebuffer_load_palette(const RGBColor8 *colors, uint count) {
+    if (count > INDEXED_COLORS) count = INDEXED_COLORS;
+    memcpy(palette, colors, count * sizeof(RGBColor8));
+    dirty = true;
+}
+
+/**
+ * Gira uma faixa da paleta
+ * @param first Primeira entrada
+ * @param count Entradas na faixa
+ * @param step Posições a girar
+ */
+void indexed_framebuffer_rotate_palette(uint8_t first, uint count, int step) {
+    if (first + count > INDEXED_COLORS) count = INDEXED_COLORS - first;
+    if (count < 2) return;
+
+    // Normaliza o passo para 0..count-1
+    int shift = step % (int)count;
+    if (shift < 0) shift += count;
+    if (shift == 0) return;
+
+    RGBColor8 rotated[INDEXED_COLORS];
+    for (uint i = 0; i < count; i++) {
+        rotated[i] = palette[first + (i + shift) % count];
+    }
+    memcpy(&palette[first], rotated, count * sizeof(RGBColor8));
+    dirty = true;
+}
+
+/**
+ * Define a mistura com outra paleta
+ * @param target Paleta de destino (NULL cancela)
+ * @param mix Proporção do destino (0-256)
+ */
+void indexed_framebuffer_crossfade(const RGBColor8 *target, uint16_t mix) {
+    // Mistura completa: o destino vira a paleta atual
+    if (target && mix >= INTENSITY_FIXED_MAX) {
+        memcpy(palette, target, sizeof(palette));
+        target = NULL;
+    }
+
+    if (target != fade_target || (target && mix != fade_mix)) dirty = true;
+    fade_target = target;
+    fade_mix = target ? mix : 0;
+}
+
+/**
+ * Acesso direto aos pixels
+ * @return Pixels compactados
+ */
+uint8_t *indexed_framebuffer_pixels(void) {
+    return pixels;
+}
+
+/**
+ * Marca os pixels como alterados
+ */
+void indexed_framebuffer_mark_dirty(void) {
+    dirty = true;
+}
+
+/**
+ * Força o reenvio no próximo commit
+ */
+void indexed_framebuffer_invalidate(void) {
+    sent_intensity = -1;
+    dirty = true;
+}
+
+/**
+ * Envia o frame se algo mudou
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param intensity Intensidade em ponto fixo
+ * @return true se enviou
+ */
+bool indexed_framebuffer_commit(PIO pio, uint sm, uint16_t intensity) {
+    if (!dirty && sent_intensity == intensity) return false;
+    dirty = false;
+
+    // Mistura resolvida por entrada da paleta: 16 ou 256 interpolações, nunca por pixel
+    const RGBColor8 *resolved = palette;
+    RGBColor8 mixed[INDEXED_COLORS];
+    if (fade_target) {
+        for (int i = 0; i < INDEXED_COLORS; i++) {
+            mixed[i].r = palette[i].r + (((fade_target[i].r - palette[i].r) * fade_mix) >> 8);
+            mixed[i].g = palette[i].g + (((fade_target[i].g - palette[i].g) * fade_mix) >> 8);
+            mixed[i].b = palette[i].b + (((fade_target[i].b - palette[i].b) * fade_mix) >> 8);
+        }
+        resolved = mixed;
+    }
+
+    display_indexed_fixed(pixels, INDEXED_BITS, resolved, pio, sm, intensity);
+
+    sent_intensity = intensity;
+    return true;
+}
@@ -0,0 +1,108 @@
+#ifndef INDEXED_FRAMEBUFFER_H
+#define INDEXED_FRAMEBUFFER_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "led_functions.h"
+
+/**
+ * Framebuffer indexado: cada pixel guarda só o índice de uma paleta, que é
+ * resolvida na conversão para as palavras do fio (display_indexed_fixed()).
+ * - 4 bits por pixel: 16 cores, NUM_LEDS / 2 bytes (6x menor que RGB)
+ * - 8 bits por pixel: 256 cores, NUM_LEDS bytes (3x menor que RGB)
+ * Trocar, girar ou misturar a paleta anima a matriz inteira sem tocar nos pixels.
+ * Como framebuffer.h, o commit só envia quando pixels, paleta ou intensidade mudaram.
+ */
+
+#ifndef INDEXED_BITS
+#define INDEXED_BITS 4                   // Bits por pixel: 4 ou 8
+#endif
+
+#if INDEXED_BITS != 4 && INDEXED_BITS != 8
+#error "INDEXED_BITS deve ser 4 ou 8"
+#endif
+
+#define INDEXED_COLORS (1 << INDEXED_BITS)                        // Entradas da paleta
+#define INDEXED_BYTES ((NUM_LEDS * INDEXED_BITS + 7) / 8)         // Tamanho dos pixels em bytes
+
+/**
+ * Escreve o índice de um pixel.
+ * @param x Coluna (0 a MATRIX_WIDTH - 1)
+ * @param y Linha (0 a MATRIX_HEIGHT - 1)
+ * @param index Índice da paleta (0 a INDEXED_COLORS - 1)
+ */
+extern void indexed_framebuffer_set_pixel(int x, int y, uint8_t index);
+
+/**
+ * Lê o índice de um pixel.
+ * @param x Coluna (0 a MATRIX_WIDTH - 1)
+ * @param y Linha (0 a MATRIX_HEIGHT - 1)
+ * @return Índice da paleta (0 fora dos limites)
+ */
+extern uint8_t indexed_framebuffer_get_pixel(int x, int y);
+
+/**
+ * Preenche todos os pixels com um índice.
+ * @param index Índice da paleta
+ */
+extern void indexed_framebuffer_fill(uint8_t index);
+
+/**
+ * Define uma cor da paleta.
+ * @param index Entrada da paleta
+ * @param color Nova cor
+ */
+extern void indexed_framebuffer_set_color(uint8_t index, RGBColor8 color);
+
+/**
+ * Copia uma paleta inteira ou parcial a partir da entrada 0.
+ * @param colors Cores
+ * @param count Quantidade (até INDEXED_COLORS)
+ */
+extern void indexed_framebuffer_load_palette(const RGBColor8 *colors, uint count);
+
+/**
+ * Gira as cores de uma faixa da paleta (ciclo de cores). Custa count cópias,
+ * independente do tamanho da matriz.
+ * @param first Primeira entrada da faixa
+ * @param count Entradas na faixa
+ * @param step Posições a girar (positivo: cada entrada recebe a cor da seguinte)
+ */
+extern void indexed_framebuffer_rotate_palette(uint8_t first, uint count, int step);
+
+/**
+ * Mistura a paleta atual com outra no próximo commit, sem alterar a atual.
+ * Com mix em INTENSITY_FIXED_MAX, a paleta de destino passa a ser a atual.
+ * @param target Paleta de destino (INDEXED_COLORS entradas; NULL cancela a mistura)
+ * @param mix Proporção do destino em ponto fixo (0 a 256)
+ */
+extern void indexed_framebuffer_crossfade(const RGBColor8 *target, uint16_t mix);
+
+/**
+ * Acesso direto aos pixels compactados (INDEXED_BYTES bytes, ordem lógica,
+ * nibble baixo primeiro com 4 bits). Quem escreve por aqui deve chamar
+ * indexed_framebuffer_mark_dirty().
+ * @return Ponteiro para os pixels
+ */
+extern uint8_t *indexed_framebuffer_pixels(void);
+
+/**
+ * Marca os pixels como alterados.
+ */
+extern void indexed_framebuffer_mark_dirty(void);
+
+/**
+ * Força o reenvio no próximo commit (outra rotina escreveu nos LEDs).
+ */
+extern void indexed_framebuffer_invalidate(void);
+
+/**
+ * Envia o frame se pixels, paleta ou intensidade mudaram desde o último commit.
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ * @return true se um frame foi enviado
+ */
+extern bool indexed_framebuffer_commit(PIO pio, uint sm, uint16_t intensity);
+
+#endif
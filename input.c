@@ -0,0 +1,289 @@
+#include "hardware/sync.h"
+#include "input.h"
+
+#define INPUT_QUEUE_MASK (INPUT_QUEUE_SIZE - 1)
+#define INPUT_EVENT_MASK (INPUT_EVENT_QUEUE_SIZE - 1)
+
+#if INPUT_QUEUE_SIZE & INPUT_QUEUE_MASK || INPUT_EVENT_QUEUE_SIZE & INPUT_EVENT_MASK
+#error "INPUT_QUEUE_SIZE e INPUT_EVENT_QUEUE_SIZE devem ser potências de 2"
+#endif
+
+typedef struct {
+    uint32_t time_us;                    // Instante da borda (carimbado na interrupção)
+    uint8_t button;                      // Índice do botão
+    bool pressed;                        // Nível depois da borda
+} InputEdge;
+
+typedef struct {
+    bool raw;                            // Último nível visto, inclusive durante o bloqueio
+    bool pressed;                        // Nível sem ruído
+    bool long_sent;                      // Toque longo já entregue neste toque
+    uint8_t clicks;                      // Cliques aguardando a janela do duplo clique
+    uint32_t edge_us;                    // Última troca aceita (início do bloqueio)
+    uint32_t press_us;                   // Instante do toque atual
+    uint32_t release_us;                 // Instante da última soltura (início da janela)
+} ButtonState;
+
+// === ANEL DE BORDAS (interrupção escreve head, laço principal escreve tail) ===
+static InputEdge edges[INPUT_QUEUE_SIZE];
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+static volatile uint32_t dropped = 0;
+
+// === ESTADO DO LAÇO PRINCIPAL ===
+static uint button_gpio[INPUT_MAX_BUTTONS];
+static int button_count = 0;
+static ButtonState buttons[INPUT_MAX_BUTTONS];
+static InputEvent pending[INPUT_EVENT_QUEUE_SIZE];
+static uint32_t event_head = 0, event_tail = 0;
+static alarm_id_t alarm_id = 0;          // Alarme do próximo prazo de gesto
+
+/**
+ * Compara instantes de 32 bits sem problema com a volta do contador (~71 min)
+ * @param time_us Instante
+ * @param limit_us Limite
+ * @return true se time_us já alcançou limit_us
+ */
+static inline bool deadline_passed(uint32_t time_us, uint32_t limit_us) {
+    return (int32_t)(time_us - limit_us) >= 0;
+}
+
+/**
+ * Enfileira um evento reconhecido; com a fila cheia o mais antigo é descartado
+ */
+static void input_emit(InputEventType type, uint8_t button, uint32_t time_us) {
+    if (event_head - event_tail >= INPUT_EVENT_QUEUE_SIZE) event_tail++;
+    pending[event_head++ & INPUT_EVENT_MASK] = (InputEvent){type, button, time_us};
+}
+
+/**
+ * Aplica uma troca de nível já sem ruído e reconhece os gestos que ela fecha
+ * @param index Botão
+ * @param pressed Novo nível
+ * @param time_us Instante da troca
+ */
+static void button_change(uint8_t index, bool pressed, uint32_t time_us) {
+    ButtonState *b = &buttons[index];
+
+    b->pressed = pressed;
+    b->edge_us = time_us;
+
+    if (pressed) {
+        // Toque sai na hora; clique, duplo e longo são decididos depois
+        b->press_us = time_us;
+        b->long_sent = false;
+        if (b->clicks == 1) b->clicks = 2;
+        input_emit(INPUT_PRESS, index, time_us);
+    } else if (b->long_sent) {
+        b->clicks = 0;
+    } else if (b->clicks == 2) {
+        b->clicks = 0;
+        input_emit(INPUT_DOUBLE_CLICK, index, time_us);
+    } else {
+        // Primeiro clique: espera a janela para saber se vem o segundo
+        b->clicks = 1;
+        b->release_us = time_us;
+    }
+}
+
+/**
+ * Processa os prazos de um botão vencidos até time_us, na ordem em que venceram
+ * @param index Botão
+ * @param time_us Instante
+ */
+static void button_advance(uint8_t index, uint32_t time_us) {
+    ButtonState *b = &buttons[index];
+
+    // Fim do bloqueio com o nível diferente: a última borda do ruído vale agora
+    uint32_t unlock_us = b->edge_us + INPUT_DEBOUNCE_US;
+    if (b->raw != b->pressed && deadline_passed(time_us, unlock_us)) {
+        if (b->pressed && !b->long_sent && deadline_passed(unlock_us, b->press_us + INPUT_LONG_PRESS_US)) {
+            b->long_sent = true;
+            b->clicks = 0;
+            input_emit(INPUT_LONG_PRESS, index, b->press_us + INPUT_LONG_PRESS_US);
+        }
+        button_change(index, b->raw, unlock_us);
+    }
+
+    if (b->pressed && !b->long_sent && deadline_passed(time_us, b->press_us + INPUT_LONG_PRESS_US)) {
+        b->long_sent = true;
+        b->clicks = 0;
+        input_emit(INPUT_LONG_PRESS, index, b->press_us + INPUT_LONG_PRESS_US);
+    }
+
+    if (!b->pressed && b->clicks == 1 && deadline_passed(time_us, b->release_us + INPUT_DOUBLE_CLICK_US)) {
+        b->clicks = 0;
+        input_emit(INPUT_CLICK, index, b->release_us + INPUT_DOUBLE_CLICK_US);
+    }
+}
+
+/**
+ * Debounce de uma borda: vale na hora se o botão não estiver bloqueado
+ * @param edge Borda do anel
+ */
+static void button_edge(const InputEdge *edge) {
+    ButtonState *b = &buttons[edge->button];
+
+    button_advance(edge->button, edge->time_us);
+    b->raw = edge->pressed;
+
+    if (edge->pressed == b->pressed || !deadline_passed(edge->time_us, b->edge_us + INPUT_DEBOUNCE_US)) return;
+    button_change(edge->button, edge->pressed, edge->time_us);
+}
+
+/**
+ * Callback do alarme: apenas acorda o laço principal para entregar o gesto
+ */
+static int64_t input_alarm_callback(alarm_id_t id, void *user_data) {
+    alarm_id = 0;
+    __sev();
+    return 0;
+}
+
+/**
+ * Agenda o alarme para o próximo prazo pendente (ou cancela se não houver)
+ * @param now_us Instante atual
+ */
+static void input_arm(uint32_t now_us) {
+    uint32_t deadline_us;
+
+    if (alarm_id > 0) {
+        cancel_alarm(alarm_id);
+        alarm_id = 0;
+    }
+    if (!input_next_deadline(&deadline_us)) return;
+
+    int32_t delay_us = (int32_t)(deadline_us - now_us);
+    if (delay_us < 0) delay_us = 0;
+    alarm_id = add_alarm_at(from_us_since_boot(time_us_64() + (uint32_t)delay_us), input_alarm_callback, NULL, true);
+}
+
+/**
+ * Registra os botões e liga as interrupções
+ * @param gpios GPIOs dos botões
+ * @param count Quantidade
+ */
+void input_init(const uint *gpios, int count) {
+    if (count > INPUT_MAX_BUTTONS) count = INPUT_MAX_BUTTONS;
+
+    head = tail = dropped = 0;
+    event_head = event_tail = 0;
+    button_count = count;
+
+    for (int i = 0; i < count; i++) {
+        button_gpio[i] = gpios[i];
+        buttons[i] = (ButtonState){0};
+        buttons[i].edge_us = time_us_32() - INPUT_DEBOUNCE_US;
+
+        gpio_init(gpios[i]);
+        gpio_set_dir(gpios[i], GPIO_IN);
+        gpio_pull_up(gpios[i]);
+        gpio_set_irq_enabled_with_callback(gpios[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true,
+                                           &input_gpio_callback);
+    }
+}
+
+/**
+ * Interrupção dos botões
+ * @param gpio GPIO
+ * @param events Bordas
+ */
+void input_gpio_callback(uint gpio, uint32_t events) {
+    uint32_t now_us = time_us_32();
+
+    for (int i = 0; i < button_count; i++) {
+        if (button_gpio[i] != gpio) continue;
+
+        // Ativo em nível baixo: descida pressiona, subida solta. As duas juntas
+        // (ruído mais rápido que a interrupção): vale o nível atual do pino
+        bool fall = events & GPIO_IRQ_EDGE_FALL, rise = events & GPIO_IRQ_EDGE_RISE;
+        bool pressed = (fall && rise) ? !gpio_get(gpio) : fall;
+        input_push_edge((uint8_t)i, pressed, now_us);
+        return;
+    }
+}
+
+/**
+ * Coloca uma borda no anel
+ * @param button Botão
+ * @param pressed Nível
+ * @param time_us Instante
+ */
+void input_push_edge(uint8_t button, bool pressed, uint32_t time_us) {
+    if (head - tail >= INPUT_QUEUE_SIZE) {
+        dropped = dropped + 1;
+        return;
+    }
+
+    edges[head & INPUT_QUEUE_MASK] = (InputEdge){time_us, button, pressed};
+
+    // Conteúdo visível antes do novo head; acorda o laço principal
+    __dmb();
+    head = head + 1;
+    __sev();
+}
+
+/**
+ * Processa bordas e prazos e entrega um evento
+ * @param now_us Instante atual
+ * @param event Saída
+ * @return true se havia evento
+ */
+bool input_poll(uint32_t now_us, InputEvent *event) {
+    if (event_tail == event_head) {
+        // Bordas em ordem de chegada; cada uma vence antes os prazos anteriores a ela
+        while (tail != head) {
+            __dmb();
+            InputEdge edge = edges[tail & INPUT_QUEUE_MASK];
+            __dmb();
+            tail = tail + 1;
+
+            if (edge.button < button_count) button_edge(&edge);
+        }
+
+        for (int i = 0; i < button_count; i++) {
+            button_advance((uint8_t)i, now_us);
+        }
+        input_arm(now_us);
+    }
+
+    if (event_tail == event_head) return false;
+    *event = pending[event_tail++ & INPUT_EVENT_MASK];
+    return true;
+}
+
+/**
+ * Próximo prazo pendente
+ * @param deadline_us Saída
+ * @return true se há prazo
+ */
+bool input_next_deadline(uint32_t *deadline_us) {
+    bool found = false;
+
+    for (int i = 0; i < button_count; i++) {
+        const ButtonState *b = &buttons[i];
+        uint32_t t;
+
+        if (b->raw != b->pressed) {
+            t = b->edge_us + INPUT_DEBOUNCE_US;
+        } else if (b->pressed && !b->long_sent) {
+            t = b->press_us + INPUT_LONG_PRESS_US;
+        } else if (!b->pressed && b->clicks == 1) {
+            t = b->release_us + INPUT_DOUBLE_CLICK_US;
+        } else {
+            continue;
+        }
+
+        if (!found || !deadline_passed(t, *deadline_us)) *deadline_us = t;
+        found = true;
+    }
+    return found;
+}
+
+/**
+ * Bordas perdidas por anel cheio
+ * @return Contador
+ */
+uint32_t input_dropped(void) {
+    return dropped;
+}
@@ -0,0 +1,93 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "pico/stdlib.h"
+
+/**
+ * Entrada dos botões em duas metades:
+ * - na interrupção, só o instante e o nível de cada borda vão para um anel SPSC
+ *   sem locks (a interrupção só escreve head, o laço principal só escreve tail);
+ * - no laço principal, input_poll() tira o ruído (debounce) e reconhece os gestos:
+ *   toque (imediato), clique, duplo clique e toque longo.
+ * O debounce é pela primeira borda: ela vale na hora e as seguintes ficam bloqueadas
+ * por INPUT_DEBOUNCE_US; se no fim do bloqueio o nível for outro, a troca vale ali.
+ * Gestos que dependem só do tempo (toque longo, fim da janela do duplo clique)
+ * armam um alarme, então saem no instante certo mesmo sem animação em andamento.
+ */
+
+#define INPUT_MAX_BUTTONS 4              // Botões registrados em input_init()
+#define INPUT_QUEUE_SIZE 32              // Bordas no anel (potência de 2)
+#define INPUT_EVENT_QUEUE_SIZE 8         // Eventos reconhecidos aguardando input_poll() (potência de 2)
+
+#ifndef INPUT_DEBOUNCE_US
+#define INPUT_DEBOUNCE_US 20000          // Bloqueio depois de cada borda aceita
+#endif
+
+#ifndef INPUT_LONG_PRESS_US
+#define INPUT_LONG_PRESS_US 800000       // Tempo pressionado para um toque longo
+#endif
+
+#ifndef INPUT_DOUBLE_CLICK_US
+#define INPUT_DOUBLE_CLICK_US 300000     // Janela entre soltar e pressionar de novo para o duplo clique
+#endif
+
+typedef enum {
+    INPUT_PRESS,                         // Botão pressionado (sem esperar gesto: menor latência)
+    INPUT_CLICK,                         // Solto antes do toque longo, sem segundo toque na janela
+    INPUT_DOUBLE_CLICK,                  // Dois cliques seguidos
+    INPUT_LONG_PRESS,                    // Mantido por INPUT_LONG_PRESS_US
+    INPUT_EVENT_TYPES
+} InputEventType;
+
+typedef struct {
+    InputEventType type;                 // Gesto
+    uint8_t button;                      // Índice do botão em input_init()
+    uint32_t time_us;                    // Instante em que o gesto aconteceu (borda ou prazo)
+} InputEvent;
+
+/**
+ * Registra os botões (ativos em nível baixo, com pull-up) e liga as
+ * interrupções das duas bordas. Esvazia o anel e os estados.
+ * @param gpios GPIO de cada botão (o índice vira InputEvent.button)
+ * @param count Quantidade de botões (até INPUT_MAX_BUTTONS)
+ */
+extern void input_init(const uint *gpios, int count);
+
+/**
+ * Callback de interrupção dos GPIOs: carimba a borda e a coloca no anel.
+ * @param gpio GPIO que gerou a interrupção
+ * @param events Bordas (GPIO_IRQ_EDGE_FALL / GPIO_IRQ_EDGE_RISE)
+ */
+extern void input_gpio_callback(uint gpio, uint32_t events);
+
+/**
+ * Coloca uma borda no anel (chamada pela interrupção; no host, gera linhas do tempo sintéticas).
+ * @param button Índice do botão
+ * @param pressed true se o botão ficou pressionado
+ * @param time_us Instante da borda (time_us_32())
+ */
+extern void input_push_edge(uint8_t button, bool pressed, uint32_t time_us);
+
+/**
+ * Processa as bordas pendentes e os prazos vencidos até now_us e entrega um evento.
+ * Chamar no laço principal até retornar false.
+ * @param now_us Instante atual (time_us_32())
+ * @param event Evento entregue
+ * @return true se havia evento
+ */
+extern bool input_poll(uint32_t now_us, InputEvent *event);
+
+/**
+ * Próximo prazo de um gesto pendente (toque longo, janela do duplo clique ou fim do bloqueio).
+ * @param deadline_us Saída com o instante
+ * @return false se não há prazo pendente
+ */
+extern bool input_next_deadline(uint32_t *deadline_us);
+
+/**
+ * Bordas perdidas por anel cheio.
+ * @return Contador
+ */
+extern uint32_t input_dropped(void);
+
+#endif
@@ -0,0 +1,165 @@
+#include "led_dma.h"
+
+// === ESTADO DO CANAL DMA ===
+static uint32_t buffers[2][LED_DMA_MAX_WORDS];  // Buffer duplo de palavras G|R|B
+static uint back_index = 0;                     // Buffer livre para montar o próximo frame
+static int channel = -1;                        // Canal DMA reivindicado
+static PIO dma_pio;                             // PIO alimentado pelo DMA
+static uint dma_sm;                             // State machine alimentado pelo DMA
+static volatile bool busy = false;              // Transferência em andamento
+static volatile uint64_t last_done_us = 0;      // Instante em que o DMA terminou de escrever no FIFO
+static led_dma_callback_t done_callback = NULL; // Callback de conclusão
+static void *done_user_data = NULL;             // Dados do callback
+
+/**
+ * Tratador da interrupção DMA_IRQ_0 (compartilhada)
+ * Marca o fim da transferência e chama o callback do usuário
+ */
+static void led_dma_irq_handler(void) {
+    if (channel < 0 || !dma_channel_get_irq0_status(channel)) return;
+
+    dma_channel_acknowledge_irq0(channel);
+    last_done_us = time_us_64();
+    busy = false;
+
+    if (done_callback) {
+        done_callback(done_user_data);
+    }
+}
+
+/**
+ * Configura um canal DMA para escrever no TX FIFO do state machine
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @return true em caso de sucesso
+ */
+bool led_dma_init(PIO pio, uint sm) {
+    // Reinicialização (matrix_init chamada de novo): não reivindica outro canal nem
+    // registra o tratador duas vezes
+    if (led_dma_is_attached(pio, sm)) return true;
+    led_dma_deinit();
+
+    channel = dma_claim_unused_channel(false);
+    if (channel < 0) return false;
+
+    dma_pio = pio;
+    dma_sm = sm;
+
+    // Palavras de 32 bits, lendo do buffer em sequência e escrevendo sempre no FIFO
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+
+    // O DREQ do TX FIFO dita o ritmo: o DMA só escreve quando há espaço
+    channel_config_set_dreq(&config, pio_get_dreq(pio, sm, true));
+
+    dma_channel_configure(channel, &config, &pio->txf[sm], buffers[0], 0, false);
+
+    // Interrupção de conclusão compartilhada, para conviver com outros usuários do DMA
+    dma_channel_set_irq0_enabled(channel, true);
+    irq_add_shared_handler(DMA_IRQ_0, led_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    return true;
+}
+
+/**
+ * Devolve o canal DMA e remove o tratador da interrupção
+ */
+void led_dma_deinit(void) {
+    if (channel < 0) return;
+
+    // O frame em andamento termina antes de o canal ser devolvido
+    led_dma_wait();
+
+    dma_channel_set_irq0_enabled(channel, false);
+    irq_remove_handler(DMA_IRQ_0, led_dma_irq_handler);
+    dma_channel_unclaim(channel);
+    channel = -1;
+}
+
+/**
+ * Verifica se o DMA está ligado a este PIO/SM
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @return true se configurado
+ */
+bool led_dma_is_attached(PIO pio, uint sm) {
+    return channel >= 0 && dma_pio == pio && dma_sm == sm;
+}
+
+/**
+ * Retorna o buffer onde o próximo frame deve ser escrito
+ * @return Ponteiro para o buffer livre
+ */
+uint32_t *led_dma_get_back_buffer(void) {
+    return buffers[back_index];
+}
+
+/**
+ * Retorna o último frame enviado
+ * @return Ponteiro para o buffer enviado por último
+ */
+const uint32_t *led_dma_get_front_buffer(void) {
+    return buffers[back_index ^ 1];
+}
+
+/**
+ * Indica se o DMA ainda está transferindo
+ * @return true se ocupado
+ */
+bool led_dma_is_busy(void) {
+    return busy;
+}
+
+/**
+ * Aguarda o fim da transferência, o esvaziamento do FIFO e o latch dos LEDs
+ */
+void led_dma_wait(void) {
+    if (channel < 0) return;
+
+    // Espera o DMA terminar de alimentar o FIFO
+    while (busy) {
+        tight_loop_contents();
+    }
+
+    // Se já passou tempo suficiente desde o fim do DMA, o latch certamente ocorreu
+    if (time_us_64() - last_done_us >= LED_DMA_IDLE_US) return;
+
+    // Espera as últimas palavras saírem do FIFO
+    while (!pio_sm_is_tx_fifo_empty(dma_pio, dma_sm)) {
+        tight_loop_contents();
+    }
+
+    // Mantém a linha em nível baixo pelo tempo de reset (inclui a última palavra no registrador de saída)
+    sleep_us(LED_DMA_LATCH_US);
+}
+
+/**
+ * Dispara o envio do buffer livre e troca os buffers
+ * @param count Quantidade de palavras a enviar
+ */
+void led_dma_submit(uint count) {
+    if (channel < 0) return;
+    if (count > LED_DMA_MAX_WORDS) count = LED_DMA_MAX_WORDS;
+
+    // Garante que o frame anterior já foi travado pelos LEDs
+    led_dma_wait();
+
+    busy = true;
+    dma_channel_transfer_from_buffer_now(channel, buffers[back_index], count);
+
+    // O outro buffer já terminou de ser enviado e pode ser reescrito
+    back_index ^= 1;
+}
+
+/**
+ * Registra o callback de conclusão
+ * @param callback Função chamada ao fim da transferência
+ * @param user_data Ponteiro repassado ao callback
+ */
+void led_dma_set_callback(led_dma_callback_t callback, void *user_data) {
+    done_callback = callback;
+    done_user_data = user_data;
+}
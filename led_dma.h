@@ -0,0 +1,112 @@
+#ifndef LED_DMA_H
+#define LED_DMA_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "matrix_config.h"
+
+#define LED_DMA_MAX_WORDS NUM_LEDS       // Tamanho máximo de um frame em palavras de 24 bits (um LED por palavra)
+
+// Perfil dos LEDs: 0 para WS2812B e SK6812 (programa ws2812, 842 kHz, reset de 80 µs),
+// 1 para WS2812B-V5 (programa ws2812_v5, 800 kHz, reset de 280 µs; também atende o SK6812)
+#ifndef LED_CHIP_V5
+#define LED_CHIP_V5 0
+#endif
+
+#if LED_CHIP_V5
+#define LED_PROGRAM ws2812_v5_program    // Programa de main.pio usado pela matriz e pelas fitas múltiplas
+#define LED_PROGRAM_PREPARE ws2812_v5_program_prepare
+#define LED_PROGRAM_INIT ws2812_v5_program_init
+#define LED_WORD_US 30                   // Uma palavra (24 bits) no fio com o programa ws2812_v5 (800 kHz)
+#ifndef LED_RESET_US
+#define LED_RESET_US 280                 // Reset mínimo do WS2812B-V5
+#endif
+#else
+#define LED_PROGRAM ws2812_program
+#define LED_PROGRAM_PREPARE ws2812_program_prepare
+#define LED_PROGRAM_INIT ws2812_program_init
+#define LED_WORD_US 29                   // Uma palavra (24 bits) no fio com o programa ws2812 (842 kHz)
+#ifndef LED_RESET_US
+#define LED_RESET_US 80                  // Reset mínimo dos LEDs: 50 (WS2812B), 80 (SK6812)
+#endif
+#endif
+
+// Tempo em nível baixo para travar o frame. Conta a partir do FIFO vazio, quando a
+// última palavra ainda está saindo do OSR (valor conferido com pio_sim.py)
+#define LED_DMA_LATCH_US (LED_RESET_US + LED_WORD_US + 1)
+#define LED_DMA_IDLE_US 1000             // Após esse tempo sem transferência o latch já ocorreu com certeza
+
+/**
+ * Callback chamado ao fim de cada transferência DMA.
+ * ATENÇÃO: executa em contexto de interrupção (DMA_IRQ_0), deve ser curto.
+ * @param user_data Ponteiro registrado em led_dma_set_callback()
+ */
+typedef void (*led_dma_callback_t)(void *user_data);
+
+/**
+ * Reivindica um canal DMA e o configura para alimentar o TX FIFO do state machine,
+ * com ritmo dado pelo DREQ do próprio PIO. Se já estiver ligado a esse PIO/SM, nada
+ * muda; ligado a outro, o canal anterior é devolvido antes (led_dma_deinit()).
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @return true se o canal foi configurado, false se não há canal livre
+ */
+extern bool led_dma_init(PIO pio, uint sm);
+
+/**
+ * Espera o frame em andamento, remove o tratador de DMA_IRQ_0 e devolve o canal.
+ * Sem canal configurado, não faz nada.
+ */
+extern void led_dma_deinit(void);
+
+/**
+ * Indica se o caminho DMA está configurado para o par PIO/SM informado.
+ * @param pio Instância do PIO
+ * @param sm State machine
+ * @return true se led_dma_init() foi chamado com esses parâmetros
+ */
+extern bool led_dma_is_attached(PIO pio, uint sm);
+
+/**
+ * Retorna o buffer livre, onde o próximo frame deve ser montado.
+ * O buffer nunca é o que está sendo transmitido no momento.
+ * @return Ponteiro para LED_DMA_MAX_WORDS palavras no formato G|R|B
+ */
+extern uint32_t *led_dma_get_back_buffer(void);
+
+/**
+ * Retorna o último frame enviado (o buffer que não é o livre).
+ * Válido até o próximo led_dma_submit().
+ * @return Ponteiro para LED_DMA_MAX_WORDS palavras no formato G|R|B
+ */
+extern const uint32_t *led_dma_get_front_buffer(void);
+
+/**
+ * Envia o buffer livre por DMA e troca os buffers.
+ * Aguarda o frame anterior terminar (incluindo o latch) antes de disparar.
+ * Retorna logo em seguida, liberando a CPU durante a transferência.
+ * @param count Quantidade de palavras a enviar (normalmente NUM_LEDS)
+ */
+extern void led_dma_submit(uint count);
+
+/**
+ * Indica se há uma transferência em andamento.
+ * @return true enquanto o DMA ainda está alimentando o FIFO
+ */
+extern bool led_dma_is_busy(void);
+
+/**
+ * Bloqueia até o frame atual sair pelo fio e o tempo de latch passar.
+ */
+extern void led_dma_wait(void);
+
+/**
+ * Registra um callback de conclusão de transferência.
+ * @param callback Função chamada na interrupção (NULL desativa)
+ * @param user_data Ponteiro repassado ao callback
+ */
+extern void led_dma_set_callback(led_dma_callback_t callback, void *user_data);
+
+#endif
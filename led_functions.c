@@ -7,6 +7,12 @@
 #include "frames.h"
 #include "letters.h"
 #include "led_functions.h"
+#include "led_dma.h"
+#include "output_core.h"
+#include "framebuffer.h"
+#include "indexed_framebuffer.h"
+#include "perf_counters.h"
+#include "transition.h"
 
 /**
  * Converte valores RGB normalizados (0.0-1.0) para formato de 32 bits
@@ -50,23 +56,70 @@ void normalize_color(RGBColor *color) {
 }
 
 /**
- * Mapeia índice lógico para posição física na matriz LED
- * Considera o padrão serpentina (zigzag) comum em matrizes de LED
- * @param index Índice lógico (0-24 para matriz 5x5)
- * @return Posição física correspondente
+ * Empacota canais de 8 bits no formato G|R|B, sem ponto flutuante
+ * @param b Blue (0-255)
+ * @param r Red (0-255)
+ * @param g Green (0-255)
+ * @return Valor de 32 bits no formato G|R|B para envio aos LEDs
+ */
+uint32_t rgb_matrix_fixed(uint8_t b, uint8_t r, uint8_t g) {
+    return ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8);
+}
+
+/**
+ * Converte cor em double (0-255) para canais de 8 bits com clamp
+ * @param color Cor a ser convertida
+ * @return Cor em RGBColor8
+ */
+RGBColor8 color_to_fixed(RGBColor color) {
+    RGBColor8 fixed = {
+        color.r <= 0 ? 0 : color.r >= 255 ? 255 : (uint8_t)color.r,
+        color.g <= 0 ? 0 : color.g >= 255 ? 255 : (uint8_t)color.g,
+        color.b <= 0 ? 0 : color.b >= 255 ? 255 : (uint8_t)color.b
+    };
+    return fixed;
+}
+
+/**
+ * Converte intensidade 0.0-1.0 para a escala inteira 0-256
+ * @param intensity Intensidade em double
+ * @return Intensidade em ponto fixo
+ */
+uint16_t intensity_to_fixed(double intensity) {
+    if (intensity <= 0.0) return 0;
+    if (intensity >= 1.0) return INTENSITY_FIXED_MAX;
+    return (uint16_t)(intensity * INTENSITY_FIXED_MAX + 0.5);
+}
+
+/**
+ * Tabela de brilho pré-calculada, recalculada só quando a intensidade muda
+ * @param intensity Intensidade em ponto fixo (0-256)
+ * @return Tabela de 256 entradas
  */
-int map_index_to_position(int index) {
-    // Calcula linha e coluna baseado no índice
-    int row = 4 - (index / 5);      // Linha invertida (4 para 0)
-    int column = 4 - (index % 5);   // Coluna invertida (4 para 0)
+const uint8_t *brightness_table(uint16_t intensity) {
+    static uint8_t table[256];
+    static int32_t table_intensity = -1;  // Força o cálculo na primeira chamada
 
-    // Inverte direção nas linhas ímpares para padrão serpentina
-    // Linhas 1 e 3 têm direção invertida
-    if (row == 1 || row == 3) {
-        column = 4 - column;
+    if (intensity > INTENSITY_FIXED_MAX) intensity = INTENSITY_FIXED_MAX;
+
+    if (table_intensity != intensity) {
+        for (int v = 0; v < 256; v++) {
+            table[v] = (uint8_t)((v * intensity) >> 8);
+        }
+        table_intensity = intensity;
     }
 
-    return (row * 5) + column;
+    return table;
+}
+
+/**
+ * Multiplica um canal por um nível 0-255 (255 preserva o valor, 0 apaga)
+ * @param value Valor do canal
+ * @param level Nível de brilho
+ * @return Valor escalado
+ */
+static inline uint8_t scale8(uint8_t value, uint8_t level) {
+    return (uint8_t)((value * (level + 1)) >> 8);
 }
 
 /**
@@ -85,72 +138,37 @@ void set_led(int index, RGBColor color, PIO pio, uint sm) {
 }
 
 /**
- * Cria array de frames para exibir texto
- * Cada caractere é convertido para sua representação em matriz 5x5
+ * Cria array de glifos para exibir texto
+ * Cada caractere é resolvido em O(1) pela tabela ASCII da fonte em flash
  * @param text String de texto a ser convertida
- * @return Array de ponteiros para frames de cada caractere
+ * @return Array de glifos de cada caractere (+ espaço final)
  */
-double **create_text(const char *text) {
+uint32_t *create_text(const char *text) {
     int max_chars = strlen(text);
     
-    // Aloca memória para array de ponteiros (+1 para espaço final)
-    double **frames = (double **)malloc((max_chars + 1) * sizeof(double *));
-    double **font = letras_5x5;  // Fonte 5x5 definida externamente
-    double *space = full;        // Padrão de espaço
+    // Aloca memória para o vetor de glifos (+1 para espaço final)
+    uint32_t *glyphs = (uint32_t *)malloc((max_chars + 1) * sizeof(uint32_t));
+    if (!glyphs) return NULL;
 
-    // Mapeia cada caractere para seu frame correspondente
+    // Mapeia cada caractere para seu glifo (minúsculas e não suportados resolvidos na tabela)
     for (int i = 0; i < max_chars; i++) {
-        char c = toupper(text[i]);  // Converte para maiúscula
-
-        // Switch extenso para mapear caracteres para índices da fonte
-        switch (c) {
-            case 'A': frames[i] = font[CHAR_A]; break;
-            case 'B': frames[i] = font[CHAR_B]; break;
-            case 'C': frames[i] = font[CHAR_C]; break;
-            case 'D': frames[i] = font[CHAR_D]; break;
-            case 'E': frames[i] = font[CHAR_E]; break;
-            case 'F': frames[i] = font[CHAR_F]; break;
-            case 'G': frames[i] = font[CHAR_G]; break;
-            case 'H': frames[i] = font[CHAR_H]; break;
-            case 'I': frames[i] = font[CHAR_I]; break;
-            case 'J': frames[i] = font[CHAR_J]; break;
-            case 'K': frames[i] = font[CHAR_K]; break;
-            case 'L': frames[i] = font[CHAR_L]; break;
-            case 'M': frames[i] = font[CHAR_M]; break;
-            case 'N': frames[i] = font[CHAR_N]; break;
-            case 'O': frames[i] = font[CHAR_O]; break;
-            case 'P': frames[i] = font[CHAR_P]; break;
-            case 'Q': frames[i] = font[CHAR_Q]; break;
-            case 'R': frames[i] = font[CHAR_R]; break;
-            case 'S': frames[i] = font[CHAR_S]; break;
-            case 'T': frames[i] = font[CHAR_T]; break;
-            case 'U': frames[i] = font[CHAR_U]; break;
-            case 'V': frames[i] = font[CHAR_V]; break;
-            case 'W': frames[i] = font[CHAR_W]; break;
-            case 'X': frames[i] = font[CHAR_X]; break;
-            case 'Y': frames[i] = font[CHAR_Y]; break;
-            case 'Z': frames[i] = font[CHAR_Z]; break;
-            case ' ': frames[i] = font[CHAR_SPACE]; break;
-            case '!': frames[i] = font[CHAR_EXCLAMATION]; break;
-            case '.': frames[i] = font[CHAR_DOT]; break;
-            default:  frames[i] = font[CHAR_SPACE]; break;  // Espaço para caracteres não suportados
-        }
+        glyphs[i] = glyph_for_char(text[i]);
     }
 
     // Adiciona espaço final
-    frames[max_chars] = font[CHAR_SPACE];
-    return frames;
+    glyphs[max_chars] = glyph_for_char(' ');
+    return glyphs;
 }
 
 /**
- * Exibe um frame (matriz 5x5) na matriz de LEDs
+ * Converte um frame (matriz 5x5) nas palavras G|R|B enviadas aos LEDs
+ * As palavras já saem na ordem física da cadeia, prontas para o PIO/DMA
  * @param frame Array com valores de intensidade para cada LED
  * @param color Cor base para o frame
- * @param pio Instância PIO
- * @param sm State machine PIO
  * @param intensity Intensidade geral (0.0-1.0)
+ * @param words Buffer de saída com NUM_LEDS palavras
  */
-void display_frame(double *frame, RGBColor color, PIO pio, uint sm, double intensity) {
+void pack_frame(double *frame, RGBColor color, double intensity, uint32_t *words) {
     // Clamp da intensidade
     if (intensity < 0.0) intensity = 0.0;
     if (intensity > 1.0) intensity = 1.0;
@@ -164,36 +182,302 @@ void display_frame(double *frame, RGBColor color, PIO pio, uint sm, double inten
         int physical_index = map_index_to_position(i);
 
         // Calcula cor final considerando intensidade do frame e intensidade geral
-        RGBColor led_color = {
-            color.r * frame[physical_index] * intensity,
-            color.g * frame[physical_index] * intensity,
-            color.b * frame[physical_index] * intensity
-        };
-
-        // Define a cor do LED
-        set_led(i, led_color, pio, sm);
+        words[i] = rgb_matrix(color.b * frame[physical_index] * intensity,
+                              color.r * frame[physical_index] * intensity,
+                              color.g * frame[physical_index] * intensity);
+    }
+}
+
+/**
+ * Versão inteira de pack_frame(): brilho 8 bits por LED, intensidade 0-256
+ * A cor é escalada uma única vez pela tabela de brilho; por pixel restam
+ * apenas uma consulta de mapeamento e, nos níveis intermediários, três multiplicações inteiras
+ * @param frame Array com brilho (0-255) para cada LED
+ * @param color Cor base para o frame
+ * @param intensity Intensidade em ponto fixo (0-256)
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+void pack_frame_fixed(const uint8_t *frame, RGBColor8 color, uint16_t intensity, uint32_t *words) {
+    // Aplica a intensidade geral na cor base
+    const uint8_t *table = brightness_table(intensity);
+    RGBColor8 scaled = {table[color.r], table[color.g], table[color.b]};
+    uint32_t full_word = rgb_matrix_fixed(scaled.b, scaled.r, scaled.g);
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        uint8_t level = frame[map_index_to_position(i)];
+
+        // Casos comuns (texto e frames monocromáticos) sem multiplicação
+        if (level == 0) {
+            words[i] = 0;
+        } else if (level == 255) {
+            words[i] = full_word;
+        } else {
+            words[i] = rgb_matrix_fixed(scale8(scaled.b, level), scale8(scaled.r, level), scale8(scaled.g, level));
+        }
+    }
+}
+
+/**
+ * Converte pixels RGB de 8 bits (ordem lógica) nas palavras G|R|B (ordem física)
+ * Intensidade aplicada pela tabela de brilho: uma consulta por canal, sem multiplicação
+ * @param pixels Pixels em ordem lógica, NUM_LEDS posições
+ * @param intensity Intensidade em ponto fixo (0-256)
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+void pack_pixels_fixed(const RGBColor8 *pixels, uint16_t intensity, uint32_t *words) {
+    const uint8_t *table = brightness_table(intensity);
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        RGBColor8 pixel = pixels[map_index_to_position(i)];
+        words[i] = rgb_matrix_fixed(table[pixel.b], table[pixel.r], table[pixel.g]);
+    }
+}
+
+/**
+ * Lê o índice de um pixel compactado
+ * @param indices Pixels compactados
+ * @param bits Bits por pixel (4 ou 8)
+ * @param index Índice lógico
+ * @return Índice da paleta
+ */
+static inline uint8_t indexed_at(const uint8_t *indices, uint bits, int index) {
+    if (bits == 8) return indices[index];
+    return (indices[index >> 1] >> ((index & 1) << 2)) & 0x0F;
+}
+
+/**
+ * Converte pixels indexados nas palavras G|R|B (ordem física)
+ * A paleta chega pronta no formato do fio: uma consulta por pixel, sem escalar canais
+ * @param indices Pixels compactados em ordem lógica
+ * @param bits Bits por pixel (4 ou 8)
+ * @param palette_words Paleta em palavras G|R|B
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+void pack_indexed_fixed(const uint8_t *indices, uint bits, const uint32_t *palette_words, uint32_t *words) {
+    // Laços separados: o teste de bits sai do caminho por pixel
+    if (bits == 8) {
+        for (int i = 0; i < NUM_LEDS; i++) {
+            words[i] = palette_words[indices[map_index_to_position(i)]];
+        }
+    } else {
+        for (int i = 0; i < NUM_LEDS; i++) {
+            int position = map_index_to_position(i);
+            words[i] = palette_words[(indices[position >> 1] >> ((position & 1) << 2)) & 0x0F];
+        }
+    }
+}
+
+/**
+ * Retorna o buffer onde o frame deve ser montado: o buffer livre do DMA
+ * quando disponível (evita cópia), ou o buffer local do chamador
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param local Buffer local com NUM_LEDS palavras
+ * @return Buffer de destino
+ */
+uint32_t *frame_words_begin(PIO pio, uint sm, uint32_t *local) {
+    return led_dma_is_attached(pio, sm) ? led_dma_get_back_buffer() : local;
+}
+
+// Último frame do envio bloqueante (com DMA, o buffer já enviado fica no próprio led_dma)
+static uint32_t sent_words[NUM_LEDS];
+
+/**
+ * Envia as palavras sem passar pela transição
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param words Buffer retornado por frame_words_begin()
+ */
+void frame_words_send(PIO pio, uint sm, const uint32_t *words) {
+    // Tempo esperando o frame anterior (DMA) ou o FIFO (envio bloqueante)
+    PERF_BEGIN(stall);
+
+    if (led_dma_is_attached(pio, sm)) {
+        led_dma_submit(NUM_LEDS);
+    } else {
+        for (int i = 0; i < NUM_LEDS; i++) {
+            sent_words[i] = words[i];
+            pio_sm_put_blocking(pio, sm, words[i]);
+        }
+    }
+
+    PERF_END(stall, PERF_STALL);
+}
+
+/**
+ * Envia as palavras montadas por frame_words_begin(), misturadas pela transição em andamento
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param words Buffer retornado por frame_words_begin()
+ */
+void frame_words_end(PIO pio, uint sm, uint32_t *words) {
+    // A mistura conta como conversão: é a única passada extra por frame durante a transição
+    PERF_BEGIN(convert);
+    transition_apply(words, led_dma_is_attached(pio, sm) ? led_dma_get_front_buffer() : sent_words);
+    PERF_END(convert, PERF_CONVERT);
+
+    frame_words_send(pio, sm, words);
+}
+
+/**
+ * Obtém um slot da fila do núcleo 1, contando a espera por fila cheia
+ * @return Slot livre
+ */
+static QueuedFrame *frame_queue_slot(void) {
+    PERF_BEGIN(stall);
+    QueuedFrame *out = frame_queue_acquire_blocking();
+    PERF_END(stall, PERF_STALL);
+    return out;
+}
+
+/**
+ * Exibe pixels RGB de 8 bits (ordem lógica), escolhendo o caminho de saída:
+ * fila do núcleo 1, DMA ou envio bloqueante
+ * @param pixels Pixels em ordem lógica, NUM_LEDS posições
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param intensity Intensidade em ponto fixo (0-256)
+ */
+void display_pixels_fixed(const RGBColor8 *pixels, PIO pio, uint sm, uint16_t intensity) {
+    if (output_core_owns(pio, sm)) {
+        QueuedFrame *out = frame_queue_slot();
+        memcpy(out->pixels, pixels, sizeof(out->pixels));
+        out->intensity = intensity;
+        frame_queue_publish();
+        return;
+    }
+
+    uint32_t local[NUM_LEDS];
+    uint32_t *words = frame_words_begin(pio, sm, local);
+
+    PERF_BEGIN(convert);
+    pack_pixels_fixed(pixels, intensity, words);
+    PERF_END(convert, PERF_CONVERT);
+
+    frame_words_end(pio, sm, words);
+}
+
+/**
+ * Exibe pixels indexados, resolvendo a paleta só na conversão
+ * @param indices Pixels compactados em ordem lógica
+ * @param bits Bits por pixel (4 ou 8)
+ * @param palette Paleta RGB com 1 << bits entradas
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param intensity Intensidade em ponto fixo (0-256)
+ */
+void display_indexed_fixed(const uint8_t *indices, uint bits, const RGBColor8 *palette,
+                           PIO pio, uint sm, uint16_t intensity) {
+    // O núcleo 1 recebe RGB: a paleta é expandida aqui
+    if (output_core_owns(pio, sm)) {
+        QueuedFrame *out = frame_queue_slot();
+        for (int i = 0; i < NUM_LEDS; i++) {
+            out->pixels[i] = palette[indexed_at(indices, bits, i)];
+        }
+        out->intensity = intensity;
+        frame_queue_publish();
+        return;
+    }
+
+    uint32_t local[NUM_LEDS];
+    uint32_t *words = frame_words_begin(pio, sm, local);
+
+    PERF_BEGIN(convert);
+    // Intensidade aplicada uma vez por cor da paleta, não por pixel
+    const uint8_t *table = brightness_table(intensity);
+    uint32_t palette_words[256];
+    for (uint c = 0; c < (1u << bits); c++) {
+        palette_words[c] = rgb_matrix_fixed(table[palette[c].b], table[palette[c].r], table[palette[c].g]);
     }
+    pack_indexed_fixed(indices, bits, palette_words, words);
+    PERF_END(convert, PERF_CONVERT);
+
+    frame_words_end(pio, sm, words);
+}
+
+/**
+ * Exibe um frame de brilho 8 bits usando apenas aritmética inteira
+ * @param frame Array com brilho (0-255) para cada LED
+ * @param color Cor base para o frame
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param intensity Intensidade em ponto fixo (0-256)
+ */
+void display_frame_fixed(const uint8_t *frame, RGBColor8 color, PIO pio, uint sm, uint16_t intensity) {
+    // Saída no núcleo 1: só expande o brilho em pixels; conversão e envio ficam do outro lado
+    if (output_core_owns(pio, sm)) {
+        QueuedFrame *out = frame_queue_slot();
+        for (int i = 0; i < NUM_LEDS; i++) {
+            out->pixels[i] = (RGBColor8){scale8(color.r, frame[i]), scale8(color.g, frame[i]), scale8(color.b, frame[i])};
+        }
+        out->intensity = intensity;
+        frame_queue_publish();
+        return;
+    }
+
+    uint32_t local[NUM_LEDS];
+    uint32_t *words = frame_words_begin(pio, sm, local);
+
+    PERF_BEGIN(convert);
+    pack_frame_fixed(frame, color, intensity, words);
+    PERF_END(convert, PERF_CONVERT);
+
+    frame_words_end(pio, sm, words);
+}
+
+/**
+ * Exibe um frame (matriz 5x5) na matriz de LEDs
+ * @param frame Array com valores de intensidade para cada LED
+ * @param color Cor base para o frame
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param intensity Intensidade geral (0.0-1.0)
+ */
+void display_frame(double *frame, RGBColor color, PIO pio, uint sm, double intensity) {
+    uint32_t words[NUM_LEDS];
+
+    pack_frame(frame, color, intensity, words);
+
+    // Envia palavra por palavra, bloqueando no FIFO
+    for (int i = 0; i < NUM_LEDS; i++) {
+        pio_sm_put_blocking(pio, sm, words[i]);
+    }
+}
+
+/**
+ * Exibe um frame usando DMA, sem bloquear a CPU durante a transferência
+ * Requer led_dma_init() previamente chamado
+ * @param frame Array com valores de intensidade para cada LED
+ * @param color Cor base para o frame
+ * @param intensity Intensidade geral (0.0-1.0)
+ */
+void display_frame_async(double *frame, RGBColor color, double intensity) {
+    // Monta o frame no buffer livre enquanto o anterior ainda pode estar no fio
+    pack_frame(frame, color, intensity, led_dma_get_back_buffer());
+    led_dma_submit(NUM_LEDS);
 }
 
 /**
- * Concatena múltiplos frames de texto em uma matriz maior
+ * Concatena múltiplos glifos de texto em uma matriz maior
  * NOTA: Esta função parece não estar sendo usada no código atual
- * @param text Array de frames de texto
- * @param text_length Número de frames
+ * @param text Array de glifos de texto
+ * @param text_length Número de glifos
  * @param full_text Matriz de destino para texto concatenado
  */
-void concatenate_text(double *text[], int text_length, double full_text[5][MAX_ROWS]) {
+void concatenate_text(const uint32_t *text, int text_length, uint8_t full_text[5][MAX_ROWS]) {
     for (int i = 0; i < text_length; i++) {
         for (int row = 0; row < 5; row++) {
             for (int col = 0; col < 5; col++) {
-                full_text[row][(i * 5) + col] = text[i][row * 5 + col];
+                full_text[row][(i * 5) + col] = glyph_pixel(text[i], row, col);
             }
         }
     }
 }
 
 /**
- * Acende um LED específico com cor e intensidade definidas
+ * Acende um LED específico com cor e intensidade definidas, mantendo os demais
+ * O LED é gravado no framebuffer persistente e o frame inteiro é reenviado
+ * só se algo mudou (ver framebuffer.h)
  * @param index Índice do LED (0-24)
  * @param color Cor RGB
  * @param pio Instância PIO
@@ -204,139 +488,194 @@ void add_led(int index, RGBColor color, PIO pio, uint sm, double intensity) {
     // Verifica se índice está dentro dos limites
     if (index < 0 || index >= NUM_LEDS) return;
 
-    // Clamp da intensidade
-    if (intensity < 0.0) intensity = 0.0;
-    if (intensity > 1.0) intensity = 1.0;
+    // Aplica intensidade à cor em ponto fixo
+    RGBColor8 color8 = color_to_fixed(color);
+    const uint8_t *table = brightness_table(intensity_to_fixed(intensity));
+    framebuffer_set_index(index, (RGBColor8){table[color8.r], table[color8.g], table[color8.b]});
 
-    // Normaliza cor
-    normalize_color(&color);
+    // Envia o frame apenas se o LED mudou
+    framebuffer_commit(pio, sm, INTENSITY_FIXED_MAX);
+}
 
-    // Aplica intensidade à cor
-    RGBColor adjusted = {
-        color.r * intensity,
-        color.g * intensity,
-        color.b * intensity
-    };
+/**
+ * Calcula a altura total (em linhas) de uma mensagem em rolagem vertical
+ * Cada caractere ocupa GLYPH_HEIGHT linhas + TEXT_SPACING de espaço, mais o espaço final
+ * @param length Número de caracteres do texto
+ * @return Altura da mensagem em linhas
+ */
+int text_height(int length) {
+    return (length + 1) * (GLYPH_HEIGHT + TEXT_SPACING) - TEXT_SPACING;
+}
 
-    // Define LED
-    set_led(index, adjusted, pio, sm);
+/**
+ * Renderiza a janela da matriz começando na linha row_base da mensagem
+ * Lê os bits direto dos glifos em flash: sem heap e com memória constante,
+ * independente do tamanho do texto. O glifo fica centralizado na largura da matriz
+ * @param text Texto da mensagem
+ * @param length Número de caracteres do texto
+ * @param row_base Linha da mensagem exibida no topo da janela (pode ser negativa)
+ * @param frame Frame de saída com NUM_LEDS posições
+ * @param level Brilho dos pixels acesos (0-255)
+ */
+void render_text_window(const char *text, int length, int row_base, uint8_t *frame, uint8_t level) {
+    const int stride = GLYPH_HEIGHT + TEXT_SPACING;  // Linhas por caractere
+    int height = text_height(length);
+
+    // Posição inicial (caractere e linha dentro dele); avança incrementalmente nas linhas seguintes
+    int letter = row_base >= 0 ? row_base / stride : 0;
+    int letter_row = row_base >= 0 ? row_base % stride : 0;
+    uint32_t glyph = letter < length ? glyph_for_char(text[letter]) : glyph_for_char(' ');
+
+    for (int row = 0; row < MATRIX_HEIGHT; row++) {
+        int y = row_base + row;
+        uint8_t *out = &frame[row * MATRIX_WIDTH];
+
+        // Colunas fora do glifo ficam apagadas
+        memset(out, 0, MATRIX_WIDTH);
+        out += TEXT_MARGIN;
+
+        // Fora da mensagem ou na linha de espaçamento entre letras: linha apagada
+        if (y >= 0 && y < height && letter_row < GLYPH_HEIGHT) {
+            // Extrai os 5 bits da linha e expande em brilho
+            uint32_t bits = glyph >> ((GLYPH_HEIGHT - 1 - letter_row) * GLYPH_WIDTH);
+            for (int column = 0; column < GLYPH_WIDTH; column++) {
+                if (bits & (1u << (GLYPH_WIDTH - 1 - column))) out[column] = level;
+            }
+        }
+
+        // Avança para a próxima linha da mensagem
+        if (y >= 0 && ++letter_row == stride) {
+            letter_row = 0;
+            letter++;
+            glyph = letter < length ? glyph_for_char(text[letter]) : glyph_for_char(' ');
+        }
+    }
 }
 
 /**
- * Exibe mensagem de texto com efeito de scroll vertical
- * @param text String de texto a ser exibida
+ * Prepara a animação de mensagem em rolagem (um frame por passo)
+ * @param anim Estado da animação
+ * @param text String de texto a ser exibida (deve continuar válida durante a animação)
  * @param color Cor do texto
  * @param pio Instância PIO
  * @param sm State machine PIO
  * @param intensity Intensidade do brilho
- * @param speed Velocidade do scroll (delay em ms)
  */
-void show_message(const char *text, RGBColor color, PIO pio, uint sm, double intensity, int speed) {
-    if (!text) return;  // Proteção contra ponteiro nulo
-
-    // Converte texto para frames
-    double **frames = create_text(text);
-    if (!frames) return;
-
-    int length = strlen(text) + 1;  // +1 para espaço final
-    int rows_per_letter = 5;        // Altura de cada letra
-    int columns_per_letter = 5;     // Largura de cada letra
-    int spacing = 1;                // Espaçamento entre letras
+void message_animation_init(MessageAnimation *anim, const char *text, RGBColor color, PIO pio, uint sm, double intensity) {
+    anim->text = text ? text : "";
+    anim->length = strlen(anim->text);
+    anim->row_base = -(MATRIX_HEIGHT - 1);
+
+    // Converte cor e intensidade uma única vez; os passos ficam só com inteiros
+    anim->color = color_to_fixed(color);
+    anim->intensity = intensity_to_fixed(intensity);
+    anim->pio = pio;
+    anim->sm = sm;
+}
 
-    // Calcula altura total da mensagem
-    int messa_height = length * (rows_per_letter + spacing) - spacing;
+/**
+ * Desenha o próximo frame da rolagem
+ * @param state Ponteiro para MessageAnimation
+ * @return false quando a mensagem terminou de passar
+ */
+bool message_animation_step(void *state) {
+    MessageAnimation *anim = (MessageAnimation *)state;
 
-    // Proteção contra mensagens muito longas
-    if (messa_height > MAX_ROWS * 10) {
-        free(frames);
-        return;
-    }
+    if (anim->row_base >= text_height(anim->length)) return false;
 
-    // Cria matriz para toda a mensagem
-    double full_text[messa_height][5];
-    memset(full_text, 0, sizeof(full_text));
+    uint8_t frame[NUM_LEDS];  // Frame atual
+    render_text_window(anim->text, anim->length, anim->row_base, frame, 255);
 
-    // Monta a mensagem completa concatenando os frames
-    for (int i = 0; i < length; i++) {
-        int base_row = i * (rows_per_letter + spacing);
-        for (int row = 0; row < rows_per_letter; row++) {
-            for (int column = 0; column < columns_per_letter; column++) {
-                full_text[base_row + row][column] = frames[i][row * columns_per_letter + column];
-            }
-        }
-    }
+    // Exibe frame atual (por DMA quando disponível, liberando a CPU)
+    display_frame_fixed(frame, anim->color, anim->pio, anim->sm, anim->intensity);
 
-    // Efeito de scroll: move a "janela" de visualização pela mensagem
-    for (int row_base = -4; row_base < messa_height; row_base++) {
-        double frame[5][5] = {0};  // Frame atual (5x5)
+    anim->row_base++;
+    return true;
+}
 
-        // Extrai porção da mensagem para o frame atual
-        for (int row = 0; row < 5; row++) {
-            int row_frames = row_base + row;
-            for (int column = 0; column < 5; column++) {
-                if (row_frames >= 0 && row_frames < messa_height) {
-                    frame[row][column] = full_text[row_frames][column];
-                } else {
-                    frame[row][column] = 0;  // Área vazia (fora da mensagem)
-                }
-            }
-        }
+/**
+ * Exibe mensagem de texto com efeito de scroll vertical (versão bloqueante)
+ * Cada janela é calculada direto dos glifos: sem alocação e sem cópia da mensagem inteira
+ * Para não bloquear, use message_animation_step() com o escalonador (scheduler.h)
+ * @param text String de texto a ser exibida
+ * @param color Cor do texto
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param intensity Intensidade do brilho
+ * @param speed Velocidade do scroll (delay em ms)
+ */
+void show_message(const char *text, RGBColor color, PIO pio, uint sm, double intensity, int speed) {
+    if (!text) return;  // Proteção contra ponteiro nulo
 
-        // Exibe frame atual
-        display_frame(&frame[0][0], color, pio, sm, intensity);
+    MessageAnimation anim;
+    message_animation_init(&anim, text, color, pio, sm, intensity);
 
+    // Efeito de scroll: move a "janela" de visualização pela mensagem
+    while (message_animation_step(&anim)) {
         // Aguarda antes do próximo frame
         sleep_ms(speed);
     }
-
-    // Libera memória
-    free(frames);
 }
 
+// Sequência de cores do modo demo
+static const uint8_t demo_red[]   = {255, 255, 255, 0, 0, 0, 255, 0, 255, 255};
+static const uint8_t demo_green[] = {0, 165, 255, 255, 255, 0, 0, 255, 255, 128};
+static const uint8_t demo_blue[]  = {0, 0, 0, 0, 255, 75, 255, 255, 255, 128};
+#define DEMO_COLORS (sizeof(demo_red) / sizeof(demo_red[0]))
+
 /**
- * Função de demonstração que executa sequência de cores nos LEDs
+ * Prepara a animação do modo demo (uma cor por passo)
+ * @param anim Estado da animação
  * @param pio Instância PIO
  * @param sm State machine PIO
- * @param speed Velocidade da transição (delay em ms)
  */
-void show_demo1(PIO pio, uint sm, int speed) {
-    // Arrays com sequência de cores predefinidas
-    uint16_t red[]   = {255, 255, 255, 0, 0, 0, 255, 0, 255, 255};
-    uint16_t green[] = {0, 165, 255, 255, 255, 0, 0, 255, 255, 128};
-    uint16_t blue[]  = {0, 0, 0, 0, 255, 75, 255, 255, 255, 128};
-
-    uint16_t cont = 0;  // Contador para indexar as cores
+void demo_animation_init(DemoAnimation *anim, PIO pio, uint sm) {
+    anim->cont = 0;
+    anim->pio = pio;
+    anim->sm = sm;
+
+    // Todos os pixels apontam para a entrada 0: cada passo troca só a cor da paleta
+    indexed_framebuffer_fill(0);
+    indexed_framebuffer_invalidate();
+}
 
-    RGBColor color = {red[cont], green[cont], blue[cont]};
+/**
+ * Mostra a próxima cor da demonstração; o último passo apaga a matriz
+ * @param state Ponteiro para DemoAnimation
+ * @return false depois de apagar os LEDs
+ */
+bool demo_animation_step(void *state) {
+    DemoAnimation *anim = (DemoAnimation *)state;
 
-    // Loop principal da demonstração
-    while (1) {
-        // Acende todos os LEDs com a cor atual
-        for (int i = 0; i < NUM_LEDS; i++) {
-            set_led(i, color, pio, sm);
-        }
+    if (anim->cont > (int)DEMO_COLORS) return false;
 
-        sleep_ms(speed);  // Pausa
+    if (anim->cont == (int)DEMO_COLORS) {
+        // Apaga todos os LEDs no final
+        indexed_framebuffer_set_color(0, (RGBColor8){0, 0, 0});
+    } else {
+        // Cor atual: muda uma entrada da paleta, nenhum pixel é reescrito
+        indexed_framebuffer_set_color(0, (RGBColor8){demo_red[anim->cont], demo_green[anim->cont], demo_blue[anim->cont]});
+    }
 
-        cont += 1;  // Próxima cor
+    // Intensidade total; a paleta é resolvida na conversão para o fio
+    indexed_framebuffer_commit(anim->pio, anim->sm, INTENSITY_FIXED_MAX);
 
-        // Atualiza cor
-        color.r = red[cont];
-        color.g = green[cont];
-        color.b = blue[cont];
-        
-        // Sai do loop após 10 iterações
-        if (cont >= 10) {
-            break;
-        }
-    }
+    anim->cont++;
+    return anim->cont <= (int)DEMO_COLORS;
+}
 
-    // Apaga todos os LEDs no final
-    color.r = 0;
-    color.g = 0;
-    color.b = 0;
+/**
+ * Função de demonstração que executa sequência de cores nos LEDs (versão bloqueante)
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param speed Velocidade da transição (delay em ms)
+ */
+void show_demo1(PIO pio, uint sm, int speed) {
+    DemoAnimation anim;
+    demo_animation_init(&anim, pio, sm);
 
-    for (int i = 0; i < NUM_LEDS; i++) {
-        set_led(i, color, pio, sm);
+    // Uma cor por passo, com pausa entre elas; o último passo apaga a matriz
+    while (demo_animation_step(&anim)) {
+        sleep_ms(speed);  // Pausa
     }
-}
\ No newline at end of file
+}
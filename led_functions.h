@@ -11,10 +11,17 @@
 #include "pico/bootrom.h"
 #include "hardware/pio.h"
 #include "letters.h"
+#include "matrix_config.h"
+#include "matrix_geometry.h"
 
-#define NUM_LEDS 25                      // Número total de LEDs na matriz (5x5)
 #define MAX_TEXT_LENGTH 100              // Número máximo de caracteres na mensagem
 #define MAX_ROWS (5 * MAX_TEXT_LENGTH)   // Número máximo de colunas no texto concatenado
+#define TEXT_SPACING 1                   // Linhas vazias entre letras na rolagem vertical
+#define TEXT_MARGIN ((MATRIX_WIDTH - GLYPH_WIDTH) / 2) // Colunas à esquerda do glifo na rolagem vertical
+
+#if MATRIX_WIDTH < GLYPH_WIDTH
+#error "A matriz precisa ter ao menos GLYPH_WIDTH colunas para exibir texto"
+#endif
 
 typedef struct {
     double r; // Red (0.0 a 1.0)
@@ -22,11 +29,29 @@ typedef struct {
     double b; // Blue (0.0 a 1.0)
 } RGBColor;
 
-typedef enum {
-    CHAR_A, CHAR_B, CHAR_C, CHAR_D, CHAR_E, CHAR_F, CHAR_G, CHAR_H, CHAR_I, CHAR_J,
-    CHAR_K, CHAR_L, CHAR_M, CHAR_N, CHAR_O, CHAR_P, CHAR_Q, CHAR_R, CHAR_S, CHAR_T,
-    CHAR_U, CHAR_V, CHAR_W, CHAR_X, CHAR_Y, CHAR_Z, CHAR_SPACE, CHAR_EXCLAMATION, CHAR_DOT
-} Char;
+#define INTENSITY_FIXED_MAX 256          // Intensidade em ponto fixo: 0 a 256 (256 = 1.0)
+
+typedef struct {
+    uint8_t r; // Red (0 a 255)
+    uint8_t g; // Green (0 a 255)
+    uint8_t b; // Blue (0 a 255)
+} RGBColor8;
+
+typedef struct {
+    const char *text;    // Texto em rolagem
+    int length;          // Número de caracteres
+    int row_base;        // Linha da mensagem no topo da janela
+    RGBColor8 color;     // Cor do texto
+    uint16_t intensity;  // Intensidade em ponto fixo
+    PIO pio;             // Instância PIO
+    uint sm;             // State machine
+} MessageAnimation;
+
+typedef struct {
+    int cont;            // Índice da cor atual
+    PIO pio;             // Instância PIO
+    uint sm;             // State machine
+} DemoAnimation;
 
 /**
  * Converte valores RGB (0.0 a 1.0) para um valor codificado de 32 bits (formato G|R|B).
@@ -44,11 +69,124 @@ extern uint32_t rgb_matrix(double b, double r, double g);
 extern void normalize_color(RGBColor *color);
 
 /**
- * Mapeia um índice lógico (0 a 24) para o índice físico correto do LED na matriz 5x5.
- * @param index Índice lógico do LED
- * @return Índice físico ajustado para mapeamento da matriz
+ * Versão inteira de rgb_matrix(): empacota canais de 8 bits no formato G|R|B.
+ * @param b Valor do canal azul (0 a 255)
+ * @param r Valor do canal vermelho (0 a 255)
+ * @param g Valor do canal verde (0 a 255)
+ * @return Valor codificado RGB para envio via PIO
+ */
+extern uint32_t rgb_matrix_fixed(uint8_t b, uint8_t r, uint8_t g);
+
+/**
+ * Converte uma cor RGBColor (0–255, ainda não normalizada) para RGBColor8, com clamp.
+ * @param color Cor em double
+ * @return Cor com canais de 8 bits
+ */
+extern RGBColor8 color_to_fixed(RGBColor color);
+
+/**
+ * Converte uma intensidade 0.0–1.0 para a escala inteira 0–INTENSITY_FIXED_MAX.
+ * Deve ser chamada uma vez, fora dos laços por pixel.
+ * @param intensity Intensidade em double
+ * @return Intensidade em ponto fixo
+ */
+extern uint16_t intensity_to_fixed(double intensity);
+
+/**
+ * Retorna a tabela de brilho (256 entradas) para a intensidade informada.
+ * A tabela só é recalculada quando a intensidade muda.
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ * @return Tabela com tabela[v] = v * intensity / 256
+ */
+extern const uint8_t *brightness_table(uint16_t intensity);
+
+/**
+ * Converte um frame de brilho 8 bits nas palavras G|R|B usando apenas inteiros.
+ * @param frame Frame 5x5 com brilho por LED (0 a 255)
+ * @param color Cor base para os LEDs acesos
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ * @param words Buffer de saída com NUM_LEDS palavras, na ordem física
+ */
+extern void pack_frame_fixed(const uint8_t *frame, RGBColor8 color, uint16_t intensity, uint32_t *words);
+
+/**
+ * Converte pixels RGB de 8 bits (ordem lógica) nas palavras G|R|B (ordem física).
+ * @param pixels Pixels em ordem lógica (NUM_LEDS posições)
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+extern void pack_pixels_fixed(const RGBColor8 *pixels, uint16_t intensity, uint32_t *words);
+
+/**
+ * Converte pixels indexados (ordem lógica) nas palavras G|R|B (ordem física).
+ * A paleta já vem no formato do fio: por pixel resta só a consulta do índice.
+ * @param indices Pixels compactados: 8 bits por pixel, ou 4 bits (nibble baixo primeiro)
+ * @param bits Bits por pixel (4 ou 8)
+ * @param palette_words Paleta em palavras G|R|B (1 << bits entradas)
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+extern void pack_indexed_fixed(const uint8_t *indices, uint bits, const uint32_t *palette_words, uint32_t *words);
+
+/**
+ * Buffer onde um frame já no formato do fio deve ser montado: o buffer livre do
+ * DMA quando ele está ligado a este PIO/SM (sem cópia), ou o buffer local.
+ * Não vale quando o núcleo 1 é o dono da saída (output_core_owns()).
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param local Buffer do chamador com NUM_LEDS palavras
+ * @return Buffer de destino
+ */
+extern uint32_t *frame_words_begin(PIO pio, uint sm, uint32_t *local);
+
+/**
+ * Envia as palavras montadas no buffer de frame_words_begin() (DMA ou envio bloqueante),
+ * passando antes pelo estágio de transição (transition.h), que pode misturá-las no lugar.
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param words Buffer retornado por frame_words_begin()
+ */
+extern void frame_words_end(PIO pio, uint sm, uint32_t *words);
+
+/**
+ * Envia as palavras como estão, sem o estágio de transição.
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param words Buffer retornado por frame_words_begin()
+ */
+extern void frame_words_send(PIO pio, uint sm, const uint32_t *words);
+
+/**
+ * Exibe pixels RGB de 8 bits (ordem lógica) pelo melhor caminho disponível:
+ * fila do núcleo 1, DMA ou envio bloqueante.
+ * @param pixels Pixels em ordem lógica (NUM_LEDS posições)
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
  */
-extern int map_index_to_position(int index);
+extern void display_pixels_fixed(const RGBColor8 *pixels, PIO pio, uint sm, uint16_t intensity);
+
+/**
+ * Exibe pixels indexados resolvendo a paleta só na conversão para o fio.
+ * @param indices Pixels compactados (ver pack_indexed_fixed())
+ * @param bits Bits por pixel (4 ou 8)
+ * @param palette Paleta RGB com 1 << bits entradas
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ */
+extern void display_indexed_fixed(const uint8_t *indices, uint bits, const RGBColor8 *palette,
+                                  PIO pio, uint sm, uint16_t intensity);
+
+/**
+ * Exibe um frame de brilho 8 bits (caminho inteiro). Usa DMA quando disponível,
+ * ou entrega o frame ao núcleo 1 quando ele é o dono da saída (output_core.h).
+ * @param frame Frame 5x5 com brilho por LED (0 a 255)
+ * @param color Cor base para os LEDs acesos
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ */
+extern void display_frame_fixed(const uint8_t *frame, RGBColor8 color, PIO pio, uint sm, uint16_t intensity);
 
 /**
  * Acende um LED específico com uma cor.
@@ -60,11 +198,11 @@ extern int map_index_to_position(int index);
 extern void set_led(int index, RGBColor color, PIO pio, uint sm);
 
 /**
- * Cria um vetor de frames a partir de uma string de texto.
- * @param text Texto a ser convertido em frames
- * @return Ponteiro para vetor de frames
+ * Cria um vetor de glifos (máscaras de 25 bits) a partir de uma string de texto.
+ * @param text Texto a ser convertido em glifos
+ * @return Vetor alocado com strlen(text) + 1 glifos (o último é espaço); liberar com free()
  */
-extern double **create_text(const char *text);
+extern uint32_t *create_text(const char *text);
 
 /**
  * Exibe um frame completo na matriz de LEDs.
@@ -77,15 +215,33 @@ extern double **create_text(const char *text);
 extern void display_frame(double *frame, RGBColor color, PIO pio, uint sm, double intensity);
 
 /**
- * Concatena múltiplos caracteres (frames) em uma matriz horizontal.
- * @param text Array de ponteiros para caracteres (frames)
+ * Converte um frame 5x5 nas palavras G|R|B, já na ordem física dos LEDs.
+ * @param frame Frame 5x5 contendo valores de brilho
+ * @param color Cor base para os LEDs acesos
+ * @param intensity Intensidade (0.0 a 1.0)
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+extern void pack_frame(double *frame, RGBColor color, double intensity, uint32_t *words);
+
+/**
+ * Exibe um frame completo via DMA, retornando antes do fim da transferência.
+ * Requer led_dma_init() (ver led_dma.h).
+ * @param frame Frame 5x5 contendo valores de brilho
+ * @param color Cor base para os LEDs acesos
+ * @param intensity Intensidade (0.0 a 1.0)
+ */
+extern void display_frame_async(double *frame, RGBColor color, double intensity);
+
+/**
+ * Concatena múltiplos caracteres (glifos) em uma matriz horizontal.
+ * @param text Vetor de glifos
  * @param text_length Quantidade de caracteres
- * @param full_text Matriz de saída contendo o texto completo concatenado
+ * @param full_text Matriz de saída (0 ou 1 por pixel) contendo o texto completo concatenado
  */
-extern void concatenate_text(double *text[], int text_length, double full_text[5][MAX_ROWS]);
+extern void concatenate_text(const uint32_t *text, int text_length, uint8_t full_text[5][MAX_ROWS]);
 
 /**
- * Acende um LED específico sem apagar os demais.
+ * Acende um LED específico sem apagar os demais (via framebuffer persistente).
  * @param index Índice do LED (0 a 24)
  * @param color Cor desejada
  * @param pio Instância do PIO usada
@@ -94,6 +250,58 @@ extern void concatenate_text(double *text[], int text_length, double full_text[5
  */
 extern void add_led(int index, RGBColor color, PIO pio, uint sm, double intensity);
 
+/**
+ * Altura total, em linhas, de uma mensagem em rolagem vertical (inclui o espaço final).
+ * @param length Número de caracteres do texto
+ * @return Altura em linhas
+ */
+extern int text_height(int length);
+
+/**
+ * Renderiza a janela da matriz (MATRIX_HEIGHT linhas, glifo centralizado na largura)
+ * de uma mensagem a partir de uma linha, direto dos glifos.
+ * Não usa heap e a memória é constante, qualquer que seja o tamanho do texto.
+ * @param text Texto da mensagem
+ * @param length Número de caracteres do texto
+ * @param row_base Linha da mensagem no topo da janela (negativa = entrada pela base)
+ * @param frame Frame de saída (NUM_LEDS posições)
+ * @param level Brilho dos pixels acesos (0 a 255)
+ */
+extern void render_text_window(const char *text, int length, int row_base, uint8_t *frame, uint8_t level);
+
+/**
+ * Prepara a animação de mensagem em rolagem para ser executada passo a passo.
+ * @param anim Estado da animação
+ * @param text Texto a ser mostrado (deve permanecer válido durante a animação)
+ * @param color Cor da mensagem
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade dos LEDs (0.0 a 1.0)
+ */
+extern void message_animation_init(MessageAnimation *anim, const char *text, RGBColor color, PIO pio, uint sm, double intensity);
+
+/**
+ * Passo da animação de mensagem: desenha um frame (ver animation_step_t em scheduler.h).
+ * @param state Ponteiro para MessageAnimation
+ * @return false quando a mensagem terminou
+ */
+extern bool message_animation_step(void *state);
+
+/**
+ * Prepara a animação do modo demo para ser executada passo a passo.
+ * @param anim Estado da animação
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ */
+extern void demo_animation_init(DemoAnimation *anim, PIO pio, uint sm);
+
+/**
+ * Passo da animação demo: mostra uma cor por passo e apaga a matriz no final.
+ * @param state Ponteiro para DemoAnimation
+ * @return false depois de apagar a matriz
+ */
+extern bool demo_animation_step(void *state);
+
 /**
  * Exibe uma mensagem rolando na matriz de LEDs.
  * @param text Texto a ser mostrado
@@ -1,262 +1,17 @@
 #include "letters.h"
-#include "frames.h"
 
-// Definição das letras (A-Z)
-double A[NUM_LEDS] = 
-{
-    0, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    1, 1, 1, 1, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1
-};
-
-double B[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    1, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    1, 1, 1, 1, 0
-};
-
-double C[NUM_LEDS] = 
-{
-    0, 1, 1, 1, 1,
-    1, 0, 0, 0, 0,
-    1, 0, 0, 0, 0,
-    1, 0, 0, 0, 0,
-    0, 1, 1, 1, 1
-};
-
-double D[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 1, 1, 1, 0
-};
-
-double E[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 1,
-    1, 0, 0, 0, 0,
-    1, 1, 1, 1, 0,
-    1, 0, 0, 0, 0,
-    1, 1, 1, 1, 1
-};
-
-double F[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 1,
-    1, 0, 0, 0, 0,
-    1, 1, 1, 1, 0,
-    1, 0, 0, 0, 0,
-    1, 0, 0, 0, 0
-};
-
-double G[NUM_LEDS] = 
-{
-    0, 1, 1, 1, 0,
-    1, 0, 0, 0, 0,
-    1, 0, 1, 1, 1,
-    1, 0, 0, 0, 1,
-    0, 1, 1, 1, 0
-};
-
-double H[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 1, 1, 1, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1
-};
-
-double I[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 1,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    1, 1, 1, 1, 1
-};
-
-double J[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 1,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    1, 0, 1, 0, 0,
-    0, 1, 0, 0, 0
-};
-
-double K[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    1, 0, 0, 1, 0,
-    1, 1, 1, 0, 0,
-    1, 0, 0, 1, 0,
-    1, 0, 0, 0, 1
-};
-
-double L[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 0,
-    1, 0, 0, 0, 0,
-    1, 0, 0, 0, 0,
-    1, 0, 0, 0, 0,
-    1, 1, 1, 1, 1
-};
-
-double M[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    1, 1, 0, 1, 1,
-    1, 0, 1, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1
-};
-
-double N[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    1, 1, 0, 0, 1,
-    1, 0, 1, 0, 1,
-    1, 0, 0, 1, 1,
-    1, 0, 0, 0, 1
-};
-
-double O[NUM_LEDS] = 
-{
-    0, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    0, 1, 1, 1, 0
-};
-
-double P[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    1, 1, 1, 1, 0,
-    1, 0, 0, 0, 0,
-    1, 0, 0, 0, 0
-};
-
-double Q[NUM_LEDS] = 
-{
-    0, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 1, 1,
-    0, 1, 1, 1, 1
-};
-
-double R[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    1, 1, 1, 1, 0,
-    1, 0, 0, 1, 0,
-    1, 0, 0, 0, 1
-};
-
-double S[NUM_LEDS] = 
-{
-    0, 1, 1, 1, 1,
-    1, 0, 0, 0, 0,
-    0, 1, 1, 1, 0,
-    0, 0, 0, 0, 1,
-    1, 1, 1, 1, 0
-};
-
-double T[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 1,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0
-};
-
-double U[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    0, 1, 1, 1, 0
-};
-
-double V[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    0, 1, 0, 1, 0,
-    0, 0, 1, 0, 0
-};
-
-double W[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    1, 0, 0, 0, 1,
-    1, 0, 1, 0, 1,
-    1, 1, 0, 1, 1,
-    1, 0, 0, 0, 1
-};
-
-double X[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    0, 1, 0, 1, 0,
-    0, 0, 1, 0, 0,
-    0, 1, 0, 1, 0,
-    1, 0, 0, 0, 1
-};
-
-double Y[NUM_LEDS] = 
-{
-    1, 0, 0, 0, 1,
-    0, 1, 0, 1, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0
-};
-
-double Z[NUM_LEDS] = 
-{
-    1, 1, 1, 1, 1,
-    0, 0, 0, 1, 0,
-    0, 0, 1, 0, 0,
-    0, 1, 0, 0, 0,
-    1, 1, 1, 1, 1
-};
-
-double exclamation[NUM_LEDS] = 
-{
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 0, 0, 0,
-    0, 0, 1, 0, 0
-};
-
-double dot[NUM_LEDS] = {
-    0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0,
-    0, 0, 1, 0, 0
-};
-
-double *letras_5x5[] = {
-    A, B, C, D, E, F,
-    G, H, I, J, K, L,
-    M, N, O, P, Q, R,
-    S, T, U, V, W, X,
-    Y, Z, clear, exclamation, dot
-};
\ No newline at end of file
+// O formato dos glifos de 25 bits (linha 0 nos bits 24-20, coluna 0 no bit mais
+// significativo de cada linha) e a tabela font_5x5_ascii vêm de font_compile.py.
+
+/**
+ * Expande os bits de um glifo diretamente em um frame de brilho
+ * @param glyph Glifo 5x5 em bits (ver font_5x5_ascii)
+ * @param frame Frame de destino com GLYPH_WIDTH * GLYPH_HEIGHT posições
+ * @param level Brilho dos pixels acesos (0-255)
+ */
+void render_glyph(uint32_t glyph, uint8_t *frame, uint8_t level) {
+    // Percorre do bit 24 (linha 0, coluna 0) até o bit 0 (linha 4, coluna 4)
+    for (int i = 0; i < GLYPH_WIDTH * GLYPH_HEIGHT; i++) {
+        frame[i] = (glyph & (1u << (GLYPH_BITS - 1 - i))) ? level : 0;
+    }
+}
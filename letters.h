@@ -2,38 +2,46 @@
 #define LETTERS_H
 
 #include "pico/stdlib.h"
-#define NUM_LEDS 25
 
-// Declarations of the letters (A-Z)
-extern double A[NUM_LEDS];
-extern double B[NUM_LEDS];
-extern double C[NUM_LEDS];
-extern double D[NUM_LEDS];
-extern double E[NUM_LEDS];
-extern double F[NUM_LEDS];
-extern double G[NUM_LEDS];
-extern double H[NUM_LEDS];
-extern double I[NUM_LEDS];
-extern double J[NUM_LEDS];
-extern double K[NUM_LEDS];
-extern double L[NUM_LEDS];
-extern double M[NUM_LEDS];
-extern double N[NUM_LEDS];
-extern double O[NUM_LEDS];
-extern double P[NUM_LEDS];
-extern double Q[NUM_LEDS];
-extern double R[NUM_LEDS];
-extern double S[NUM_LEDS];
-extern double T[NUM_LEDS];
-extern double U[NUM_LEDS];
-extern double V[NUM_LEDS];
-extern double W[NUM_LEDS];
-extern double X[NUM_LEDS];
-extern double Y[NUM_LEDS];
-extern double Z[NUM_LEDS];
-extern double exclamation[NUM_LEDS];
-extern double dot[NUM_LEDS];
+#define GLYPH_WIDTH 5                          // Largura de cada glifo
+#define GLYPH_HEIGHT 5                         // Altura de cada glifo
+#define GLYPH_BITS (GLYPH_WIDTH * GLYPH_HEIGHT) // Bits usados por glifo
 
-extern double *letras_5x5[];
+// Fonte 5x5 de largura fixa em máscaras de 25 bits, indexada direto pelo código ASCII.
+// Gerada por font_compile.py (--ascii-5x5) a partir de font_5x5.bdf, junto com font_5x5
+// (font.h); caracteres sem glifo valem o substituto da fonte ('?'), como em font_find_glyph().
+// Por ser const, fica na flash.
+extern const uint32_t font_5x5_ascii[128];
+extern const uint32_t font_5x5_ascii_fallback;  // Glifo substituto, para bytes fora do ASCII
 
-#endif
\ No newline at end of file
+/**
+ * Retorna o glifo de um caractere em O(1).
+ * @param c Caractere ASCII (sem glifo ou fora da tabela, inclusive cada byte de um
+ *          caractere UTF-8, vira o substituto)
+ * @return Glifo 5x5 em bits
+ */
+static inline uint32_t glyph_for_char(char c) {
+    unsigned char code = (unsigned char)c;
+    return code < 128 ? font_5x5_ascii[code] : font_5x5_ascii_fallback;
+}
+
+/**
+ * Indica se um pixel do glifo está aceso.
+ * @param glyph Glifo 5x5 em bits
+ * @param row Linha (0 a 4)
+ * @param column Coluna (0 a 4)
+ * @return true se aceso
+ */
+static inline bool glyph_pixel(uint32_t glyph, int row, int column) {
+    return (glyph >> (GLYPH_BITS - 1 - (row * GLYPH_WIDTH + column))) & 1u;
+}
+
+/**
+ * Expande os bits de um glifo diretamente em um frame de brilho.
+ * @param glyph Glifo 5x5 em bits
+ * @param frame Frame de destino (25 posições)
+ * @param level Brilho dos pixels acesos (0 a 255)
+ */
+extern void render_glyph(uint32_t glyph, uint8_t *frame, uint8_t level);
+
+#endif
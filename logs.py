@@ -1,4 +1,5 @@
 import serial
+import struct
 import time
 import os
 
@@ -6,26 +7,157 @@ import os
 PORTA = 'COM7'           # Porta onde sua placa aparece no Windows
 BAUD = 115200            # Velocidade de comunicação (deve bater com o código C)
 ARQUIVO_LOG = 'logs_matriz_leds_rgb.txt'  # Nome do arquivo onde os logs serão salvos
+RESUMO_A_CADA = 10       # Registros de desempenho entre dois resumos (PERF_COUNTERS 1 no firmware)
 
-# CRIA O ARQUIVO DE LOG (ou anexa se já existir)
-if not os.path.exists(ARQUIVO_LOG):
-    with open(ARQUIVO_LOG, 'w') as f:
-        f.write("===== LOGS INICIADOS EM {} =====\n".format(time.strftime("%Y-%m-%d %H:%M:%S")))
-
-try:
-    with serial.Serial(PORTA, BAUD, timeout=1) as ser, open(ARQUIVO_LOG, 'a') as log_file:
-        print(f"📡 Conectado à porta {PORTA} — aguardando dados...\n(Pressione CTRL+C para parar)\n")
-        
-        while True:
-            linha = ser.readline().decode('utf-8', errors='ignore').strip()
-            if linha:
-                timestamp = time.strftime("[%Y-%m-%d %H:%M:%S]")
-                log = f"{timestamp} {linha}"
-                print(log)
-                log_file.write(log + '\n')
-                log_file.flush()
-
-except serial.SerialException:
-    print(f"❌ Erro: Não foi possível abrir a porta {PORTA}. Verifique se a placa está conectada.")
-except KeyboardInterrupt:
-    print("\n✅ Captura de logs finalizada pelo usuário.")
+# FORMATO DOS REGISTROS DE DESEMPENHO (ver perf_counters.h)
+SYNC = b'\xA5\x5A'
+TIPO_JANELA = 1
+TIPO_ACK = 2                           # Confirmação de frame recebido pela USB (usb_stream.h)
+CABECALHO = struct.Struct('<IHHHHB')   # tempo_ms, janela_ms, frames, perdidos, jitter_max_us, amostras
+AMOSTRA = struct.Struct('<HHH')        # render_us, conversao_us, espera_fifo_us
+
+
+class Estatisticas:
+    """Acumula as amostras e calcula mínimo, média e percentil 99."""
+
+    def __init__(self):
+        self.limpar()
+
+    def limpar(self):
+        self.fases = {'render': [], 'conversao': [], 'espera_fifo': []}
+        self.fps = []
+        self.perdidos = 0
+        self.jitter_max = 0
+
+    def adicionar(self, registro):
+        if registro['janela_ms']:
+            self.fps.append(registro['frames'] * 1000 / registro['janela_ms'])
+        self.perdidos += registro['perdidos']
+        self.jitter_max = max(self.jitter_max, registro['jitter_max_us'])
+        for render, conversao, espera in registro['amostras']:
+            self.fases['render'].append(render)
+            self.fases['conversao'].append(conversao)
+            self.fases['espera_fifo'].append(espera)
+
+    def resumo(self):
+        linhas = []
+        for nome, valores in self.fases.items():
+            if valores:
+                ordenados = sorted(valores)
+                p99 = ordenados[min(len(ordenados) - 1, int(len(ordenados) * 0.99))]
+                linhas.append(f"{nome:12} min {ordenados[0]:6} µs  média {sum(valores) / len(valores):9.1f} µs  "
+                              f"p99 {p99:6} µs  ({len(valores)} frames)")
+        if self.fps:
+            linhas.append(f"{'fps':12} min {min(self.fps):6.1f}     média {sum(self.fps) / len(self.fps):9.1f}")
+        linhas.append(f"{'perdidos':12} {self.perdidos}   jitter máximo {self.jitter_max} µs")
+        return linhas
+
+
+def decodificar_registro(tipo, payload):
+    """Converte o payload de um registro (janela de desempenho ou confirmação) em dicionário."""
+    if tipo == TIPO_ACK and len(payload) == 2:
+        return {'tipo': 'ack', 'seq': payload[0], 'status': payload[1]}
+    if tipo != TIPO_JANELA or len(payload) < CABECALHO.size:
+        return None
+    tempo_ms, janela_ms, frames, perdidos, jitter, quantidade = CABECALHO.unpack_from(payload)
+    if len(payload) != CABECALHO.size + quantidade * AMOSTRA.size:
+        return None
+    amostras = [AMOSTRA.unpack_from(payload, CABECALHO.size + i * AMOSTRA.size) for i in range(quantidade)]
+    return {'tipo': 'perf', 'tempo_ms': tempo_ms, 'janela_ms': janela_ms, 'frames': frames, 'perdidos': perdidos,
+            'jitter_max_us': jitter, 'amostras': amostras}
+
+
+def separar(buffer):
+    """
+    Retira do buffer as linhas de texto e os registros binários completos.
+    Retorna (itens, resto): itens são ('texto', str), ('perf', dict) ou ('ack', dict).
+    """
+    itens = []
+    while buffer:
+        inicio = buffer.find(SYNC)
+        fim_linha = buffer.find(b'\n')
+
+        # Texto antes do próximo registro
+        if inicio != 0:
+            limite = inicio if inicio > 0 else len(buffer)
+            if 0 <= fim_linha < limite:
+                itens.append(('texto', buffer[:fim_linha].decode('utf-8', errors='ignore').strip()))
+                buffer = buffer[fim_linha + 1:]
+                continue
+            if inicio < 0:
+                break  # Linha ainda incompleta
+            itens.append(('texto', buffer[:inicio].decode('utf-8', errors='ignore').strip()))
+            buffer = buffer[inicio:]
+
+        # Registro: sync, tipo, tamanho, payload, checksum
+        if len(buffer) < 5:
+            break
+        tipo = buffer[2]
+        tamanho = buffer[3] | (buffer[4] << 8)
+        if len(buffer) < 5 + tamanho + 1:
+            break
+        corpo = buffer[2:5 + tamanho]
+        registro = decodificar_registro(tipo, buffer[5:5 + tamanho])
+        if registro is not None and sum(corpo) & 0xFF == buffer[5 + tamanho]:
+            itens.append((registro['tipo'], registro))
+            buffer = buffer[5 + tamanho + 1:]
+        else:
+            buffer = buffer[1:]  # Falso sync: continua procurando
+    return [item for item in itens if item[1]], buffer
+
+
+def registrar(log_file, texto):
+    timestamp = time.strftime("[%Y-%m-%d %H:%M:%S]")
+    log = f"{timestamp} {texto}"
+    print(log)
+    log_file.write(log + '\n')
+    log_file.flush()
+
+
+def main():
+    # CRIA O ARQUIVO DE LOG (ou anexa se já existir)
+    if not os.path.exists(ARQUIVO_LOG):
+        with open(ARQUIVO_LOG, 'w') as f:
+            f.write("===== LOGS INICIADOS EM {} =====\n".format(time.strftime("%Y-%m-%d %H:%M:%S")))
+
+    janela = Estatisticas()   # Desde o último resumo
+    total = Estatisticas()    # Desde o início da captura
+    registros = 0
+
+    try:
+        with serial.Serial(PORTA, BAUD, timeout=1) as ser, open(ARQUIVO_LOG, 'a') as log_file:
+            print(f"📡 Conectado à porta {PORTA} — aguardando dados...\n(Pressione CTRL+C para parar)\n")
+            buffer = b''
+
+            while True:
+                buffer += ser.read(ser.in_waiting or 1)
+                itens, buffer = separar(buffer)
+
+                for tipo, conteudo in itens:
+                    if tipo == 'texto':
+                        registrar(log_file, conteudo)
+                        continue
+                    if tipo != 'perf':
+                        continue
+
+                    janela.adicionar(conteudo)
+                    total.adicionar(conteudo)
+                    registros += 1
+                    if registros % RESUMO_A_CADA == 0:
+                        registrar(log_file, f"📊 DESEMPENHO (últimos {RESUMO_A_CADA} registros)")
+                        for linha in janela.resumo():
+                            registrar(log_file, "   " + linha)
+                        janela.limpar()
+
+    except serial.SerialException:
+        print(f"❌ Erro: Não foi possível abrir a porta {PORTA}. Verifique se a placa está conectada.")
+    except KeyboardInterrupt:
+        if registros:
+            print(f"\n📊 DESEMPENHO TOTAL ({registros} registros)")
+            for linha in total.resumo():
+                print("   " + linha)
+        print("\n✅ Captura de logs finalizada pelo usuário.")
+
+
+if __name__ == '__main__':
+    main()
@@ -8,12 +8,33 @@
 #include "frames.h"              // Animações ou quadros predefinidos
 #include "letters.h"             // Letras para a rolagem de texto
 #include "led_functions.h"       // Funções de controle de LED
+#include "led_dma.h"             // Envio de frames por DMA
+#include "scheduler.h"           // Escalonador de animações por deadline
+#include "output_core.h"         // Saída dos LEDs no núcleo 1
+#include "framebuffer.h"         // Framebuffer persistente com envio só quando muda
+#include "benchmark.h"           // Medição do caminho de renderização
+#include "perf_counters.h"       // Contadores por frame (PERF_COUNTERS)
+#include "usb_stream.h"          // Frames recebidos pela USB
+#include "animation.h"           // Player de animações compactadas na flash
+#include "animations.h"          // Animações geradas por anim_encode.py
+#include "scroll.h"              // Rolagem de texto por máscaras de bits
+#include "message_cache.h"       // Cache das mensagens já montadas
+#include "input.h"               // Bordas dos botões, debounce e gestos
+#include "mode_machine.h"        // Troca de modo pelos eventos dos botões
+#include "effects.h"             // Efeitos procedurais em inteiros
+#include "transition.h"          // Transições entre o frame antigo e o novo
 
 // === CONFIGURAÇÕES DO SISTEMA ===
 #define SYS_CLOCK_KHZ 128000     // Clock do sistema definido para 128 MHz
 #define INTENSITY 0.1            // Intensidade dos LEDs (0.0 a 1.0)
 #define SPEED 150                // Velocidade da rolagem de texto em milissegundos
-#define DEBOUNCE_TIME_MS 400     // Tempo de espera para evitar múltiplos cliques no botão
+#define MESSAGE_DIRECTION SCROLL_UP   // Sentido da rolagem: SCROLL_LEFT, SCROLL_RIGHT, SCROLL_UP ou SCROLL_DOWN
+#define MESSAGE_SPACING TEXT_SPACING  // Linhas vazias entre letras (0 a SCROLL_MAX_SPACING)
+#define DEMO_SPEED 500           // Tempo de cada cor do modo demo em milissegundos
+#define IDLE_PERIOD_MS 2000      // Período de atualização dos LEDs de canto em repouso
+#define EFFECT_DURATION_MS 10000 // Tempo de cada efeito antes de voltar ao repouso
+#define MODE_TRANSITION TRANSITION_CROSSFADE  // Troca de modo: TRANSITION_CUT, _CROSSFADE, _WIPE_RIGHT/LEFT/DOWN/UP ou _DISSOLVE
+#define MODE_TRANSITION_FRAMES 30     // Duração da transição em frames de TRANSITION_FPS (30 = meio segundo)
 #define PHRASE "VIRTUS CC"       // Frase que será exibida na matriz de LEDs
 #define COLOR_LED_R 100          // Valor do canal vermelho
 #define COLOR_LED_G 156          // Valor do canal verde
@@ -21,6 +42,13 @@
 #define BUTTONA_PIN 5            // GPIO do botão A
 #define BUTTONB_PIN 6            // GPIO do botão B
 #define OUT_PIN 7                // GPIO de saída para o PIO
+#define DUAL_CORE_OUTPUT 0       // 1: núcleo 1 converte e envia os frames; núcleo 0 só renderiza
+#define GAMMA_DITHER 0           // 1: núcleo 1 aplica gama e dithering temporal, reenviando o frame (requer DUAL_CORE_OUTPUT)
+#define BENCHMARK_MODE 0         // 1: executa os benchmarks no boot e envia o CSV pela USB
+
+#if GAMMA_DITHER && !DUAL_CORE_OUTPUT
+#error "GAMMA_DITHER precisa do laço de saída do núcleo 1 (DUAL_CORE_OUTPUT 1)"
+#endif
 
 // === FUNÇÃO DE INICIALIZAÇÃO DA MATRIZ COM PIO ===
 bool matrix_init(PIO *pio, uint *sm, uint *offset)
@@ -31,11 +59,17 @@ bool matrix_init(PIO *pio, uint *sm, uint *offset)
         return false;
     }
 
+    // Pré-calcula o mapeamento da cadeia de LEDs (geometria de matrix_config.h)
+    if (!matrix_geometry_init(NULL))
+    {
+        return false;
+    }
+
     // Seleciona o PIO0
     *pio = pio0;
 
     // Carrega o programa PIO na memória e obtém o offset
-    *offset = pio_add_program(*pio, &main_program);
+    *offset = pio_add_program(*pio, &LED_PROGRAM);
 
     // Reivindica um state machine disponível
     *sm = pio_claim_unused_sm(*pio, true);
@@ -47,45 +81,45 @@ bool matrix_init(PIO *pio, uint *sm, uint *offset)
     }
 
     // Inicializa o programa PIO com os parâmetros definidos
-    main_program_init(*pio, *sm, *offset, OUT_PIN);
+    LED_PROGRAM_INIT(*pio, *sm, *offset, OUT_PIN);
+
+#if DUAL_CORE_OUTPUT
+    // Núcleo 1 fica com a conversão e o envio (DMA configurado por ele)
+    output_core_set_dither(GAMMA_DITHER);
+    output_core_start(*pio, *sm);
+#else
+    // Liga o DMA ao TX FIFO; sem canal livre, o envio continua bloqueante
+    led_dma_init(*pio, *sm);
+#endif
 
     return true;
 }
 
 // === VARIÁVEIS DE CONTROLE GLOBAL ===
-volatile bool demo_active = false;     // Ativa o modo demo
-volatile bool message_active = false;  // Ativa o modo de mensagem
 PIO pio;       // PIO selecionado
 uint sm, offset; // State machine e offset do programa PIO
 
-// === CALLBACK DO BOTÃO (INTERRUPÇÃO) ===
-void button_callback(uint gpio, uint32_t events)
-{
-    // Controle de debounce usando timestamp
-    static absolute_time_t last_time = {0};
-    absolute_time_t now = get_absolute_time();
+// === ANIMAÇÕES EM ANDAMENTO (executadas passo a passo pelo escalonador) ===
+static Mode current_mode = MODE_IDLE;
+static DemoAnimation demo_anim;
+static ScrollAnimation message_anim;
+static AnimationPlayer animation_player;
+static Effect effect;
+static EffectType next_effect = EFFECT_RAINBOW;
 
-    // Ignora se o tempo entre cliques for menor que o limite
-    if (absolute_time_diff_us(last_time, now) / 1000 < DEBOUNCE_TIME_MS)
-    {
-        return;
-    }
-
-    last_time = now;
+// === MODO REPOUSO: LEDS DE CANTO ===
+static bool idle_step(void *state)
+{
+    // Desenha LEDs nos cantos da matriz com cores diferentes
+    framebuffer_set_pixel(0, 0, (RGBColor8){255, 0, 0});                                // LED vermelho no canto
+    framebuffer_set_pixel(MATRIX_WIDTH - 1, 0, (RGBColor8){0, 255, 0});                 // LED verde
+    framebuffer_set_pixel(0, MATRIX_HEIGHT - 1, (RGBColor8){0, 0, 255});                // LED azul
+    framebuffer_set_pixel(MATRIX_WIDTH - 1, MATRIX_HEIGHT - 1, (RGBColor8){255, 255, 0}); // LED amarelo
 
-    // Botão B ativa o modo de mensagem
-    if ((gpio == BUTTONB_PIN) && (events & GPIO_IRQ_EDGE_FALL))
-    {
-        demo_active = false;
-        message_active = true;
-    }
+    // Só envia quando algo mudou: em repouso o barramento fica parado
+    framebuffer_commit(pio, sm, intensity_to_fixed(0.1));
 
-    // Botão A ativa o modo demo
-    if ((gpio == BUTTONA_PIN) && (events & GPIO_IRQ_EDGE_FALL))
-    {
-        message_active = false;
-        demo_active = true;
-    }
+    return true; // Repouso nunca termina sozinho
 }
 
 // === MODO DEMO: MOSTRA UMA ANIMAÇÃO PRÉ-DEFINIDA ===
@@ -95,10 +129,12 @@ void demo_test()
     printf("VALOR DO pio: %p\n", (void *)pio);
     printf("VALOR DO sm: %d\n", sm);
     printf("VALOR DA INTENSIDADE: 1.0\n\n");
-    sleep_ms(1000);
 
-    // Função que mostra a animação (implementada em frames.h/.c)
-    show_demo1(pio, sm, 500);
+    // Inicia a animação; o laço principal executa um frame por deadline
+    current_mode = MODE_DEMO;
+    transition_start(MODE_TRANSITION, MODE_TRANSITION_FRAMES);
+    demo_animation_init(&demo_anim, pio, sm);
+    scheduler_start(&(Animation){demo_animation_step, &demo_anim, DEMO_SPEED * 1000});
 }
 
 // === MODO MENSAGEM: MOSTRA TEXTO EM ROLAGEM NA MATRIZ ===
@@ -110,11 +146,112 @@ void message_test(RGBColor message_color)
     printf("VALOR DO pio: %p\n", (void *)pio);
     printf("VALOR DO sm: %d\n", sm);
     printf("VALOR DA INTENSIDADE: %.1f\n", INTENSITY);
-    printf("VELOCIDADE DA MENSAGEM: %d ms\n\n", SPEED);
-    sleep_ms(1000);
+    printf("VELOCIDADE DA MENSAGEM: %d ms\n", SPEED);
 
-    // Mostra a mensagem configurada rolando na matriz de LEDs
-    show_message(PHRASE, message_color, pio, sm, INTENSITY, SPEED);
+    // Inicia a rolagem da mensagem configurada
+    current_mode = MODE_MESSAGE;
+    transition_start(MODE_TRANSITION, MODE_TRANSITION_FRAMES);
+    scroll_animation_init(&message_anim, PHRASE, MESSAGE_DIRECTION, MESSAGE_SPACING, message_color, pio, sm, INTENSITY);
+    scheduler_start(&(Animation){scroll_animation_step, &message_anim, SPEED * 1000});
+
+    // A partir da segunda vez a frase vem pronta do cache
+    MessageCacheStats cache;
+    message_cache_stats(&cache);
+    printf("CACHE DE MENSAGENS: %lu ACERTOS %lu FALHAS %lu ENTRADAS %lu/%lu PALAVRAS\n\n", (unsigned long)cache.hits,
+           (unsigned long)cache.misses, (unsigned long)cache.entries, (unsigned long)cache.used_words,
+           (unsigned long)cache.arena_words);
+}
+
+// === MODO ANIMAÇÃO: TOCA UMA ANIMAÇÃO GRAVADA NA FLASH ===
+bool animation_test()
+{
+    printf("VOCÊ ENTROU NO MODO DE ANIMAÇÃO\n");
+    printf("TAMANHO DA ANIMAÇÃO: %lu bytes\n\n", (unsigned long)anim_pulse_size);
+
+    // Animação gerada para outro tamanho de matriz: pula o modo
+    if (!animation_open(&animation_player, anim_pulse, anim_pulse_size, pio, sm, intensity_to_fixed(INTENSITY), 1))
+    {
+        printf("ANIMAÇÃO INVÁLIDA PARA ESTA MATRIZ\n\n");
+        return false;
+    }
+
+    // O primeiro frame sai já; os seguintes usam a duração gravada em cada um
+    current_mode = MODE_ANIMATION;
+    transition_start(MODE_TRANSITION, MODE_TRANSITION_FRAMES);
+    scheduler_start(&(Animation){animation_step, &animation_player, 0});
+    return true;
+}
+
+// === MODO EFEITO: UM EFEITO PROCEDURAL POR VEZ, EM SEQUÊNCIA ===
+void effect_test()
+{
+    printf("VOCÊ ENTROU NO MODO DE EFEITOS\n");
+    printf("EFEITO: %s\n", effect_info(next_effect)->name);
+    printf("ORÇAMENTO: %lu ciclos por frame a %d fps\n\n", (unsigned long)effect_budget_cycles(next_effect), EFFECT_FPS);
+
+    // Cada entrada no modo passa para o próximo efeito
+    current_mode = MODE_EFFECT;
+    transition_start(MODE_TRANSITION, MODE_TRANSITION_FRAMES);
+    effect_init(&effect, next_effect, (RGBColor8){COLOR_LED_R, COLOR_LED_G, COLOR_LED_B},
+                EFFECT_DURATION_MS * EFFECT_FPS / 1000, pio, sm, intensity_to_fixed(INTENSITY));
+    next_effect = (EffectType)((next_effect + 1) % EFFECT_COUNT);
+
+    // As outras animações escrevem direto nos LEDs: o primeiro frame sempre é enviado
+    framebuffer_invalidate();
+    scheduler_start(&(Animation){effect_step, &effect, EFFECT_PERIOD_US});
+}
+
+// === MODO REPOUSO ===
+void idle_test()
+{
+    const SchedulerStats *stats = scheduler_get_stats();
+    printf("FRAMES: %lu DESCARTADOS: %lu ATRASOS: %lu JITTER MAX: %lu us\n\n",
+           (unsigned long)stats->frames, (unsigned long)stats->skipped,
+           (unsigned long)stats->overruns, (unsigned long)stats->max_jitter_us);
+
+    // As animações escreveram direto nos LEDs: redesenha o repouso do zero
+    current_mode = MODE_IDLE;
+    transition_start(MODE_TRANSITION, MODE_TRANSITION_FRAMES);
+    framebuffer_fill((RGBColor8){0, 0, 0});
+    framebuffer_invalidate();
+    scheduler_start(&(Animation){idle_step, NULL, IDLE_PERIOD_MS * 1000});
+}
+
+// === MODO STREAMING: FRAMES ENVIADOS PELO HOST VIA USB ===
+void stream_test()
+{
+    printf("VOCÊ ENTROU NO MODO STREAMING\n\n");
+
+    // Os frames chegam no ritmo do host: nenhuma animação local nem transição
+    current_mode = MODE_STREAM;
+    transition_start(TRANSITION_CUT, 0);
+    scheduler_stop();
+}
+
+// === ENTRADA EM UM MODO ESCOLHIDO PELOS BOTÕES ===
+void enter_mode(Mode mode, RGBColor message_color)
+{
+    switch (mode)
+    {
+    case MODE_DEMO:
+        demo_test();
+        break;
+    case MODE_MESSAGE:
+        message_test(message_color);
+        break;
+    case MODE_ANIMATION:
+        if (!animation_test()) idle_test();
+        break;
+    case MODE_STREAM:
+        stream_test();
+        break;
+    case MODE_EFFECT:
+        effect_test();
+        break;
+    default:
+        idle_test();
+        break;
+    }
 }
 
 // === FUNÇÃO PRINCIPAL ===
@@ -122,17 +259,9 @@ int main()
 {
     stdio_init_all(); // Inicializa USB serial (debug)
 
-    // === Configuração do botão A ===
-    gpio_init(BUTTONA_PIN);
-    gpio_set_dir(BUTTONA_PIN, GPIO_IN);
-    gpio_pull_up(BUTTONA_PIN);
-    gpio_set_irq_enabled_with_callback(BUTTONA_PIN, GPIO_IRQ_EDGE_FALL, true, &button_callback);
-
-    // === Configuração do botão B ===
-    gpio_init(BUTTONB_PIN);
-    gpio_set_dir(BUTTONB_PIN, GPIO_IN);
-    gpio_pull_up(BUTTONB_PIN);
-    gpio_set_irq_enabled(BUTTONB_PIN, GPIO_IRQ_EDGE_FALL, true);
+    // === Configuração dos botões (índices MODE_BUTTON_A e MODE_BUTTON_B) ===
+    static const uint button_pins[] = {BUTTONA_PIN, BUTTONB_PIN};
+    input_init(button_pins, count_of(button_pins));
 
     // Inicializa a matriz com PIO
     if (!matrix_init(&pio, &sm, &offset))
@@ -143,25 +272,86 @@ int main()
     // Define a cor da mensagem
     RGBColor message_color = {COLOR_LED_R, COLOR_LED_G, COLOR_LED_B};
 
+#if BENCHMARK_MODE
+    sleep_ms(2000); // Dá tempo do terminal USB conectar antes do CSV
+    benchmark_run_all(stdout);
+#endif
+
     printf("INICIO DOS TESTES\n\n");
 
-    // Mostra a animação de demo e a frase uma vez no boot
+    // Mostra a animação de demo, a frase e a animação da flash uma vez no boot
+    bool boot_sequence = true;
+    uint64_t stream_last_us = 0;
     demo_test();
-    message_test(message_color);
-
-    printf("TESTES FINALIZADOS\n\n");
-
-    sleep_ms(10); // Delay leve
 
     // === LOOP PRINCIPAL ===
     while (1)
     {
-        // Adiciona LEDs nos cantos da matriz com cores diferentes
-        add_led(0, (RGBColor){255, 0, 0}, pio, sm, 0.1);     // LED vermelho no canto
-        add_led(4, (RGBColor){0, 255, 0}, pio, sm, 0.1);     // LED verde
-        add_led(20, (RGBColor){0, 0, 255}, pio, sm, 0.1);    // LED azul
-        add_led(24, (RGBColor){255, 255, 0}, pio, sm, 0.1);  // LED amarelo
+        // Troca de modo pelos botões: vale já no próximo frame, interrompendo a animação atual
+        InputEvent event;
+        Mode next;
+        while (input_poll(time_us_32(), &event))
+        {
+            if (mode_dispatch(current_mode, &event, &next))
+            {
+                boot_sequence = false;
+                enter_mode(next, message_color);
+            }
+        }
+
+        // Frames recebidos pela USB interrompem a animação atual
+        if (usb_stream_poll(pio, sm))
+        {
+            if (current_mode != MODE_STREAM)
+            {
+                boot_sequence = false;
+                stream_test();
+            }
+            stream_last_us = time_us_64();
+        }
+
+        if (current_mode == MODE_STREAM)
+        {
+            // Host parou de enviar: volta ao repouso
+            if (time_us_64() - stream_last_us > USB_STREAM_TIMEOUT_MS * 1000ull)
+            {
+                const UsbStreamStats *stream = usb_stream_get_stats();
+                printf("FRAMES RECEBIDOS: %lu ERROS DE CRC: %lu ERROS DE TAMANHO: %lu\n",
+                       (unsigned long)stream->frames, (unsigned long)stream->crc_errors,
+                       (unsigned long)stream->length_errors);
+                idle_test();
+            }
+        }
+        // Executa o frame da animação se o deadline chegou
+        else if (!scheduler_poll())
+        {
+            // Animação terminou: segue a sequência de boot ou volta ao repouso
+            if (boot_sequence && current_mode == MODE_DEMO)
+            {
+                message_test(message_color);
+            }
+            else if (boot_sequence && current_mode == MODE_MESSAGE && animation_test())
+            {
+                // Animação da flash iniciada; o repouso vem quando ela terminar
+            }
+            else
+            {
+                if (boot_sequence)
+                {
+                    printf("TESTES FINALIZADOS\n\n");
+                    boot_sequence = false;
+                }
+                idle_test();
+            }
+        }
+
+        // Modos lentos não seguram a transição: a mistura é reenviada no ritmo de TRANSITION_FPS
+        transition_poll(pio, sm);
+
+        // Envia o registro dos contadores quando a janela fecha (sem efeito com PERF_COUNTERS 0)
+        perf_poll();
 
-        sleep_ms(2000); // Delay para não congestionar a CPU
+        // Dorme até a próxima interrupção (alarme do deadline, do gesto ou da transição, ou borda de botão)
+        __wfe();
     }
 }
@@ -0,0 +1,35 @@
+#ifndef MATRIX_CONFIG_H
+#define MATRIX_CONFIG_H
+
+// === CONFIGURAÇÃO DA MATRIZ ===
+// Valores padrão para a matriz 5x5 da BitDogLab. Podem ser trocados no CMake,
+// por exemplo: target_compile_definitions(main PRIVATE MATRIX_WIDTH=16 MATRIX_HEIGHT=16)
+
+#ifndef MATRIX_WIDTH
+#define MATRIX_WIDTH 5                   // Colunas da matriz
+#endif
+
+#ifndef MATRIX_HEIGHT
+#define MATRIX_HEIGHT 5                  // Linhas da matriz
+#endif
+
+#define NUM_LEDS (MATRIX_WIDTH * MATRIX_HEIGHT) // Número total de LEDs na matriz
+
+// Ligação padrão (ver MatrixGeometry em matrix_geometry.h)
+#ifndef MATRIX_SERPENTINE
+#define MATRIX_SERPENTINE 1              // 1: linhas alternam o sentido (zigzag); 0: todas no mesmo sentido
+#endif
+
+#ifndef MATRIX_ROTATION
+#define MATRIX_ROTATION 180              // Rotação da cadeia em relação à imagem: 0, 90, 180 ou 270 graus
+#endif
+
+#ifndef MATRIX_FLIP_X
+#define MATRIX_FLIP_X 0                  // Espelha a cadeia horizontalmente
+#endif
+
+#ifndef MATRIX_FLIP_Y
+#define MATRIX_FLIP_Y 0                  // Espelha a cadeia verticalmente
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+#include "matrix_geometry.h"
+
+uint16_t matrix_map[NUM_LEDS];
+uint16_t matrix_unmap[NUM_LEDS];
+
+/**
+ * Calcula a tabela de mapeamento a partir da geometria
+ * @param geometry Geometria desejada (NULL = padrão da configuração)
+ * @return true em caso de sucesso
+ */
+bool matrix_geometry_init(const MatrixGeometry *geometry) {
+    static const MatrixGeometry defaults = {
+        MATRIX_SERPENTINE, MATRIX_ROTATION, MATRIX_FLIP_X, MATRIX_FLIP_Y
+    };
+    if (!geometry) geometry = &defaults;
+
+    // Dimensões da grade da cadeia: trocadas quando a rotação é de 90 ou 270 graus
+    bool transposed = geometry->rotation == 90 || geometry->rotation == 270;
+    int chain_width = transposed ? MATRIX_HEIGHT : MATRIX_WIDTH;
+    int chain_height = transposed ? MATRIX_WIDTH : MATRIX_HEIGHT;
+
+    if (geometry->rotation % 90 != 0 || geometry->rotation >= 360) return false;
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        // Posição do LED na grade da cadeia
+        int r = i / chain_width;
+        int c = i % chain_width;
+
+        // Serpentina: linhas ímpares percorridas no sentido inverso
+        if (geometry->serpentine && (r & 1)) c = chain_width - 1 - c;
+
+        if (geometry->flip_x) c = chain_width - 1 - c;
+        if (geometry->flip_y) r = chain_height - 1 - r;
+
+        // Rotação horária da grade da cadeia para a imagem
+        int x, y;
+        switch (geometry->rotation) {
+            case 90:  x = chain_height - 1 - r; y = c;                    break;
+            case 180: x = chain_width - 1 - c;  y = chain_height - 1 - r; break;
+            case 270: x = r;                    y = chain_width - 1 - c;  break;
+            default:  x = c;                    y = r;                    break;
+        }
+
+        matrix_map[i] = (uint16_t)(y * MATRIX_WIDTH + x);
+        matrix_unmap[y * MATRIX_WIDTH + x] = (uint16_t)i;
+    }
+
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef MATRIX_GEOMETRY_H
+#define MATRIX_GEOMETRY_H
+
+#include "pico/stdlib.h"
+#include "matrix_config.h"
+
+/**
+ * Geometria da matriz: como a cadeia de LEDs percorre o painel.
+ * A cadeia é vista como uma grade em que o LED 0 está na coluna 0 da linha 0 e
+ * cada linha tem a largura do painel na orientação da cadeia. Os espelhamentos são
+ * aplicados nessa grade e a rotação (horária) leva a grade para a imagem lógica.
+ * O padrão da BitDogLab (LED 0 no canto inferior direito, zigzag) é serpentina + 180°.
+ */
+typedef struct {
+    bool serpentine;   // Linhas ímpares da cadeia no sentido inverso
+    uint16_t rotation; // 0, 90, 180 ou 270 graus
+    bool flip_x;       // Espelha as colunas da cadeia
+    bool flip_y;       // Espelha as linhas da cadeia
+} MatrixGeometry;
+
+// Tabela índice na cadeia (fio) -> índice lógico (linha a linha na imagem)
+extern uint16_t matrix_map[NUM_LEDS];
+
+// Tabela inversa: índice lógico -> índice na cadeia
+extern uint16_t matrix_unmap[NUM_LEDS];
+
+/**
+ * Pré-calcula a tabela de mapeamento. Deve ser chamada antes do primeiro frame.
+ * Rotações de 90 e 270 graus exigem que a cadeia tenha MATRIX_HEIGHT colunas.
+ * @param geometry Geometria desejada (NULL usa a configuração de matrix_config.h)
+ * @return false se a rotação não for válida
+ */
+extern bool matrix_geometry_init(const MatrixGeometry *geometry);
+
+/**
+ * Mapeia índice na cadeia para índice lógico: uma leitura de tabela.
+ * @param index Índice do LED na cadeia (0 a NUM_LEDS - 1)
+ * @return Índice lógico correspondente na imagem
+ */
+static inline int map_index_to_position(int index) {
+    return matrix_map[index];
+}
+
+/**
+ * Mapeia índice lógico para índice na cadeia: uma leitura de tabela.
+ * Útil para quem gera o frame percorrendo a imagem e escreve direto nas palavras do fio.
+ * @param position Índice lógico na imagem (0 a NUM_LEDS - 1)
+ * @return Índice do LED na cadeia
+ */
+static inline int map_position_to_index(int position) {
+    return matrix_unmap[position];
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include <string.h>
+#include "message_cache.h"
+
+typedef struct {
+    uint32_t hash;                       // FNV-1a do texto
+    const Font *font;                    // Fonte da montagem
+    uint32_t layout;                     // Eixo e espaçamento da montagem
+    uint32_t last_used;                  // Instante do último uso (relógio do cache)
+    uint16_t offset;                     // Primeira palavra na arena
+    uint16_t count;                      // Linhas de máscara
+    uint16_t text_bytes;                 // Bytes do texto, com o terminador
+    uint16_t words;                      // Palavras ocupadas: máscaras + texto
+} CacheEntry;
+
+// === ARENA E ÍNDICE (entradas em ordem de offset, sem buracos entre elas) ===
+static uint32_t arena[MESSAGE_CACHE_WORDS];
+static CacheEntry entries[MESSAGE_CACHE_ENTRIES];
+static int entry_count = 0;
+static uint32_t used_words = 0;
+static uint32_t use_clock = 0;
+static uint32_t hits = 0, misses = 0, evictions = 0;
+
+/**
+ * Hash FNV-1a de 32 bits e tamanho do texto
+ * @param text Texto
+ * @param bytes Bytes do texto, com o terminador
+ * @return Hash
+ */
+static uint32_t message_hash(const char *text, uint32_t *bytes) {
+    uint32_t hash = 2166136261u;
+    const uint8_t *c = (const uint8_t *)text;
+
+    for (; *c; c++) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+    *bytes = (uint32_t)(c - (const uint8_t *)text) + 1;
+    return hash;
+}
+
+/**
+ * Texto guardado de uma entrada (depois das máscaras)
+ * @param entry Entrada
+ * @return Texto
+ */
+static inline const char *entry_text(const CacheEntry *entry) {
+    return (const char *)&arena[entry->offset + entry->count];
+}
+
+/**
+ * Procura a entrada de uma chave; o texto é comparado, então colisões de hash não trazem a mensagem errada
+ * @param text Texto
+ * @param hash Hash do texto
+ * @param bytes Bytes do texto
+ * @param font Fonte
+ * @param layout Eixo e espaçamento
+ * @return Índice ou -1
+ */
+static int message_cache_find(const char *text, uint32_t hash, uint32_t bytes, const Font *font, uint32_t layout) {
+    for (int i = 0; i < entry_count; i++) {
+        const CacheEntry *entry = &entries[i];
+        if (entry->hash == hash && entry->text_bytes == bytes && entry->font == font && entry->layout == layout &&
+            memcmp(entry_text(entry), text, bytes) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Descarta a entrada menos usada e fecha o buraco deixado na arena
+ */
+static void message_cache_evict(void) {
+    int victim = 0;
+    for (int i = 1; i < entry_count; i++) {
+        if ((int32_t)(entries[i].last_used - entries[victim].last_used) < 0) victim = i;
+    }
+
+    // Compacta: as entradas seguintes descem o tamanho da vítima
+    uint16_t gap = entries[victim].words;
+    uint16_t end = entries[victim].offset + gap;
+    memmove(&arena[entries[victim].offset], &arena[end], (used_words - end) * sizeof(uint32_t));
+    for (int i = victim + 1; i < entry_count; i++) {
+        entries[i].offset -= gap;
+        entries[i - 1] = entries[i];
+    }
+
+    entry_count--;
+    used_words -= gap;
+    evictions++;
+}
+
+/**
+ * Consulta o cache
+ * @param text Texto
+ * @param font Fonte
+ * @param layout Eixo e espaçamento
+ * @param lines Destino
+ * @param max_lines Capacidade
+ * @return Linhas ou -1
+ */
+int message_cache_get(const char *text, const Font *font, uint32_t layout, uint32_t *lines, int max_lines) {
+    uint32_t bytes;
+    uint32_t hash = message_hash(text, &bytes);
+    int index = message_cache_find(text, hash, bytes, font, layout);
+
+    if (index < 0 || entries[index].count > max_lines) {
+        misses++;
+        return -1;
+    }
+
+    CacheEntry *entry = &entries[index];
+    entry->last_used = ++use_clock;
+    memcpy(lines, &arena[entry->offset], entry->count * sizeof(uint32_t));
+    hits++;
+    return entry->count;
+}
+
+/**
+ * Guarda uma mensagem
+ * @param text Texto
+ * @param font Fonte
+ * @param layout Eixo e espaçamento
+ * @param lines Máscaras
+ * @param count Linhas
+ */
+void message_cache_put(const char *text, const Font *font, uint32_t layout, const uint32_t *lines, int count) {
+    uint32_t bytes;
+    uint32_t hash = message_hash(text, &bytes);
+    uint32_t words = (uint32_t)count + (bytes + 3) / 4;
+
+    // Grande demais para a arena (ou para os campos de 16 bits): a mensagem só não é guardada
+    if (count < 0 || words > MESSAGE_CACHE_WORDS || words > UINT16_MAX) return;
+    if (message_cache_find(text, hash, bytes, font, layout) >= 0) return;
+
+    while (entry_count == MESSAGE_CACHE_ENTRIES || used_words + words > MESSAGE_CACHE_WORDS) {
+        message_cache_evict();
+    }
+
+    // Nova entrada no fim da parte ocupada
+    CacheEntry *entry = &entries[entry_count++];
+    *entry = (CacheEntry){hash, font, layout, ++use_clock, (uint16_t)used_words, (uint16_t)count, (uint16_t)bytes,
+                          (uint16_t)words};
+    memcpy(&arena[used_words], lines, (size_t)count * sizeof(uint32_t));
+    memcpy(&arena[used_words + count], text, bytes);
+    used_words += words;
+}
+
+/**
+ * Esvazia o cache
+ */
+void message_cache_clear(void) {
+    entry_count = 0;
+    used_words = 0;
+    use_clock = 0;
+    hits = misses = evictions = 0;
+}
+
+/**
+ * Estatísticas do cache
+ * @param stats Saída
+ */
+void message_cache_stats(MessageCacheStats *stats) {
+    *stats = (MessageCacheStats){hits, misses, evictions, (uint32_t)entry_count, used_words, MESSAGE_CACHE_WORDS};
+}
@@ -0,0 +1,69 @@
+#ifndef MESSAGE_CACHE_H
+#define MESSAGE_CACHE_H
+
+#include "pico/stdlib.h"
+#include "font.h"
+
+/**
+ * Cache LRU de mensagens já renderizadas: as máscaras da rolagem (scroll.h) de
+ * cada texto ficam em uma arena estática, com a chave (hash do texto, fonte,
+ * eixo e espaçamento). Uma mensagem repetida volta com uma cópia das máscaras,
+ * sem decodificar UTF-8 nem consultar glifos. Sem malloc: quando falta espaço,
+ * as entradas menos usadas saem e as restantes são compactadas no começo da arena.
+ */
+
+#ifndef MESSAGE_CACHE_WORDS
+#define MESSAGE_CACHE_WORDS 2048         // Tamanho da arena em palavras de 32 bits (8 KB)
+#endif
+
+#if MESSAGE_CACHE_WORDS > 65535
+#error "Os offsets da arena têm 16 bits: MESSAGE_CACHE_WORDS deve ser no máximo 65535"
+#endif
+
+#ifndef MESSAGE_CACHE_ENTRIES
+#define MESSAGE_CACHE_ENTRIES 8          // Mensagens guardadas ao mesmo tempo
+#endif
+
+typedef struct {
+    uint32_t hits;                       // Consultas atendidas pela arena
+    uint32_t misses;                     // Consultas que precisaram montar a mensagem
+    uint32_t evictions;                  // Entradas descartadas para abrir espaço
+    uint32_t entries;                    // Entradas ocupadas
+    uint32_t used_words;                 // Palavras ocupadas na arena
+    uint32_t arena_words;                // Tamanho da arena (MESSAGE_CACHE_WORDS)
+} MessageCacheStats;
+
+/**
+ * Procura uma mensagem e copia as máscaras dela.
+ * @param text Texto UTF-8
+ * @param font Fonte usada na montagem
+ * @param layout Eixo e espaçamento da montagem (ver scroll.c)
+ * @param lines Destino das máscaras
+ * @param max_lines Capacidade de lines
+ * @return Linhas copiadas, ou -1 se a mensagem não estiver no cache
+ */
+extern int message_cache_get(const char *text, const Font *font, uint32_t layout, uint32_t *lines, int max_lines);
+
+/**
+ * Guarda as máscaras de uma mensagem, descartando as menos usadas se preciso.
+ * Mensagens maiores que a arena não são guardadas.
+ * @param text Texto UTF-8
+ * @param font Fonte usada na montagem
+ * @param layout Eixo e espaçamento da montagem
+ * @param lines Máscaras
+ * @param count Linhas
+ */
+extern void message_cache_put(const char *text, const Font *font, uint32_t layout, const uint32_t *lines, int count);
+
+/**
+ * Esvazia o cache e zera as estatísticas.
+ */
+extern void message_cache_clear(void);
+
+/**
+ * Estatísticas e ocupação atuais.
+ * @param stats Saída
+ */
+extern void message_cache_stats(MessageCacheStats *stats);
+
+#endif
@@ -0,0 +1,42 @@
+#include "mode_machine.h"
+
+// === TABELA DE TRANSIÇÕES (a primeira que casar com o evento vale) ===
+// Toque simples é INPUT_CLICK, e não INPUT_PRESS: o duplo clique e o toque longo
+// começam com o mesmo aperto e não devem passar antes pelo modo do toque simples
+static const ModeTransition transitions[] = {
+    {MODE_BUTTON_A, INPUT_CLICK, MODE_DEMO},
+    {MODE_BUTTON_B, INPUT_CLICK, MODE_MESSAGE},
+    {MODE_BUTTON_B, INPUT_DOUBLE_CLICK, MODE_ANIMATION},
+    {MODE_BUTTON_A, INPUT_DOUBLE_CLICK, MODE_EFFECT},
+    {MODE_BUTTON_A, INPUT_LONG_PRESS, MODE_IDLE},
+};
+
+static const char *const mode_names[MODE_COUNT] = {"REPOUSO", "DEMO", "MENSAGEM", "ANIMAÇÃO", "STREAMING", "EFEITO"};
+
+/**
+ * Transição de um evento
+ * @param current Modo atual
+ * @param event Evento
+ * @param next Novo modo
+ * @return true se há transição
+ */
+bool mode_dispatch(Mode current, const InputEvent *event, Mode *next) {
+    for (uint i = 0; i < count_of(transitions); i++) {
+        if (transitions[i].button == event->button && transitions[i].type == event->type) {
+            *next = transitions[i].target;
+            return true;
+        }
+    }
+
+    *next = current;
+    return false;
+}
+
+/**
+ * Nome do modo
+ * @param mode Modo
+ * @return Nome
+ */
+const char *mode_name(Mode mode) {
+    return mode < MODE_COUNT ? mode_names[mode] : "?";
+}
@@ -0,0 +1,52 @@
+#ifndef MODE_MACHINE_H
+#define MODE_MACHINE_H
+
+#include "pico/stdlib.h"
+#include "input.h"
+
+/**
+ * Máquina de modos do programa: os eventos dos botões (input.h) passam por uma
+ * tabela de transições e o modo escolhido substitui a animação em andamento no
+ * mesmo passo do laço principal, antes do próximo frame.
+ */
+
+#define MODE_BUTTON_A 0                  // Índice do botão A em input_init()
+#define MODE_BUTTON_B 1                  // Índice do botão B em input_init()
+
+typedef enum {
+    MODE_IDLE,                           // LEDs de canto
+    MODE_DEMO,                           // Cores pré-definidas
+    MODE_MESSAGE,                        // Frase em rolagem
+    MODE_ANIMATION,                      // Animação gravada na flash
+    MODE_STREAM,                         // Frames recebidos pela USB
+    MODE_EFFECT,                         // Efeitos procedurais (effects.h)
+    MODE_COUNT
+} Mode;
+
+typedef struct {
+    uint8_t button;                      // Botão do evento
+    InputEventType type;                 // Gesto
+    Mode target;                         // Modo que passa a valer
+} ModeTransition;
+
+/**
+ * Procura a transição de um evento na tabela padrão:
+ * A clique → demo, B clique → mensagem, B duplo clique → animação da flash,
+ * A duplo clique → próximo efeito, A toque longo → repouso. O clique simples só
+ * é reconhecido depois da janela do duplo clique, então cada gesto troca o modo uma vez.
+ * Eventos sem transição não mudam o modo.
+ * @param current Modo atual
+ * @param event Evento dos botões
+ * @param next Saída com o novo modo
+ * @return true se o evento troca (ou reinicia) o modo
+ */
+extern bool mode_dispatch(Mode current, const InputEvent *event, Mode *next);
+
+/**
+ * Nome do modo para o log.
+ * @param mode Modo
+ * @return Nome em maiúsculas
+ */
+extern const char *mode_name(Mode mode);
+
+#endif
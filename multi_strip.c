@@ -0,0 +1,193 @@
+#include "multi_strip.h"
+#include "led_dma.h"
+
+typedef struct {
+    PIO pio;         // Bloco PIO da fita
+    uint sm;         // State machine da fita
+    int channel;     // Canal DMA da fita
+    uint first_led;  // Início do segmento na cadeia
+    uint led_count;  // Tamanho do segmento
+} Strip;
+
+// === ESTADO DAS FITAS ===
+static Strip strips[MULTI_STRIP_MAX];
+static uint strip_count = 0;
+static uint32_t words[2][NUM_LEDS];    // Framebuffer de palavras compartilhado, com buffer duplo
+static uint back_index = 0;            // Buffer livre para o próximo frame
+static uint32_t sm_mask[2];            // State machines usados em pio0 e pio1
+static uint32_t dma_mask = 0;          // Canais DMA de todas as fitas
+static int program_offsets[2] = {-1, -1}; // Offset do programa em pio0 e pio1 (-1 se não carregado)
+
+/**
+ * Desfaz uma configuração, completa ou interrompida no meio: devolve os state
+ * machines e canais DMA reivindicados e remove os programas carregados
+ * @param count Fitas já configuradas por completo
+ */
+static void multi_strip_release(uint count) {
+    PIO blocks[2] = {pio0, pio1};
+
+    for (uint i = 0; i < count; i++) {
+        pio_sm_unclaim(strips[i].pio, strips[i].sm);
+        dma_channel_unclaim(strips[i].channel);
+    }
+    for (int b = 0; b < 2; b++) {
+        if (program_offsets[b] >= 0) pio_remove_program(blocks[b], &LED_PROGRAM, program_offsets[b]);
+        program_offsets[b] = -1;
+        sm_mask[b] = 0;
+    }
+    dma_mask = 0;
+    strip_count = 0;
+}
+
+/**
+ * Configura as fitas, sem habilitar os state machines
+ * @param configs Configuração das fitas
+ * @param count Quantidade de fitas
+ * @return true em caso de sucesso (em caso de falha nada fica reivindicado)
+ */
+bool multi_strip_init(const StripConfig *configs, uint count) {
+    PIO blocks[2] = {pio0, pio1};
+
+    // Uma configuração anterior é desfeita antes: o último frame termina e os state
+    // machines param antes de serem devolvidos
+    if (strip_count > 0) {
+        multi_strip_wait();
+        for (int b = 0; b < 2; b++) pio_set_sm_mask_enabled(blocks[b], sm_mask[b], false);
+    }
+    multi_strip_release(strip_count);
+
+    if (count == 0 || count > MULTI_STRIP_MAX) return false;
+
+    for (uint i = 0; i < count; i++) {
+        const StripConfig *config = &configs[i];
+        if (config->first_led + config->led_count > NUM_LEDS) {
+            multi_strip_release(i);
+            return false;
+        }
+
+        // Preenche pio0 primeiro e passa para pio1 quando acabarem os state machines
+        int block = -1, sm = -1;
+        for (int b = 0; b < 2 && sm < 0; b++) {
+            sm = pio_claim_unused_sm(blocks[b], false);
+            block = b;
+        }
+        if (sm < 0) {
+            multi_strip_release(i);
+            return false;
+        }
+
+        // Um único programa por bloco PIO, compartilhado pelos state machines
+        if (program_offsets[block] < 0) {
+            if (!pio_can_add_program(blocks[block], &LED_PROGRAM)) {
+                pio_sm_unclaim(blocks[block], sm);
+                multi_strip_release(i);
+                return false;
+            }
+            program_offsets[block] = pio_add_program(blocks[block], &LED_PROGRAM);
+        }
+
+        int channel = dma_claim_unused_channel(false);
+        if (channel < 0) {
+            pio_sm_unclaim(blocks[block], sm);
+            multi_strip_release(i);
+            return false;
+        }
+
+        Strip *strip = &strips[i];
+        strip->pio = blocks[block];
+        strip->sm = sm;
+        strip->channel = channel;
+        strip->first_led = config->first_led;
+        strip->led_count = config->led_count;
+
+        // Configura o state machine, mas só habilita na partida sincronizada
+        LED_PROGRAM_PREPARE(strip->pio, sm, program_offsets[block], config->pin);
+        sm_mask[block] |= 1u << sm;
+
+        dma_channel_config dma = dma_channel_get_default_config(channel);
+        channel_config_set_transfer_data_size(&dma, DMA_SIZE_32);
+        channel_config_set_read_increment(&dma, true);
+        channel_config_set_write_increment(&dma, false);
+        channel_config_set_dreq(&dma, pio_get_dreq(strip->pio, sm, true));
+        dma_channel_configure(channel, &dma, &strip->pio->txf[sm], NULL, 0, false);
+        dma_mask |= 1u << channel;
+    }
+
+    strip_count = count;
+
+    // Alinha a fase dos divisores de clock de cada bloco
+    for (int b = 0; b < 2; b++) {
+        if (sm_mask[b]) pio_clkdiv_restart_sm_mask(blocks[b], sm_mask[b]);
+    }
+
+    return true;
+}
+
+/**
+ * Indica se algum DMA ainda está alimentando uma fita
+ * @return true se ocupado
+ */
+bool multi_strip_is_busy(void) {
+    for (uint i = 0; i < strip_count; i++) {
+        if (dma_channel_is_busy(strips[i].channel)) return true;
+    }
+    return false;
+}
+
+/**
+ * Aguarda todas as fitas esvaziarem e travarem o frame
+ */
+void multi_strip_wait(void) {
+    while (multi_strip_is_busy()) {
+        tight_loop_contents();
+    }
+
+    for (uint i = 0; i < strip_count; i++) {
+        while (!pio_sm_is_tx_fifo_empty(strips[i].pio, strips[i].sm)) {
+            tight_loop_contents();
+        }
+    }
+
+    // Última palavra no registrador de saída + tempo de reset
+    sleep_us(LED_DMA_LATCH_US);
+}
+
+/**
+ * Converte o frame e dispara todas as fitas juntas
+ * @param pixels Pixels em ordem lógica
+ * @param intensity Intensidade em ponto fixo
+ */
+void multi_strip_submit(const RGBColor8 *pixels, uint16_t intensity) {
+    if (strip_count == 0) return;
+
+    // Converte no buffer livre enquanto o anterior ainda pode estar no fio
+    uint32_t *frame = words[back_index];
+    pack_pixels_fixed(pixels, intensity, frame);
+
+    multi_strip_wait();
+
+    // Para os state machines (parados no "out" sem dados, linha em nível baixo)
+    pio_set_sm_mask_enabled(pio0, sm_mask[0], false);
+    pio_set_sm_mask_enabled(pio1, sm_mask[1], false);
+
+    // Aponta cada canal para o seu segmento e pré-carrega os FIFOs
+    for (uint i = 0; i < strip_count; i++) {
+        Strip *strip = &strips[i];
+        dma_channel_set_read_addr(strip->channel, &frame[strip->first_led], false);
+        dma_channel_set_trans_count(strip->channel, strip->led_count, false);
+    }
+    dma_start_channel_mask(dma_mask);
+
+    // Espera cada FIFO ter dados (ou a fita já ter recebido tudo) antes de soltar os SMs
+    for (uint i = 0; i < strip_count; i++) {
+        while (pio_sm_is_tx_fifo_empty(strips[i].pio, strips[i].sm) && dma_channel_is_busy(strips[i].channel)) {
+            tight_loop_contents();
+        }
+    }
+
+    // Partida sincronizada: todos os SMs de um bloco no mesmo ciclo, os dois blocos em sequência
+    pio_enable_sm_mask_in_sync(pio0, sm_mask[0]);
+    pio_enable_sm_mask_in_sync(pio1, sm_mask[1]);
+
+    back_index ^= 1;
+}
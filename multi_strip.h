@@ -0,0 +1,50 @@
+#ifndef MULTI_STRIP_H
+#define MULTI_STRIP_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "led_functions.h"
+
+#define MULTI_STRIP_MAX 8                // pio0 e pio1, quatro state machines cada
+
+typedef struct {
+    uint pin;        // GPIO de dados da fita
+    uint first_led;  // Primeiro LED (índice na cadeia) do segmento desta fita
+    uint led_count;  // Quantidade de LEDs da fita
+} StripConfig;
+
+/**
+ * Distribui até MULTI_STRIP_MAX fitas entre os state machines de pio0 e pio1.
+ * Cada fita recebe um segmento do framebuffer compartilhado (índices da cadeia
+ * first_led .. first_led + led_count - 1) e um canal DMA próprio.
+ * Todas as fitas começam a transmitir juntas, então o tempo de atualização
+ * é o da maior fita, e não o da soma delas.
+ * Pode ser chamada de novo para trocar as fitas: a configuração anterior é desfeita
+ * antes (state machines, canais DMA e programas devolvidos).
+ * @param strips Configuração de cada fita
+ * @param count Quantidade de fitas (1 a MULTI_STRIP_MAX)
+ * @return false se faltar state machine, canal DMA ou memória de programa, ou se um segmento sair de NUM_LEDS
+ */
+extern bool multi_strip_init(const StripConfig *strips, uint count);
+
+/**
+ * Converte os pixels e dispara todas as fitas simultaneamente.
+ * Aguarda o frame anterior (incluindo o latch) antes de começar.
+ * @param pixels Pixels em ordem lógica (NUM_LEDS posições)
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ */
+extern void multi_strip_submit(const RGBColor8 *pixels, uint16_t intensity);
+
+/**
+ * Indica se alguma fita ainda está recebendo dados do DMA.
+ * @return true se há transferência em andamento
+ */
+extern bool multi_strip_is_busy(void);
+
+/**
+ * Bloqueia até todas as fitas terminarem o frame e travarem (latch).
+ */
+extern void multi_strip_wait(void);
+
+#endif
@@ -0,0 +1,137 @@
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "output_core.h"
+#include "led_dma.h"
+#include "gamma_dither.h"
+#include "transition.h"
+
+// === ESTADO DA SAÍDA NO NÚCLEO 1 ===
+static PIO output_pio;                 // PIO alimentado pelo núcleo 1
+static uint output_sm;                 // State machine alimentado pelo núcleo 1
+static volatile bool running = false;  // Núcleo 1 ativo
+static bool dither = false;            // Gama e dithering temporal com reenvio contínuo
+static uint32_t sent_words[NUM_LEDS];  // Último frame do envio bloqueante (origem das transições)
+
+/**
+ * Envia as palavras convertidas
+ * @param words Palavras G|R|B (buffer livre do DMA quando dma é true)
+ * @param dma Canal DMA disponível
+ */
+static void output_send(const uint32_t *words, bool dma) {
+    if (dma) {
+        led_dma_submit(NUM_LEDS);
+    } else {
+        for (int i = 0; i < NUM_LEDS; i++) {
+            sent_words[i] = words[i];
+            pio_sm_put_blocking(output_pio, output_sm, words[i]);
+        }
+    }
+}
+
+/**
+ * Laço do núcleo 1: converte e envia cada frame publicado pelo núcleo 0.
+ * Com dithering, a fila vazia não para a saída: o último frame é reenviado a
+ * GAMMA_DITHER_REFRESH_HZ para os acumuladores formarem os níveis intermediários.
+ */
+static void output_core_entry(void) {
+    // O DMA é configurado aqui para a IRQ de conclusão ser atendida no núcleo 1
+    bool dma = led_dma_init(output_pio, output_sm);
+    uint32_t local[NUM_LEDS];
+
+    static QueuedFrame last;           // Último frame recebido (reenviado com dithering)
+    static DitherState dither_state;   // Acumuladores de erro
+    bool have_frame = false;
+    uint64_t next_refresh_us = 0;
+    gamma_dither_reset(&dither_state);
+
+    while (1) {
+        const QueuedFrame *frame = frame_queue_peek();
+        if (!frame) {
+            // Transição em andamento sem frame novo: remistura no ritmo de TRANSITION_FPS
+            uint32_t *words = dma ? led_dma_get_back_buffer() : local;
+            if (transition_render(words)) {
+                output_send(words, dma);
+                continue;
+            }
+
+            if (!dither || !have_frame) {
+                // Durante a transição o próximo envio vem pelo tempo, não por um __sev()
+                if (transition_active()) {
+                    tight_loop_contents();
+                } else {
+                    __wfe();  // Acordado pelo __sev() de frame_queue_publish()
+                }
+                continue;
+            }
+
+            // Reenvio no ritmo alvo; um frame novo na fila interrompe a espera
+            if (time_us_64() < next_refresh_us) {
+                tight_loop_contents();
+                continue;
+            }
+            frame = &last;
+        } else if (dither) {
+            // Guarda o frame antes de liberar o slot: ele será reenviado até o próximo
+            last = *frame;
+            have_frame = true;
+        }
+
+        // Converte direto no buffer livre do DMA, sem cópia intermediária
+        uint32_t *words = dma ? led_dma_get_back_buffer() : local;
+        if (dither) {
+            pack_pixels_dithered(frame->pixels, gamma_table(frame->intensity), &dither_state, words);
+            next_refresh_us = time_us_64() + 1000000 / GAMMA_DITHER_REFRESH_HZ;
+        } else {
+            pack_pixels_fixed(frame->pixels, frame->intensity, words);
+        }
+
+        // O slot pode ser reutilizado pelo núcleo 0 assim que convertido
+        if (frame != &last) {
+            frame_queue_release();
+        }
+
+        // Mistura com o que está nos LEDs se uma transição foi pedida ou está em andamento
+        transition_apply(words, dma ? led_dma_get_front_buffer() : sent_words);
+        output_send(words, dma);
+    }
+}
+
+/**
+ * Liga a correção de gama e o dithering temporal
+ * @param enabled true para ligar
+ */
+void output_core_set_dither(bool enabled) {
+    dither = enabled;
+}
+
+/**
+ * Lança o núcleo 1 como responsável pela saída
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ */
+void output_core_start(PIO pio, uint sm) {
+    output_pio = pio;
+    output_sm = sm;
+    frame_queue_reset();
+
+    multicore_launch_core1(output_core_entry);
+    running = true;
+}
+
+/**
+ * Indica se o núcleo 1 está ativo
+ * @return true se ativo
+ */
+bool output_core_is_running(void) {
+    return running;
+}
+
+/**
+ * Indica se o núcleo 1 cuida deste PIO/SM
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @return true se os frames devem ir para a fila
+ */
+bool output_core_owns(PIO pio, uint sm) {
+    return running && output_pio == pio && output_sm == sm;
+}
@@ -0,0 +1,38 @@
+#ifndef OUTPUT_CORE_H
+#define OUTPUT_CORE_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "frame_queue.h"
+
+/**
+ * Inicia o núcleo 1 como dono da saída: ele consome frames de frame_queue,
+ * converte em palavras G|R|B e envia ao PIO por DMA (o canal e a IRQ ficam no núcleo 1).
+ * O núcleo 0 fica livre para renderizar e tratar entradas.
+ * @param pio Instância do PIO já inicializada
+ * @param sm State machine já inicializada
+ */
+extern void output_core_start(PIO pio, uint sm);
+
+/**
+ * Liga a saída com gama e dithering temporal (gamma_dither.h): o núcleo 1 passa a
+ * reenviar o último frame continuamente. Chamar antes de output_core_start().
+ * @param enabled true para ligar
+ */
+extern void output_core_set_dither(bool enabled);
+
+/**
+ * Indica se o núcleo 1 está cuidando da saída.
+ * @return true depois de output_core_start()
+ */
+extern bool output_core_is_running(void);
+
+/**
+ * Indica se o núcleo 1 cuida da saída para este PIO/SM.
+ * @param pio Instância do PIO
+ * @param sm State machine
+ * @return true se os frames desse par devem ir para a fila
+ */
+extern bool output_core_owns(PIO pio, uint sm);
+
+#endif
@@ -0,0 +1,143 @@
+#include "parallel_strip.h"
+#include "led_dma.h"
+
+#define PARALLEL_PLANE_WORDS (PARALLEL_LEDS_PER_LANE * PARALLEL_BYTES_PER_LED / 4)
+
+// === ESTADO DA SAÍDA PARALELA ===
+static uint32_t planes[2][PARALLEL_PLANE_WORDS];  // Bits transpostos, buffer duplo (alinhados para o DMA)
+static uint back_index = 0;                       // Buffer livre para o próximo frame
+static PIO parallel_pio;                          // Bloco PIO usado
+static int parallel_sm = -1;                      // State machine do programa paralelo
+static int channel = -1;                          // Canal DMA
+
+/**
+ * Transpõe uma matriz 8x8 de bits (Hacker's Delight, transpose8 com registradores de 32 bits)
+ * rows[0] vira o bit mais significativo de cada coluna
+ * @param rows 8 bytes de entrada (linhas)
+ * @param out 8 bytes de saída (colunas), do bit 7 ao bit 0 das linhas
+ */
+static inline void transpose8x8(const uint8_t rows[8], uint8_t *out) {
+    uint32_t x = ((uint32_t)rows[0] << 24) | ((uint32_t)rows[1] << 16) | ((uint32_t)rows[2] << 8) | rows[3];
+    uint32_t y = ((uint32_t)rows[4] << 24) | ((uint32_t)rows[5] << 16) | ((uint32_t)rows[6] << 8) | rows[7];
+    uint32_t t;
+
+    // Troca blocos 1x1, 2x2 e 4x4 ao redor da diagonal
+    t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    out[0] = x >> 24; out[1] = x >> 16; out[2] = x >> 8; out[3] = x;
+    out[4] = y >> 24; out[5] = y >> 16; out[6] = y >> 8; out[7] = y;
+}
+
+/**
+ * Transpõe um LED das 8 fitas em 24 bytes de bits
+ * @param lane_words Palavras G|R|B das fitas
+ * @param out 24 bytes de saída
+ */
+void transpose8_grb(const uint32_t lane_words[PARALLEL_LANES], uint8_t *out) {
+    // Para cada canal (G nos bits 31-24, R em 23-16, B em 15-8)
+    for (int channel_shift = 24; channel_shift >= 8; channel_shift -= 8) {
+        uint8_t rows[8];
+
+        // Fita 7 na primeira linha: assim a fita k cai no bit k dos bytes de saída
+        for (int lane = 0; lane < PARALLEL_LANES; lane++) {
+            rows[PARALLEL_LANES - 1 - lane] = (uint8_t)(lane_words[lane] >> channel_shift);
+        }
+
+        transpose8x8(rows, out);
+        out += 8;
+    }
+}
+
+/**
+ * Transpõe um frame inteiro para as 8 fitas
+ * @param words Palavras na ordem da cadeia
+ * @param count Palavras válidas
+ * @param leds_per_lane LEDs por fita
+ * @param out Bytes de saída
+ */
+void parallel_transpose(const uint32_t *words, uint count, uint leds_per_lane, uint8_t *out) {
+    for (uint led = 0; led < leds_per_lane; led++) {
+        uint32_t lane_words[PARALLEL_LANES];
+
+        // LED "led" de cada fita; segmentos incompletos ficam apagados
+        for (uint lane = 0; lane < PARALLEL_LANES; lane++) {
+            uint index = lane * leds_per_lane + led;
+            lane_words[lane] = index < count ? words[index] : 0;
+        }
+
+        transpose8_grb(lane_words, &out[led * PARALLEL_BYTES_PER_LED]);
+    }
+}
+
+/**
+ * Configura o programa paralelo e o canal DMA
+ * @param pio Instância PIO
+ * @param base_pin Primeiro pino
+ * @return true em caso de sucesso
+ */
+bool parallel_strip_init(PIO pio, uint base_pin) {
+    if (!pio_can_add_program(pio, &parallel8_program)) return false;
+
+    parallel_sm = pio_claim_unused_sm(pio, false);
+    if (parallel_sm < 0) return false;
+
+    channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        pio_sm_unclaim(pio, parallel_sm);
+        parallel_sm = -1;
+        return false;
+    }
+
+    parallel_pio = pio;
+    uint offset = pio_add_program(pio, &parallel8_program);
+    parallel8_program_init(pio, parallel_sm, offset, base_pin, PARALLEL_LANES);
+
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, pio_get_dreq(pio, parallel_sm, true));
+    dma_channel_configure(channel, &config, &pio->txf[parallel_sm], NULL, 0, false);
+
+    return true;
+}
+
+/**
+ * Aguarda o fim do frame e o latch
+ */
+void parallel_strip_wait(void) {
+    if (channel < 0) return;
+
+    dma_channel_wait_for_finish_blocking(channel);
+    while (!pio_sm_is_tx_fifo_empty(parallel_pio, parallel_sm)) {
+        tight_loop_contents();
+    }
+    sleep_us(LED_DMA_LATCH_US);
+}
+
+/**
+ * Converte, transpõe e envia um frame
+ * @param pixels Pixels em ordem lógica
+ * @param intensity Intensidade em ponto fixo
+ */
+void parallel_strip_submit(const RGBColor8 *pixels, uint16_t intensity) {
+    if (channel < 0) return;
+
+    uint32_t words[NUM_LEDS];
+    pack_pixels_fixed(pixels, intensity, words);
+
+    // Transpõe no buffer livre enquanto o anterior ainda pode estar no fio
+    uint32_t *plane = planes[back_index];
+    parallel_transpose(words, NUM_LEDS, PARALLEL_LEDS_PER_LANE, (uint8_t *)plane);
+
+    parallel_strip_wait();
+    dma_channel_transfer_from_buffer_now(channel, plane, PARALLEL_PLANE_WORDS);
+
+    back_index ^= 1;
+}
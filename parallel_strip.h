@@ -0,0 +1,53 @@
+#ifndef PARALLEL_STRIP_H
+#define PARALLEL_STRIP_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "led_functions.h"
+
+#define PARALLEL_LANES 8                                           // Fitas acionadas pelo state machine
+#define PARALLEL_LEDS_PER_LANE ((NUM_LEDS + PARALLEL_LANES - 1) / PARALLEL_LANES) // LEDs por fita
+#define PARALLEL_BYTES_PER_LED 24                                  // Um byte por bit G|R|B
+
+/**
+ * Transpõe um LED de 8 fitas: 8 palavras G|R|B (uma por fita) viram 24 bytes,
+ * um por bit transmitido (do bit mais significativo do verde ao menos significativo do azul),
+ * com o bit k de cada byte vindo da fita k.
+ * Usa a transposição 8x8 em registradores de 32 bits (três por LED, sem laço por bit).
+ * @param lane_words Palavras no formato de rgb_matrix_fixed(), uma por fita
+ * @param out Saída com PARALLEL_BYTES_PER_LED bytes
+ */
+extern void transpose8_grb(const uint32_t lane_words[PARALLEL_LANES], uint8_t *out);
+
+/**
+ * Transpõe um frame inteiro. A fita k recebe os LEDs k * leds_per_lane .. (k + 1) * leds_per_lane - 1
+ * da cadeia; posições além de count saem apagadas.
+ * @param words Palavras G|R|B na ordem da cadeia
+ * @param count Quantidade de palavras válidas
+ * @param leds_per_lane LEDs por fita
+ * @param planes Saída com leds_per_lane * PARALLEL_BYTES_PER_LED bytes
+ */
+extern void parallel_transpose(const uint32_t *words, uint count, uint leds_per_lane, uint8_t *planes);
+
+/**
+ * Carrega o programa paralelo e prepara o DMA.
+ * @param pio Instância do PIO usada
+ * @param base_pin Primeiro dos PARALLEL_LANES pinos consecutivos
+ * @return false se faltar memória de programa, state machine ou canal DMA
+ */
+extern bool parallel_strip_init(PIO pio, uint base_pin);
+
+/**
+ * Converte, transpõe e envia um frame pelas 8 fitas ao mesmo tempo.
+ * @param pixels Pixels em ordem lógica (NUM_LEDS posições)
+ * @param intensity Intensidade em ponto fixo (0 a INTENSITY_FIXED_MAX)
+ */
+extern void parallel_strip_submit(const RGBColor8 *pixels, uint16_t intensity);
+
+/**
+ * Bloqueia até o frame atual sair pelo fio e travar (latch).
+ */
+extern void parallel_strip_wait(void);
+
+#endif
@@ -0,0 +1,133 @@
+#include "perf_counters.h"
+
+#if PERF_COUNTERS
+
+#include <stdio.h>
+
+typedef struct {
+    uint16_t render_us;   // Passo menos conversão e espera
+    uint16_t convert_us;  // Conversão para palavras do fio
+    uint16_t stall_us;    // Espera pela saída
+} PerfSample;
+
+// === ESTADO DA JANELA ATUAL ===
+static uint32_t phase_us[PERF_PHASE_COUNT];    // Fases do frame em andamento
+static PerfSample samples[PERF_MAX_SAMPLES];   // Amostras da janela
+static uint8_t sample_count = 0;
+static uint16_t frames = 0;                    // Frames na janela (inclui os sem amostra)
+static uint16_t missed = 0;                    // Deadlines perdidos na janela
+static uint16_t max_jitter_us = 0;             // Maior jitter na janela
+static uint64_t window_start_us = 0;           // Início da janela
+
+/**
+ * Satura em 16 bits
+ * @param value Valor
+ * @return Valor limitado a 65535
+ */
+static inline uint16_t sat16(uint32_t value) {
+    return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+/**
+ * Soma um intervalo à fase atual
+ * @param phase Fase
+ * @param us Duração
+ */
+void perf_add(PerfPhase phase, uint32_t us) {
+    phase_us[phase] += us;
+}
+
+/**
+ * Fecha a amostra do frame
+ * @param step_us Duração do passo
+ * @param jitter_us Jitter do passo
+ * @param missed_now Frames descartados
+ */
+void perf_frame(uint32_t step_us, uint32_t jitter_us, uint32_t missed_now) {
+    uint32_t measured = phase_us[PERF_CONVERT] + phase_us[PERF_STALL];
+
+    if (sample_count < PERF_MAX_SAMPLES) {
+        samples[sample_count++] = (PerfSample){
+            sat16(step_us > measured ? step_us - measured : 0),
+            sat16(phase_us[PERF_CONVERT]),
+            sat16(phase_us[PERF_STALL])
+        };
+    }
+
+    if (frames < 0xFFFF) frames++;
+    missed = sat16(missed + missed_now);
+    if (jitter_us > max_jitter_us) max_jitter_us = sat16(jitter_us);
+
+    phase_us[PERF_CONVERT] = 0;
+    phase_us[PERF_STALL] = 0;
+}
+
+/**
+ * Escreve bytes em modo bruto (sem conversão de \n) e soma no checksum
+ * @param data Bytes a enviar
+ * @param len Quantidade de bytes
+ * @param checksum Checksum acumulado
+ */
+static void put_bytes(const void *data, uint len, uint8_t *checksum) {
+    const uint8_t *bytes = data;
+    for (uint i = 0; i < len; i++) {
+        putchar_raw(bytes[i]);
+        *checksum += bytes[i];
+    }
+}
+
+/**
+ * Escreve um valor de 16 bits em little-endian
+ * @param value Valor
+ * @param checksum Checksum acumulado
+ */
+static void put_u16(uint16_t value, uint8_t *checksum) {
+    uint8_t bytes[2] = {value & 0xFF, value >> 8};
+    put_bytes(bytes, 2, checksum);
+}
+
+/**
+ * Envia o registro da janela quando o período vence
+ */
+void perf_poll(void) {
+    uint64_t now = time_us_64();
+    if (window_start_us == 0) window_start_us = now;
+    if (now - window_start_us < PERF_REPORT_MS * 1000ull) return;
+
+    uint32_t now_ms = (uint32_t)(now / 1000);
+    uint16_t payload = 13 + sample_count * sizeof(PerfSample);
+    uint8_t checksum = 0;
+
+    putchar_raw(PERF_SYNC0);
+    putchar_raw(PERF_SYNC1);
+
+    uint8_t type = PERF_RECORD_WINDOW;
+    put_bytes(&type, 1, &checksum);
+    put_u16(payload, &checksum);
+
+    uint8_t time_bytes[4] = {now_ms & 0xFF, (now_ms >> 8) & 0xFF, (now_ms >> 16) & 0xFF, now_ms >> 24};
+    put_bytes(time_bytes, 4, &checksum);
+    put_u16(sat16((uint32_t)((now - window_start_us) / 1000)), &checksum);
+    put_u16(frames, &checksum);
+    put_u16(missed, &checksum);
+    put_u16(max_jitter_us, &checksum);
+    put_bytes(&sample_count, 1, &checksum);
+
+    for (uint i = 0; i < sample_count; i++) {
+        put_u16(samples[i].render_us, &checksum);
+        put_u16(samples[i].convert_us, &checksum);
+        put_u16(samples[i].stall_us, &checksum);
+    }
+
+    putchar_raw(checksum);
+    stdio_flush();
+
+    // Nova janela
+    window_start_us = now;
+    sample_count = 0;
+    frames = 0;
+    missed = 0;
+    max_jitter_us = 0;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include "pico/stdlib.h"
+
+// === CONTADORES DE DESEMPENHO POR FRAME ===
+// Com PERF_COUNTERS 0 (padrão) as macros e funções abaixo não geram código.
+// Com PERF_COUNTERS 1 cada frame do escalonador gera uma amostra (render,
+// conversão, espera no FIFO) e a cada PERF_REPORT_MS um registro binário é
+// enviado pela USB, decodificado por logs.py.
+
+#ifndef PERF_COUNTERS
+#define PERF_COUNTERS 0
+#endif
+
+#define PERF_REPORT_MS 1000        // Período de envio dos registros
+#define PERF_MAX_SAMPLES 64        // Amostras por registro (frames além disso só entram nos totais)
+
+// Formato do registro (little-endian):
+//   0xA5 0x5A | tipo (1 byte) | tamanho do payload (2 bytes) | payload | checksum (1 byte)
+// checksum = soma de tipo, tamanho e payload, módulo 256.
+// Payload do tipo PERF_RECORD_WINDOW:
+//   tempo_ms (4) | janela_ms (2) | frames (2) | perdidos (2) | jitter_max_us (2) | amostras (1)
+//   e, por amostra: render_us (2) | conversao_us (2) | espera_fifo_us (2)
+#define PERF_SYNC0 0xA5
+#define PERF_SYNC1 0x5A
+#define PERF_RECORD_WINDOW 1
+
+typedef enum {
+    PERF_CONVERT,     // Conversão dos pixels para palavras do fio
+    PERF_STALL,       // Espera pelo FIFO/DMA/fila do núcleo 1
+    PERF_PHASE_COUNT
+} PerfPhase;
+
+#if PERF_COUNTERS
+
+/**
+ * Soma um intervalo à fase do frame atual.
+ * @param phase Fase medida
+ * @param us Duração em microssegundos
+ */
+extern void perf_add(PerfPhase phase, uint32_t us);
+
+/**
+ * Fecha a amostra do frame atual. O tempo de render é o passo menos as fases medidas.
+ * @param step_us Duração do passo da animação
+ * @param jitter_us Atraso do início do passo em relação ao deadline
+ * @param missed Frames descartados após este passo
+ */
+extern void perf_frame(uint32_t step_us, uint32_t jitter_us, uint32_t missed);
+
+/**
+ * Envia o registro da janela quando PERF_REPORT_MS tiver passado. Chamar no laço principal.
+ */
+extern void perf_poll(void);
+
+#define PERF_BEGIN(name) uint64_t perf_start_##name = time_us_64()
+#define PERF_END(name, phase) perf_add(phase, (uint32_t)(time_us_64() - perf_start_##name))
+
+#else
+
+static inline void perf_frame(uint32_t step_us, uint32_t jitter_us, uint32_t missed) {
+    (void)step_us; (void)jitter_us; (void)missed;
+}
+
+static inline void perf_poll(void) {
+}
+
+#define PERF_BEGIN(name) ((void)0)
+#define PERF_END(name, phase) ((void)0)
+
+#endif
+
+#endif
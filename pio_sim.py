@@ -0,0 +1,580 @@
+import argparse
+import re
+import sys
+from collections import deque
+
+# SIMULADOR DE CICLOS DOS PROGRAMAS PIO (main.pio)
+# Executa o programa como o state machine do RP2040, com o divisor de clock e
+# a configuração lidos do bloco c-sdk, gera a forma de onda dos pinos e confere
+# os tempos contra as tolerâncias dos LEDs. Uso:
+#   python pio_sim.py                     (confere os perfis de PERFIS)
+#   python pio_sim.py --program ws2812
+#   python pio_sim.py --program main --vcd main.vcd
+#   python pio_sim.py --search
+
+ARQUIVO_PIO = 'main.pio'
+SYS_KHZ = 128000         # Deve bater com SYS_CLOCK_KHZ em main.c
+LEDS = 25                # LEDs por frame simulado
+LATCH_US = 110           # Deve bater com LED_DMA_LATCH_US em led_dma.h (LED_RESET_US padrão)
+FIFO_DEPTH = 4           # Profundidade do TX FIFO (8 com PIO_FIFO_JOIN_TX)
+
+# TOLERÂNCIAS DOS DATASHEETS (ns; reset em µs)
+CHIPS = {
+    'ws2812b':    {'T0H': (250, 550), 'T1H': (650, 950), 'T0L': (700, 1000), 'T1L': (300, 600), 'RESET': 50},
+    'ws2812b-v5': {'T0H': (220, 380), 'T1H': (580, 1000), 'T0L': (580, 1000), 'T1L': (580, 1000), 'RESET': 280},
+    'sk6812':     {'T0H': (150, 450), 'T1H': (450, 750), 'T0L': (750, 1050), 'T1L': (450, 750), 'RESET': 80},
+}
+
+# PERFIS DE LED_CHIP_V5 (led_dma.h): programa, chips atendidos e LED_DMA_LATCH_US
+PERFIS = [
+    ('ws2812', ['ws2812b', 'sk6812'], LATCH_US),
+    ('ws2812_v5', ['ws2812b-v5', 'sk6812'], 311),
+]
+
+# === MONTAGEM: LEITURA DO .pio ===
+
+def avaliar(expr, defines):
+    """Avalia uma expressão inteira simples usando os .define do arquivo."""
+    texto = re.sub(r'\(float\)', '', expr)
+    texto = re.sub(r'[A-Za-z_]\w*', lambda m: str(defines.get(m.group(0), m.group(0))), texto)
+    if re.search(r'[A-Za-z_]', texto):
+        raise ValueError(f"expressão não suportada: {expr}")
+    return eval(texto, {'__builtins__': {}})
+
+
+def ler_programas(caminho):
+    """Separa o arquivo em programas: instruções, labels, wrap, side-set e bloco c-sdk."""
+    fonte = open(caminho, encoding='utf-8').read()
+    programas = {}
+    defines = {}
+    atual = None
+
+    # Blocos c-sdk são removidos do texto e associados ao programa anterior
+    partes = re.split(r'% c-sdk \{(.*?)%\}', fonte, flags=re.S)
+    for i, parte in enumerate(partes):
+        if i % 2 == 1:
+            atual['csdk'] += parte
+            continue
+
+        for linha in parte.splitlines():
+            linha = re.split(r'//|;', linha)[0].strip()
+            if not linha:
+                continue
+
+            m = re.match(r'\.program\s+(\w+)', linha)
+            if m:
+                atual = {'nome': m.group(1), 'instr': [], 'labels': {}, 'wrap_target': 0, 'wrap': None,
+                         'side_bits': 0, 'side_opt': False, 'defines': dict(defines), 'csdk': ''}
+                programas[atual['nome']] = atual
+                continue
+
+            m = re.match(r'\.define\s+(?:PUBLIC\s+)?(\w+)\s+(.+)', linha)
+            if m:
+                alvo = atual['defines'] if atual else defines
+                alvo[m.group(1)] = avaliar(m.group(2), alvo)
+                if atual:
+                    # Nome gerado pelo pioasm para defines públicos do programa
+                    alvo[f"{atual['nome']}_{m.group(1)}"] = alvo[m.group(1)]
+                continue
+
+            m = re.match(r'\.side_set\s+(\d+)(\s+opt)?', linha)
+            if m:
+                atual['side_bits'] = int(m.group(1))
+                atual['side_opt'] = bool(m.group(2))
+                continue
+
+            if linha == '.wrap_target':
+                atual['wrap_target'] = len(atual['instr'])
+                continue
+            if linha == '.wrap':
+                atual['wrap'] = len(atual['instr']) - 1
+                continue
+
+            m = re.match(r'(\w+):$', linha)
+            if m:
+                atual['labels'][m.group(1)] = len(atual['instr'])
+                continue
+
+            atual['instr'].append(linha)
+
+    for programa in programas.values():
+        if programa['wrap'] is None:
+            programa['wrap'] = len(programa['instr']) - 1
+        programa['instr'] = [decodificar(texto, programa) for texto in programa['instr']]
+    return programas
+
+
+def decodificar(texto, programa):
+    """Converte uma linha de instrução em (operação, argumentos, side-set, delay)."""
+    delay = 0
+    m = re.search(r'\[([^\]]+)\]\s*$', texto)
+    if m:
+        delay = avaliar(m.group(1), programa['defines'])
+        texto = texto[:m.start()].strip()
+
+    side = None
+    m = re.search(r'\bside\s+(\S+)\s*$', texto)
+    if m:
+        side = avaliar(m.group(1), programa['defines'])
+        texto = texto[:m.start()].strip()
+
+    # Limite do campo de delay: 5 bits divididos com o side-set (e o bit de "opt")
+    max_delay = (1 << (5 - programa['side_bits'] - programa['side_opt'])) - 1
+    if delay > max_delay:
+        raise ValueError(f"delay {delay} acima do máximo {max_delay}: {texto}")
+    if side is None and programa['side_bits'] and not programa['side_opt']:
+        raise ValueError(f"side-set obrigatório: {texto}")
+
+    op, _, resto = texto.partition(' ')
+    args = [a.strip() for a in resto.split(',')] if resto.strip() else []
+    return {'op': op, 'args': args, 'side': side, 'delay': delay, 'texto': texto}
+
+
+def ler_configuracao(programa, args):
+    """Lê do bloco c-sdk os grupos de pinos, o deslocamento e o divisor de clock."""
+    csdk = programa['csdk']
+    defines = programa['defines']
+    lanes = args.lanes
+
+    def quantidade(valor):
+        return int(valor) if valor.isdigit() else lanes
+
+    config = {'set': 0, 'out': 0, 'side': 0, 'shift_right': False, 'autopull': False, 'threshold': 32,
+              'fifo': FIFO_DEPTH}
+
+    m = re.search(r'sm_config_set_set_pins\(&c,\s*\w+,\s*(\w+)\)', csdk)
+    if m:
+        config['set'] = quantidade(m.group(1))
+    m = re.search(r'sm_config_set_out_pins\(&c,\s*\w+,\s*(\w+)\)', csdk)
+    if m:
+        config['out'] = quantidade(m.group(1))
+    if re.search(r'sm_config_set_sideset_pins\(&c,\s*\w+\)', csdk):
+        config['side'] = programa['side_bits']
+
+    m = re.search(r'sm_config_set_out_shift\(&c,\s*(true|false),\s*(true|false),\s*(\d+)\)', csdk)
+    if m:
+        config['shift_right'] = m.group(1) == 'true'
+        config['autopull'] = m.group(2) == 'true'
+        config['threshold'] = int(m.group(3))
+
+    if 'PIO_FIFO_JOIN_TX' in csdk:
+        config['fifo'] = 2 * FIFO_DEPTH
+
+    m = re.search(r'float div = clock_get_hz\(clk_sys\)\s*/\s*(.+?);', csdk)
+    sys_hz = args.sys_khz * 1000
+    config['div'] = sys_hz / avaliar(m.group(1), defines) if m else 1.0
+    if args.pio_khz:
+        config['div'] = sys_hz / (args.pio_khz * 1000)
+
+    # Divisor 16.8 do RP2040: parte fracionária em 1/256
+    config['div_fixed'] = round(config['div'] * 256)
+    config['lanes'] = max(config['set'], config['out'], config['side'], 1)
+    return config
+
+# === EXECUÇÃO CICLO A CICLO ===
+
+class StateMachine:
+    def __init__(self, programa, config):
+        self.programa = programa
+        self.config = config
+        self.pc = 0
+        self.x = 0
+        self.y = 0
+        self.osr = 0
+        self.osr_count = 32        # OSR começa vazio
+        self.pins = 0
+        self.fifo = deque()
+        self.delay = 0
+        self.mascara = (1 << config['lanes']) - 1
+
+    def escrever_pinos(self, grupo, valor):
+        largura = self.config[grupo]
+        if largura:
+            mascara = (1 << largura) - 1
+            self.pins = (self.pins & ~mascara) | (valor & mascara)
+
+    def ler_fonte(self, fonte):
+        inverte = fonte.startswith('!') or fonte.startswith('~')
+        nome = fonte.lstrip('!~')
+        valor = {'x': self.x, 'y': self.y, 'null': 0, 'pins': self.pins, 'osr': self.osr}[nome]
+        return (~valor & 0xFFFFFFFF) if inverte else valor
+
+    def deslocar(self, bits):
+        """Retira bits do OSR na direção configurada."""
+        if self.config['shift_right']:
+            valor = self.osr & ((1 << bits) - 1) if bits < 32 else self.osr
+            self.osr = (self.osr >> bits) if bits < 32 else 0
+        else:
+            valor = self.osr >> (32 - bits)
+            self.osr = (self.osr << bits) & 0xFFFFFFFF
+        self.osr_count += bits
+        return valor
+
+    def ciclo(self):
+        """Executa um ciclo do PIO; retorna False se a instrução ficou parada (stall)."""
+        if self.delay:
+            self.delay -= 1
+            return True
+
+        instr = self.programa['instr'][self.pc]
+        if instr['side'] is not None:
+            self.escrever_pinos('side', instr['side'])
+
+        op, args = instr['op'], instr['args']
+        proximo = self.pc + 1 if self.pc != self.programa['wrap'] else self.programa['wrap_target']
+
+        if op == 'out':
+            if self.config['autopull'] and self.osr_count >= self.config['threshold']:
+                if not self.fifo:
+                    return False
+                self.osr = self.fifo.popleft()
+                self.osr_count = 0
+            valor = self.deslocar(int(args[1]))
+            destino = args[0]
+            if destino == 'x':
+                self.x = valor
+            elif destino == 'y':
+                self.y = valor
+            elif destino == 'pins':
+                self.escrever_pinos('out', valor)
+            elif destino != 'null':
+                raise ValueError(f"destino de out não suportado: {destino}")
+        elif op == 'pull':
+            if not self.fifo:
+                if 'noblock' in args:
+                    self.osr = self.x
+                else:
+                    return False
+            else:
+                self.osr = self.fifo.popleft()
+            self.osr_count = 0
+        elif op == 'set':
+            valor = avaliar(args[1], self.programa['defines'])
+            if args[0] == 'pins':
+                self.escrever_pinos('set', valor)
+            elif args[0] == 'x':
+                self.x = valor
+            elif args[0] == 'y':
+                self.y = valor
+            else:
+                raise ValueError(f"destino de set não suportado: {args[0]}")
+        elif op == 'mov':
+            valor = self.ler_fonte(args[1])
+            if args[0] == 'pins':
+                self.escrever_pinos('out', valor)
+            elif args[0] in ('x', 'y'):
+                setattr(self, args[0], valor)
+            else:
+                raise ValueError(f"destino de mov não suportado: {args[0]}")
+        elif op == 'nop':
+            pass
+        elif op == 'jmp':
+            partes = args if len(args) == 2 else args[0].split()
+            condicao, alvo = partes if len(partes) == 2 else (None, partes[0])
+            saltar = True
+            if condicao == '!x':
+                saltar = self.x == 0
+            elif condicao == '!y':
+                saltar = self.y == 0
+            elif condicao == 'x--':
+                saltar = self.x != 0
+                self.x = (self.x - 1) & 0xFFFFFFFF
+            elif condicao == 'y--':
+                saltar = self.y != 0
+                self.y = (self.y - 1) & 0xFFFFFFFF
+            elif condicao == 'x!=y':
+                saltar = self.x != self.y
+            elif condicao == '!osre':
+                saltar = self.osr_count < self.config['threshold']
+            elif condicao is not None:
+                raise ValueError(f"condição de jmp não suportada: {condicao}")
+            if saltar:
+                proximo = self.programa['labels'][alvo]
+        else:
+            raise ValueError(f"instrução não suportada: {instr['texto']}")
+
+        self.pc = proximo
+        self.delay = instr['delay']
+        return True
+
+
+def dados_de_teste(leds, config, largura_out):
+    """Palavras pseudoaleatórias (com 0 e 1 em todas as posições) para um frame."""
+    palavras = leds * 24 * largura_out // config['threshold']
+    semente = 0x12345678
+    dados = []
+    for _ in range(palavras):
+        semente = (semente * 1103515245 + 12345) & 0xFFFFFFFF
+        dados.append(semente)
+    return dados
+
+
+def bits_esperados(dados, config, largura_out, lane):
+    """Sequência de bits que a fita 'lane' deve receber para os dados dados."""
+    bits = []
+    for palavra in dados:
+        for i in range(config['threshold'] // largura_out):
+            if config['shift_right']:
+                pedaco = (palavra >> (i * largura_out)) & ((1 << largura_out) - 1)
+            else:
+                pedaco = (palavra >> (32 - (i + 1) * largura_out)) & ((1 << largura_out) - 1)
+            bits.append((pedaco >> lane) & 1)
+    return bits
+
+
+def simular(programa, config, args):
+    """Envia dois frames separados pelo latch e registra as transições dos pinos (ns)."""
+    sm = StateMachine(programa, config)
+    largura_out = next((int(i['args'][1]) for i in programa['instr'] if i['op'] == 'out'), 1)
+    dados = dados_de_teste(args.leds, config, largura_out)
+    ns_por_sys = 1e6 / args.sys_khz
+
+    frames = [list(dados), list(dados)]
+    pendentes = deque(frames[0])
+    proximo_frame = 1
+    liberar_em = None
+    transicoes = [(0.0, 0)]
+    tempo_sys = 0
+    acumulador = 0
+    parado_desde = None
+
+    while True:
+        # O DMA mantém o FIFO cheio enquanto há dados do frame atual
+        while pendentes and len(sm.fifo) < config['fifo']:
+            sm.fifo.append(pendentes.popleft())
+
+        # Como em led_dma_wait(): FIFO vazio, espera o latch e envia o próximo frame
+        agora_ns = tempo_sys * ns_por_sys
+        if not pendentes and not sm.fifo and liberar_em is None:
+            liberar_em = agora_ns + args.latch_us * 1000
+        if liberar_em is not None and agora_ns >= liberar_em and proximo_frame < len(frames):
+            pendentes = deque(frames[proximo_frame])
+            proximo_frame += 1
+            liberar_em = None
+
+        executou = sm.ciclo()
+        if sm.pins != transicoes[-1][1]:
+            transicoes.append((agora_ns, sm.pins))
+
+        # Fim: último frame enviado e state machine parado por 2 µs
+        if not executou and proximo_frame == len(frames) and not pendentes:
+            parado_desde = parado_desde if parado_desde is not None else agora_ns
+            if agora_ns - parado_desde > 2000:
+                break
+        else:
+            parado_desde = None
+
+        acumulador += config['div_fixed']
+        tempo_sys += acumulador >> 8
+        acumulador &= 0xFF
+
+    esperados = [bits_esperados(dados, config, largura_out, lane) for lane in range(config['lanes'])]
+    return transicoes, esperados, agora_ns
+
+# === ANÁLISE DA FORMA DE ONDA ===
+
+def pulsos(transicoes, lane):
+    """Lista de (início, alto, baixo) em ns para uma fita; o último baixo fica em aberto."""
+    bordas = []
+    nivel = 0
+    for tempo, pinos in transicoes:
+        novo = (pinos >> lane) & 1
+        if novo != nivel:
+            bordas.append((tempo, novo))
+            nivel = novo
+    resultado = []
+    for i in range(0, len(bordas) - 1, 2):
+        subida, descida = bordas[i][0], bordas[i + 1][0]
+        proxima = bordas[i + 2][0] if i + 2 < len(bordas) else None
+        resultado.append((subida, descida - subida, proxima - descida if proxima is not None else None))
+    return resultado
+
+
+def analisar(transicoes, esperados, chips):
+    """Confere cada bit e o reset entre frames contra as tolerâncias."""
+    medidas = {'T0H': [], 'T0L': [], 'T1H': [], 'T1L': [], 'RESET': []}
+    erros = []
+    for lane, bits in enumerate(esperados):
+        lista = pulsos(transicoes, lane)
+        if len(lista) != 2 * len(bits):
+            erros.append(f"fita {lane}: {len(lista)} pulsos para {2 * len(bits)} bits")
+            continue
+        sequencia = bits + bits
+        for i, (_, alto, baixo) in enumerate(lista):
+            bit = sequencia[i]
+            medidas[f'T{bit}H'].append(alto)
+            if i == len(bits) - 1:
+                medidas['RESET'].append(baixo / 1000)   # Baixo entre os frames
+            elif baixo is not None:
+                medidas[f'T{bit}L'].append(baixo)
+
+    resultado = {}
+    for chip in chips:
+        limites = CHIPS[chip]
+        ok = {}
+        for nome, valores in medidas.items():
+            if not valores:
+                ok[nome] = False
+            elif nome == 'RESET':
+                ok[nome] = min(valores) >= limites['RESET']
+            else:
+                ok[nome] = limites[nome][0] <= min(valores) and max(valores) <= limites[nome][1]
+        resultado[chip] = ok
+    return medidas, resultado, erros
+
+
+def gravar_vcd(caminho, transicoes, lanes):
+    """Forma de onda no formato VCD (GTKWave e similares)."""
+    with open(caminho, 'w') as f:
+        f.write("$timescale 1ns $end\n$scope module pio $end\n")
+        for lane in range(lanes):
+            f.write(f"$var wire 1 {chr(33 + lane)} pin{lane} $end\n")
+        f.write("$upscope $end\n$enddefinitions $end\n")
+        anterior = None
+        for tempo, pinos in transicoes:
+            f.write(f"#{round(tempo)}\n")
+            for lane in range(lanes):
+                nivel = (pinos >> lane) & 1
+                if anterior is None or nivel != (anterior >> lane) & 1:
+                    f.write(f"{nivel}{chr(33 + lane)}\n")
+            anterior = pinos
+
+
+def desenhar(transicoes, lane, ns_por_caractere, caracteres):
+    """Forma de onda em texto: '#' alto, '_' baixo."""
+    linha = []
+    i = 0
+    for n in range(caracteres):
+        tempo = n * ns_por_caractere
+        while i + 1 < len(transicoes) and transicoes[i + 1][0] <= tempo:
+            i += 1
+        linha.append('#' if (transicoes[i][1] >> lane) & 1 else '_')
+    return ''.join(linha)
+
+# === BUSCA DE TEMPOS PARA O PROGRAMA ws2812 ===
+
+def buscar(args, chips):
+    """
+    Procura T1/T2/T3 (ciclos de cada fase do programa ws2812) e o divisor inteiro
+    que dão o menor período de bit dentro das tolerâncias de todos os chips,
+    desempatando pela maior folga até o limite mais próximo.
+    """
+    candidatos = []
+    for div in range(1, 256):
+        ciclo = div * 1e6 / args.sys_khz
+        for t1 in range(1, 17):
+            for t2 in range(1, 17):
+                for t3 in range(1, 17):
+                    fases = {'T0H': t1 * ciclo, 'T0L': (t2 + t3) * ciclo,
+                             'T1H': (t1 + t2) * ciclo, 'T1L': t3 * ciclo}
+                    folga = min(min(v - CHIPS[c][n][0], CHIPS[c][n][1] - v)
+                                for c in chips for n, v in fases.items())
+                    if folga >= args.margin:
+                        candidatos.append(((t1 + t2 + t3) * ciclo, -folga, div, t1, t2, t3))
+    candidatos.sort()
+    print(f"Melhores combinações para {', '.join(chips)} a {args.sys_khz} kHz (folga >= {args.margin:.0f} ns):")
+    print("  período   bit rate   folga   div  T1  T2  T3")
+    for periodo, folga, div, t1, t2, t3 in candidatos[:args.search]:
+        print(f"  {periodo:6.1f} ns {1e6 / periodo:6.0f} kHz {-folga:5.1f} ns {div:4d} {t1:3d} {t2:3d} {t3:3d}")
+    return 0 if candidatos else 1
+
+# === PROGRAMA PRINCIPAL ===
+
+def main():
+    parser = argparse.ArgumentParser(description='Simulador de ciclos dos programas PIO dos LEDs')
+    parser.add_argument('--file', default=ARQUIVO_PIO)
+    parser.add_argument('--program', help='Programa a simular (padrão: todos os perfis de PERFIS)')
+    parser.add_argument('--sys-khz', type=int, default=SYS_KHZ)
+    parser.add_argument('--pio-khz', type=int, help='Ignora o divisor do c-sdk e usa este clock do PIO')
+    parser.add_argument('--leds', type=int, default=LEDS)
+    parser.add_argument('--lanes', type=int, default=8, help='Pinos quando a contagem é um parâmetro (parallel8)')
+    parser.add_argument('--latch-us', type=float)
+    parser.add_argument('--chips', help='Perfis a conferir, separados por vírgula')
+    parser.add_argument('--margin', type=float, default=25,
+                        help='Folga mínima (ns) até cada limite na busca: bordas, jitter e variação entre LEDs')
+    parser.add_argument('--vcd', help='Grava a forma de onda em VCD')
+    parser.add_argument('--wave', type=int, default=0, help='Desenha os primeiros N µs da forma de onda')
+    parser.add_argument('--search', type=int, nargs='?', const=5, default=0,
+                        help='Procura os N melhores tempos para o programa ws2812')
+    args = parser.parse_args()
+    chips = args.chips.split(',') if args.chips else None
+
+    if args.search:
+        return buscar(args, chips or PERFIS[0][1])
+
+    # Sem --program, cada perfil é conferido com os seus chips e o seu latch
+    perfis = [(nome, chips or padrao, args.latch_us or latch) for nome, padrao, latch in PERFIS
+              if args.program in (None, nome)]
+    if not perfis:
+        perfis = [(args.program, chips or PERFIS[0][1], args.latch_us or LATCH_US)]
+
+    programas = ler_programas(args.file)
+    falhas = 0
+    for i, (nome, chips_perfil, latch) in enumerate(perfis):
+        if i:
+            print('\n' + '=' * 72 + '\n')
+        falhas += conferir(programas[nome], nome, chips_perfil, latch, args)
+    return 1 if falhas else 0
+
+
+def conferir(programa, nome, chips, latch_us, args):
+    """Simula um programa e confere os tempos contra os chips; retorna 0 se aprovado."""
+    args = argparse.Namespace(**{**vars(args), 'latch_us': latch_us})
+    config = ler_configuracao(programa, args)
+    transicoes, esperados, duracao = simular(programa, config, args)
+    medidas, resultado, erros = analisar(transicoes, esperados, chips)
+
+    ns_ciclo = config['div'] * 1e6 / args.sys_khz
+    print(f"Programa: {nome} ({args.file})")
+    print(f"Clock: sys {args.sys_khz} kHz / {config['div']:.3f} -> PIO {args.sys_khz / config['div']:.0f} kHz "
+          f"({ns_ciclo:.2f} ns por ciclo)")
+    if config['div_fixed'] % 256:
+        print("Aviso: divisor fracionário, os tempos variam de um ciclo a outro (jitter)")
+
+    bits = medidas['T0H'] + medidas['T1H']
+    if bits:
+        periodo = (sum(medidas['T0H']) + sum(medidas['T0L']) + sum(medidas['T1H']) + sum(medidas['T1L'])) \
+            / (len(medidas['T0H']) + len(medidas['T1H']) - len(medidas['RESET']))
+        print(f"Bits: {len(bits)} em {config['lanes']} fita(s), período médio {periodo:.1f} ns "
+              f"({1e6 / periodo:.0f} kHz), frame de {args.leds} LEDs em {args.leds * 24 * periodo / 1000:.1f} µs")
+
+    for erro in erros:
+        print(f"ERRO: {erro}")
+
+    print()
+    print("         mín       máx   " + ''.join(f"{chip:>22}" for chip in chips))
+    for nome in ('T0H', 'T0L', 'T1H', 'T1L', 'RESET'):
+        valores = medidas[nome]
+        unidade = 'µs' if nome == 'RESET' else 'ns'
+        faixa = f"{min(valores):7.1f}   {max(valores):7.1f} {unidade}" if valores else "      -         -   "
+        colunas = []
+        for chip in chips:
+            limite = CHIPS[chip][nome]
+            texto = f">={limite}" if nome == 'RESET' else f"[{limite[0]},{limite[1]}]"
+            colunas.append(f"{('OK' if resultado[chip][nome] else 'FORA')} {texto}".rjust(22))
+        print(f"{nome:6} {faixa}" + ''.join(colunas))
+
+    # O reset medido é o latch menos a última palavra que ainda estava no OSR
+    if medidas['RESET']:
+        perda = args.latch_us - min(medidas['RESET'])
+        print()
+        for chip in chips:
+            print(f"Latch mínimo seguro para {chip}: LED_DMA_LATCH_US >= {CHIPS[chip]['RESET'] + perda:.0f}")
+
+    if args.wave:
+        print()
+        ns_por_caractere = ns_ciclo if ns_ciclo >= 20 else 20
+        for lane in range(config['lanes']):
+            print(f"pin{lane} " + desenhar(transicoes, lane, ns_por_caractere, int(args.wave * 1000 / ns_por_caractere)))
+
+    if args.vcd:
+        gravar_vcd(args.vcd, transicoes, config['lanes'])
+        print(f"\nForma de onda gravada em {args.vcd} ({duracao / 1000:.1f} µs)")
+
+    aprovado = not erros and all(all(ok.values()) for ok in resultado.values())
+    print("\nRESULTADO: " + ("dentro das tolerâncias" if aprovado else "FORA das tolerâncias"))
+    return 0 if aprovado else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,130 @@
+#include <string.h>
+#include "hardware/sync.h"
+#include "scheduler.h"
+#include "perf_counters.h"
+
+// === ESTADO DO ESCALONADOR ===
+static Animation current;              // Animação em andamento
+static volatile bool running = false;  // Há animação agendada
+static uint64_t next_deadline_us = 0;  // Próximo deadline absoluto
+static alarm_id_t alarm_id = 0;        // Alarme de hardware que acorda a CPU no deadline
+static SchedulerStats stats;           // Contadores de execução
+
+/**
+ * Callback do alarme: apenas acorda o laço principal (a interrupção tira a CPU do __wfe)
+ */
+static int64_t scheduler_alarm_callback(alarm_id_t id, void *user_data) {
+    alarm_id = 0;
+    __sev();
+    return 0;  // Alarme de disparo único; é reagendado a cada frame
+}
+
+/**
+ * Agenda o alarme para o próximo deadline
+ */
+static void scheduler_arm(void) {
+    if (alarm_id > 0) {
+        cancel_alarm(alarm_id);
+    }
+    alarm_id = add_alarm_at(from_us_since_boot(next_deadline_us), scheduler_alarm_callback, NULL, true);
+}
+
+/**
+ * Inicia uma animação a partir de agora
+ * @param animation Animação a executar
+ */
+void scheduler_start(const Animation *animation) {
+    scheduler_stop();
+
+    current = *animation;
+    next_deadline_us = time_us_64();
+    running = true;
+
+    // Alarme já vencido dispara na hora e acorda o laço principal para o primeiro frame
+    scheduler_arm();
+}
+
+/**
+ * Para a animação em andamento
+ */
+void scheduler_stop(void) {
+    running = false;
+
+    if (alarm_id > 0) {
+        cancel_alarm(alarm_id);
+        alarm_id = 0;
+    }
+}
+
+/**
+ * Indica se há animação em andamento
+ * @return true se rodando
+ */
+bool scheduler_is_running(void) {
+    return running;
+}
+
+/**
+ * Muda o período da animação em andamento
+ * @param period_us Novo período
+ */
+void scheduler_set_period(uint32_t period_us) {
+    current.period_us = period_us;
+}
+
+/**
+ * Executa o passo da animação quando o deadline é atingido
+ * @return true enquanto houver animação
+ */
+bool scheduler_poll(void) {
+    if (!running) return false;
+
+    uint64_t now = time_us_64();
+    if (now < next_deadline_us) return true;  // Ainda não é hora
+
+    // Jitter: quanto o passo começou depois do deadline
+    uint32_t jitter = (uint32_t)(now - next_deadline_us);
+    if (jitter > stats.max_jitter_us) stats.max_jitter_us = jitter;
+
+    if (!current.step(current.state)) {
+        scheduler_stop();
+        return false;
+    }
+
+    uint64_t done = time_us_64();
+    uint32_t step_us = (uint32_t)(done - now);
+    if (step_us > stats.max_step_us) stats.max_step_us = step_us;
+    stats.frames++;
+
+    // Próximo deadline é absoluto: o tempo de render/envio não se acumula no período
+    next_deadline_us += current.period_us;
+
+    // Atrasado: descarta os frames cujo deadline já passou em vez de tentar alcançá-los
+    uint32_t missed = 0;
+    if (done >= next_deadline_us) {
+        missed = current.period_us ? (uint32_t)((done - next_deadline_us) / current.period_us) + 1 : 0;
+        next_deadline_us += (uint64_t)missed * current.period_us;
+        stats.skipped += missed;
+        stats.overruns++;
+    }
+
+    perf_frame(step_us, jitter, missed);
+
+    scheduler_arm();
+    return true;
+}
+
+/**
+ * Retorna as estatísticas acumuladas
+ * @return Ponteiro para as estatísticas
+ */
+const SchedulerStats *scheduler_get_stats(void) {
+    return &stats;
+}
+
+/**
+ * Zera as estatísticas
+ */
+void scheduler_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,72 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "pico/stdlib.h"
+
+/**
+ * Função de passo de uma animação: desenha UM frame e retorna.
+ * @param state Estado da animação (registrado em Animation.state)
+ * @return true para continuar, false quando a animação terminou
+ */
+typedef bool (*animation_step_t)(void *state);
+
+typedef struct {
+    animation_step_t step; // Desenha um frame
+    void *state;           // Estado próprio da animação
+    uint32_t period_us;    // Período entre frames em microssegundos
+} Animation;
+
+typedef struct {
+    uint32_t frames;        // Frames executados
+    uint32_t skipped;       // Frames descartados por atraso (frame-skip)
+    uint32_t overruns;      // Passos que ultrapassaram o próprio deadline
+    uint32_t max_jitter_us; // Maior atraso entre o deadline e o início do passo
+    uint32_t max_step_us;   // Maior duração de um passo
+} SchedulerStats;
+
+/**
+ * Inicia uma animação. O primeiro frame é executado na próxima chamada de scheduler_poll()
+ * e os seguintes em deadlines absolutos (início + k * período), sem deriva.
+ * Substitui a animação em andamento, se houver.
+ * @param animation Animação a executar (copiada internamente; o estado deve continuar válido)
+ */
+extern void scheduler_start(const Animation *animation);
+
+/**
+ * Interrompe a animação em andamento e cancela o alarme.
+ */
+extern void scheduler_stop(void);
+
+/**
+ * Indica se há uma animação em andamento.
+ * @return true se alguma animação está agendada
+ */
+extern bool scheduler_is_running(void);
+
+/**
+ * Muda o período da animação em andamento. Chamada de dentro do passo, vale
+ * já para o próximo deadline (animações com duração própria por frame).
+ * @param period_us Novo período em microssegundos
+ */
+extern void scheduler_set_period(uint32_t period_us);
+
+/**
+ * Executa o passo da animação se o deadline chegou. Deve ser chamada no laço principal;
+ * entre chamadas a CPU pode dormir com __wfe(), o alarme de hardware acorda no deadline.
+ * Se o passo atrasar mais de um período, os frames perdidos são descartados.
+ * @return true enquanto a animação estiver em andamento
+ */
+extern bool scheduler_poll(void);
+
+/**
+ * Retorna os contadores de execução (jitter, atrasos e descartes).
+ * @return Ponteiro para as estatísticas acumuladas
+ */
+extern const SchedulerStats *scheduler_get_stats(void);
+
+/**
+ * Zera os contadores de execução.
+ */
+extern void scheduler_reset_stats(void);
+
+#endif
@@ -0,0 +1,311 @@
+#include <string.h>
+#include "scroll.h"
+#include "output_core.h"
+#include "perf_counters.h"
+#include "message_cache.h"
+
+/**
+ * Converte o texto em máscaras ao longo do eixo da rolagem (ou as copia do cache de mensagens)
+ * @param anim Estado da rolagem (direction e font já definidos)
+ * @param text Texto UTF-8
+ * @param spacing Linhas vazias entre letras
+ */
+static void scroll_build_lines(ScrollAnimation *anim, const char *text, int spacing) {
+    const Font *font = anim->font;
+    bool horizontal = anim->direction == SCROLL_LEFT || anim->direction == SCROLL_RIGHT;
+
+    // Glifo centralizado no eixo transversal (fontes mais altas que a matriz perdem o topo)
+    int margin = (MATRIX_HEIGHT - font->height) / 2;
+    int count = 0;
+    int previous = -1;
+    uint32_t codepoint;
+
+    // Mensagem repetida: as máscaras prontas voltam da arena, sem tocar nos glifos
+    uint32_t layout = ((uint32_t)horizontal << 8) | (uint32_t)spacing;
+    int cached = message_cache_get(text, font, layout, anim->lines, SCROLL_MAX_LINES);
+    if (cached >= 0) {
+        anim->count = cached;
+        return;
+    }
+    const char *start_text = text;
+
+    // Kerning sobrepõe colunas: o acúmulo é por OR sobre linhas zeradas
+    memset(anim->lines, 0, sizeof(anim->lines));
+
+    while ((codepoint = font_decode_utf8(&text)) != 0) {
+        uint16_t glyph = font_find_glyph(font, codepoint);
+        const uint32_t *columns = font_glyph_columns(font, glyph);
+        int width = font_glyph_width(font, glyph);
+
+        if (horizontal) {
+            // Uma máscara por coluna do glifo: bit y = linha da matriz
+            int start = count;
+            if (previous >= 0) start += spacing + font_kerning(font, (uint16_t)previous, glyph);
+            if (start < 0) start = 0;
+            if (start + width > SCROLL_MAX_LINES) break;
+
+            for (int column = 0; column < width; column++) {
+                uint32_t mask = margin >= 0 ? columns[column] << margin : columns[column] >> -margin;
+                anim->lines[start + column] |= mask;
+            }
+            if (start + width > count) count = start + width;
+        } else {
+            // Uma máscara por linha do glifo: bit x = coluna da matriz, glifo centralizado pela largura
+            int start = previous >= 0 ? count + spacing : 0;
+            if (start + font->height > SCROLL_MAX_LINES) break;
+
+            int left = (MATRIX_WIDTH - width) / 2;
+            for (int row = 0; row < font->height; row++) {
+                uint32_t mask = 0;
+                for (int column = 0; column < width; column++) {
+                    int x = left + column;
+                    if (x >= 0 && x < MATRIX_WIDTH && ((columns[column] >> row) & 1u)) mask |= 1u << x;
+                }
+                anim->lines[start + row] = mask;
+            }
+            count = start + font->height;
+        }
+        previous = glyph;
+    }
+
+    anim->count = count;
+    message_cache_put(start_text, font, layout, anim->lines, count);
+}
+
+/**
+ * Prepara a rolagem
+ * @param anim Estado da rolagem
+ * @param text Texto
+ * @param direction Sentido
+ * @param spacing Linhas entre letras
+ * @param color Cor do texto
+ * @param pio Instância PIO
+ * @param sm State machine PIO
+ * @param intensity Intensidade (0.0-1.0)
+ */
+void scroll_animation_init(ScrollAnimation *anim, const char *text, ScrollDirection direction, int spacing,
+                           RGBColor color, PIO pio, uint sm, double intensity) {
+    anim->direction = direction;
+    anim->span = (direction == SCROLL_LEFT || direction == SCROLL_RIGHT) ? MATRIX_WIDTH : MATRIX_HEIGHT;
+    scroll_animation_set_text(anim, text, SCROLL_FONT, spacing);
+    anim->speed = SCROLL_SPEED_ONE;
+    anim->smooth = false;
+
+    // Converte cor e intensidade uma única vez; os passos ficam só com inteiros
+    anim->color = color_to_fixed(color);
+    anim->intensity = intensity_to_fixed(intensity);
+    anim->pio = pio;
+    anim->sm = sm;
+}
+
+/**
+ * Troca o texto e a fonte
+ * @param anim Estado da rolagem
+ * @param text Texto UTF-8
+ * @param font Fonte
+ * @param spacing Linhas entre letras
+ */
+void scroll_animation_set_text(ScrollAnimation *anim, const char *text, const Font *font, int spacing) {
+    if (spacing < 0) spacing = 0;
+    if (spacing > SCROLL_MAX_SPACING) spacing = SCROLL_MAX_SPACING;
+
+    anim->font = font;
+    scroll_build_lines(anim, text ? text : "", spacing);
+
+    // Primeira linha da mensagem já visível na borda de entrada
+    anim->position = -(anim->span - 1) * SCROLL_SPEED_ONE;
+    anim->shown = INT32_MIN;
+}
+
+/**
+ * Ajusta a velocidade
+ * @param anim Estado da rolagem
+ * @param speed Linhas por passo (8.8)
+ * @param smooth Mistura por sub-passo
+ */
+void scroll_animation_set_speed(ScrollAnimation *anim, uint16_t speed, bool smooth) {
+    anim->speed = speed ? speed : 1;
+    anim->smooth = smooth;
+}
+
+/**
+ * Máscara de uma linha da mensagem (vazia fora dela)
+ * @param anim Estado da rolagem
+ * @param line Índice da linha
+ * @return Máscara
+ */
+static inline uint32_t scroll_line(const ScrollAnimation *anim, int line) {
+    return (line >= 0 && line < anim->count) ? anim->lines[line] : 0;
+}
+
+/**
+ * Primeira linha da janela e fração do sub-passo
+ * @param anim Estado da rolagem
+ * @param position Início da janela (8.8)
+ * @param fraction Fração da posição (0 sem sub-passo)
+ * @return Índice da primeira linha
+ */
+static inline int scroll_window(const ScrollAnimation *anim, int32_t position, uint32_t *fraction) {
+    // Nos sentidos direita/baixo a mensagem é percorrida a partir do fim
+    int32_t base = (anim->direction == SCROLL_LEFT || anim->direction == SCROLL_UP)
+                       ? position
+                       : (anim->count - anim->span) * SCROLL_SPEED_ONE - position;
+    *fraction = anim->smooth ? (uint32_t)base & 0xFF : 0;
+    return base >> 8;
+}
+
+/**
+ * Níveis por combinação (linha atual, linha seguinte): sem sub-passo a seguinte é ignorada
+ * @param level Brilho das linhas acesas
+ * @param fraction Fração do sub-passo
+ * @param levels Saída com 4 níveis
+ */
+static inline void scroll_levels(uint8_t level, uint32_t fraction, uint8_t levels[4]) {
+    levels[0] = 0;
+    levels[1] = fraction ? (uint8_t)((level * (256 - fraction)) >> 8) : level;
+    levels[2] = fraction ? (uint8_t)((level * fraction) >> 8) : 0;
+    levels[3] = level;
+}
+
+/**
+ * Monta o frame de brilho da janela
+ * @param anim Estado da rolagem
+ * @param position Início da janela (8.8)
+ * @param frame Frame de saída
+ * @param level Brilho das linhas acesas
+ */
+void scroll_render_window(const ScrollAnimation *anim, int32_t position, uint8_t *frame, uint8_t level) {
+    uint32_t fraction;
+    int first = scroll_window(anim, position, &fraction);
+
+    uint8_t levels[4];
+    scroll_levels(level, fraction, levels);
+
+    if (anim->direction == SCROLL_LEFT || anim->direction == SCROLL_RIGHT) {
+        // Cada coluna da janela é uma máscara: bit y vai para a linha y
+        for (int x = 0; x < MATRIX_WIDTH; x++) {
+            uint32_t current = scroll_line(anim, first + x);
+            uint32_t next = fraction ? scroll_line(anim, first + x + 1) : 0;
+            uint8_t *out = &frame[x];
+
+            for (int y = 0; y < MATRIX_HEIGHT; y++) {
+                *out = levels[(current & 1u) | ((next & 1u) << 1)];
+                current >>= 1;
+                next >>= 1;
+                out += MATRIX_WIDTH;
+            }
+        }
+    } else {
+        // Cada linha da janela é uma máscara: bit x vai para a coluna x
+        for (int y = 0; y < MATRIX_HEIGHT; y++) {
+            uint32_t current = scroll_line(anim, first + y);
+            uint32_t next = fraction ? scroll_line(anim, first + y + 1) : 0;
+            uint8_t *out = &frame[y * MATRIX_WIDTH];
+
+            for (int x = 0; x < MATRIX_WIDTH; x++) {
+                out[x] = levels[(current & 1u) | ((next & 1u) << 1)];
+                current >>= 1;
+                next >>= 1;
+            }
+        }
+    }
+}
+
+/**
+ * Monta a janela direto nas palavras do fio
+ * @param anim Estado da rolagem
+ * @param position Início da janela (8.8)
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+void scroll_pack_window(const ScrollAnimation *anim, int32_t position, uint32_t *words) {
+    uint32_t fraction;
+    int first = scroll_window(anim, position, &fraction);
+
+    uint8_t levels[4];
+    scroll_levels(255, fraction, levels);
+
+    // Cor e intensidade resolvidas uma vez por frame: no máximo quatro palavras diferentes
+    const uint8_t *table = brightness_table(anim->intensity);
+    RGBColor8 scaled = {table[anim->color.r], table[anim->color.g], table[anim->color.b]};
+    uint32_t level_words[4];
+    for (int i = 0; i < 4; i++) {
+        uint32_t scale = levels[i] + 1u;  // Mesmo arredondamento de pack_frame_fixed()
+        level_words[i] = levels[i] == 0 ? 0 : rgb_matrix_fixed((uint8_t)((scaled.b * scale) >> 8),
+                                                               (uint8_t)((scaled.r * scale) >> 8),
+                                                               (uint8_t)((scaled.g * scale) >> 8));
+    }
+
+    if (anim->direction == SCROLL_LEFT || anim->direction == SCROLL_RIGHT) {
+        for (int x = 0; x < MATRIX_WIDTH; x++) {
+            uint32_t current = scroll_line(anim, first + x);
+            uint32_t next = fraction ? scroll_line(anim, first + x + 1) : 0;
+            const uint16_t *index = &matrix_unmap[x];
+
+            for (int y = 0; y < MATRIX_HEIGHT; y++) {
+                words[*index] = level_words[(current & 1u) | ((next & 1u) << 1)];
+                current >>= 1;
+                next >>= 1;
+                index += MATRIX_WIDTH;
+            }
+        }
+    } else {
+        for (int y = 0; y < MATRIX_HEIGHT; y++) {
+            uint32_t current = scroll_line(anim, first + y);
+            uint32_t next = fraction ? scroll_line(anim, first + y + 1) : 0;
+            const uint16_t *index = &matrix_unmap[y * MATRIX_WIDTH];
+
+            for (int x = 0; x < MATRIX_WIDTH; x++) {
+                words[index[x]] = level_words[(current & 1u) | ((next & 1u) << 1)];
+                current >>= 1;
+                next >>= 1;
+            }
+        }
+    }
+}
+
+/**
+ * Um passo da rolagem: envia a janela e avança
+ * @param state Ponteiro para ScrollAnimation
+ * @return false quando a mensagem terminou de passar
+ */
+bool scroll_animation_step(void *state) {
+    ScrollAnimation *anim = (ScrollAnimation *)state;
+
+    // Termina depois do frame em que a janela já passou da última linha
+    if ((anim->position >> 8) > anim->count) return false;
+
+    // Velocidade fracionária sem sub-passo: só envia quando a linha inteira muda
+    int32_t whole = anim->position >> 8;
+    if (anim->smooth || whole != anim->shown) {
+        if (output_core_owns(anim->pio, anim->sm)) {
+            // O núcleo 1 recebe pixels: passa pelo frame de brilho
+            uint8_t frame[NUM_LEDS];
+            scroll_render_window(anim, anim->position, frame, 255);
+            display_frame_fixed(frame, anim->color, anim->pio, anim->sm, anim->intensity);
+        } else {
+            // Janela direto nas palavras do fio, sem frame intermediário
+            uint32_t local[NUM_LEDS];
+            uint32_t *words = frame_words_begin(anim->pio, anim->sm, local);
+
+            PERF_BEGIN(convert);
+            scroll_pack_window(anim, anim->position, words);
+            PERF_END(convert, PERF_CONVERT);
+
+            frame_words_end(anim->pio, anim->sm, words);
+        }
+        anim->shown = whole;
+    }
+
+    anim->position += anim->speed;
+    return true;
+}
+
+/**
+ * Avança a posição sem enviar
+ * @param anim Estado da rolagem
+ * @return false quando a mensagem terminou de passar
+ */
+bool scroll_animation_advance(ScrollAnimation *anim) {
+    anim->position += anim->speed;
+    return (anim->position >> 8) <= anim->count;
+}
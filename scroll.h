@@ -0,0 +1,124 @@
+#ifndef SCROLL_H
+#define SCROLL_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "led_functions.h"
+#include "font.h"
+
+/**
+ * Rolagem de texto por máscaras de bits, nas quatro direções.
+ * A mensagem é convertida uma vez em "linhas" ao longo do eixo da rolagem:
+ * colunas (rolagem horizontal, bit y = linha da matriz) ou linhas (rolagem
+ * vertical, bit x = coluna da matriz). Cada frame é só a janela dessas linhas,
+ * expandida por deslocamento de bits, sem consultar glifos nem copiar células.
+ * A posição é em ponto fixo 8.8, então a velocidade pode ser fracionária; com
+ * sub-passo, as duas linhas vizinhas são misturadas pela fração da posição.
+ * O texto é UTF-8 em uma fonte compilada (font.h): na horizontal cada glifo
+ * ocupa a própria largura, com kerning; na vertical é centralizado pela largura.
+ */
+
+#define SCROLL_MAX_SPACING 3             // Maior espaçamento entre letras aceito
+#define SCROLL_MAX_LINES (MAX_TEXT_LENGTH * (GLYPH_WIDTH + SCROLL_MAX_SPACING)) // Linhas da mensagem
+#define SCROLL_SPEED_ONE 256             // Velocidade de uma linha por passo (8.8)
+
+#ifndef SCROLL_FONT
+#define SCROLL_FONT (&font_5x5)          // Fonte de scroll_animation_init()
+#endif
+
+#if MATRIX_WIDTH > 32 || MATRIX_HEIGHT > 32
+#error "As máscaras de rolagem têm 32 bits: a matriz pode ter no máximo 32 linhas e 32 colunas"
+#endif
+
+typedef enum {
+    SCROLL_LEFT,                         // Texto anda para a esquerda (ticker)
+    SCROLL_RIGHT,                        // Texto anda para a direita
+    SCROLL_UP,                           // Texto sobe (como show_message())
+    SCROLL_DOWN                          // Texto desce
+} ScrollDirection;
+
+typedef struct {
+    uint32_t lines[SCROLL_MAX_LINES];    // Máscaras da mensagem ao longo do eixo da rolagem
+    const Font *font;                    // Fonte das máscaras
+    int count;                           // Linhas usadas
+    int span;                            // Tamanho da janela no eixo (largura ou altura da matriz)
+    ScrollDirection direction;           // Sentido da rolagem
+    int32_t position;                    // Início da janela em 8.8
+    int32_t shown;                       // Linha inteira do último frame enviado (sem sub-passo)
+    uint16_t speed;                      // Avanço por passo em 8.8
+    bool smooth;                         // Mistura as linhas vizinhas pela fração
+    RGBColor8 color;                     // Cor do texto
+    uint16_t intensity;                  // Intensidade em ponto fixo
+    PIO pio;                             // Instância PIO
+    uint sm;                             // State machine
+} ScrollAnimation;
+
+/**
+ * Prepara a rolagem: converte o texto em máscaras (uma vez) com SCROLL_FONT e
+ * posiciona a janela com a primeira linha entrando pela borda. Textos que não
+ * cabem em SCROLL_MAX_LINES são cortados.
+ * @param anim Estado da rolagem
+ * @param text Texto a ser mostrado (UTF-8)
+ * @param direction Sentido da rolagem
+ * @param spacing Linhas vazias entre letras (0 a SCROLL_MAX_SPACING)
+ * @param color Cor do texto (0 a 255 por canal)
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @param intensity Intensidade (0.0 a 1.0)
+ */
+extern void scroll_animation_init(ScrollAnimation *anim, const char *text, ScrollDirection direction, int spacing,
+                                  RGBColor color, PIO pio, uint sm, double intensity);
+
+/**
+ * Troca o texto e a fonte de uma rolagem preparada e volta a janela ao início.
+ * Direção, velocidade, cor e intensidade não mudam.
+ * @param anim Estado da rolagem
+ * @param text Texto a ser mostrado (UTF-8)
+ * @param font Fonte compilada (altura até MATRIX_HEIGHT na horizontal para não cortar)
+ * @param spacing Linhas vazias entre letras (0 a SCROLL_MAX_SPACING)
+ */
+extern void scroll_animation_set_text(ScrollAnimation *anim, const char *text, const Font *font, int spacing);
+
+/**
+ * Ajusta a velocidade da rolagem.
+ * @param anim Estado da rolagem
+ * @param speed Linhas por passo em 8.8 (SCROLL_SPEED_ONE = uma linha; 128 = meia linha)
+ * @param smooth true para misturar as linhas vizinhas nas posições fracionárias
+ */
+extern void scroll_animation_set_speed(ScrollAnimation *anim, uint16_t speed, bool smooth);
+
+/**
+ * Monta o frame de brilho da janela em uma posição.
+ * @param anim Estado da rolagem
+ * @param position Início da janela em 8.8
+ * @param frame Frame de saída (NUM_LEDS posições, ordem lógica)
+ * @param level Brilho das linhas acesas (0 a 255)
+ */
+extern void scroll_render_window(const ScrollAnimation *anim, int32_t position, uint8_t *frame, uint8_t level);
+
+/**
+ * Monta a janela direto nas palavras G|R|B (ordem física), com a cor e a
+ * intensidade da rolagem: uma consulta de tabela por LED, sem frame intermediário.
+ * @param anim Estado da rolagem
+ * @param position Início da janela em 8.8
+ * @param words Buffer de saída com NUM_LEDS palavras
+ */
+extern void scroll_pack_window(const ScrollAnimation *anim, int32_t position, uint32_t *words);
+
+/**
+ * Passo para o escalonador: envia a janela atual e avança a posição. Sem
+ * sub-passo, passos que não mudam a linha inteira não geram envio.
+ * @param state Ponteiro para ScrollAnimation
+ * @return false depois que a mensagem saiu inteira da matriz
+ */
+extern bool scroll_animation_step(void *state);
+
+/**
+ * Avança a posição sem enviar nada, para quem desenha a janela por conta
+ * própria (por exemplo uma camada de texto do compositor).
+ * @param anim Estado da rolagem
+ * @return false depois que a mensagem saiu inteira da matriz
+ */
+extern bool scroll_animation_advance(ScrollAnimation *anim);
+
+#endif
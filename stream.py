@@ -0,0 +1,165 @@
+import argparse
+import colorsys
+import struct
+import time
+
+import serial
+
+from logs import PORTA, BAUD, separar
+
+# ENVIO DE FRAMES PELA USB (modo streaming do firmware, ver usb_stream.h)
+# Uso:
+#   python stream.py --porta COM7 demo                 # arco-íris gerado aqui
+#   python stream.py --porta COM7 --fps 30 frames.raw  # frames RGB crus, LARGURA*ALTURA*3 bytes cada
+
+LARGURA = 5              # Deve bater com MATRIX_WIDTH
+ALTURA = 5               # Deve bater com MATRIX_HEIGHT
+INTENSIDADE = 26         # 0-256, como intensity_to_fixed(0.1)
+JANELA = 2               # Frames enviados sem confirmação (crédito)
+TIMEOUT_ACK = 1.0        # Segundos até considerar uma confirmação perdida
+
+SYNC = b'\x5A\xA5'
+TIPO_FRAME = 1
+STATUS = {0: 'ok', 1: 'CRC inválido', 2: 'tamanho inválido'}
+
+
+def crc16(dados, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, igual a crc16_update() em usb_stream.c."""
+    for byte in dados:
+        x = ((crc >> 8) ^ byte) & 0xFF
+        x ^= x >> 4
+        crc = ((crc << 8) ^ (x << 12) ^ (x << 5) ^ x) & 0xFFFF
+    return crc
+
+
+def pacote(seq, intensidade, pixels):
+    """Monta um pacote de frame: sync, tipo, seq, tamanho, payload e CRC."""
+    payload = struct.pack('<H', intensidade) + pixels
+    corpo = struct.pack('<BBH', TIPO_FRAME, seq & 0xFF, len(payload)) + payload
+    return SYNC + corpo + struct.pack('<H', crc16(corpo))
+
+
+def frames_demo(largura, altura):
+    """Arco-íris diagonal em movimento."""
+    passo = 0
+    while True:
+        pixels = bytearray()
+        for y in range(altura):
+            for x in range(largura):
+                r, g, b = colorsys.hsv_to_rgb(((x + y) * 0.08 + passo * 0.01) % 1.0, 1.0, 1.0)
+                pixels += bytes((int(r * 255), int(g * 255), int(b * 255)))
+        yield bytes(pixels)
+        passo += 1
+
+
+def frames_arquivo(caminho, largura, altura):
+    """Frames RGB crus em sequência, repetidos em laço."""
+    tamanho = largura * altura * 3
+    dados = open(caminho, 'rb').read()
+    if len(dados) < tamanho:
+        raise SystemExit(f"❌ {caminho} tem menos de um frame ({tamanho} bytes)")
+    while True:
+        for inicio in range(0, len(dados) - tamanho + 1, tamanho):
+            yield dados[inicio:inicio + tamanho]
+
+
+def percentil(valores, p):
+    ordenados = sorted(valores)
+    return ordenados[min(len(ordenados) - 1, int(len(ordenados) * p))]
+
+
+def enviar(ser, frames, args):
+    """
+    Envia frames respeitando o crédito (JANELA) e, se pedido, um fps máximo.
+    Retorna as latências (envio -> confirmação) dos frames confirmados.
+    """
+    pendentes = {}           # seq -> instante do envio
+    latencias = []
+    erros = perdidos = 0
+    seq = 0
+    buffer = b''
+    inicio = proximo_envio = ultimo_relatorio = time.perf_counter()
+    confirmados_relatorio = 0
+
+    try:
+        while args.duracao == 0 or time.perf_counter() - inicio < args.duracao:
+            agora = time.perf_counter()
+
+            # Envia enquanto houver crédito e o ritmo pedido permitir
+            if len(pendentes) < args.janela and agora >= proximo_envio:
+                ser.write(pacote(seq, args.intensidade, next(frames)))
+                pendentes[seq & 0xFF] = agora
+                seq += 1
+                proximo_envio = max(proximo_envio + 1.0 / args.fps, agora - 1.0) if args.fps else agora
+
+            # Confirmações e mensagens da placa
+            buffer += ser.read(ser.in_waiting or 0)
+            itens, buffer = separar(buffer)
+            for tipo, conteudo in itens:
+                if tipo == 'texto':
+                    print(f"📟 {conteudo}")
+                elif tipo == 'ack' and conteudo['seq'] in pendentes:
+                    enviado = pendentes.pop(conteudo['seq'])
+                    if conteudo['status'] == 0:
+                        latencias.append(time.perf_counter() - enviado)
+                        confirmados_relatorio += 1
+                    else:
+                        erros += 1
+                        print(f"⚠️ frame {conteudo['seq']}: {STATUS.get(conteudo['status'], conteudo['status'])}")
+
+            # Confirmações perdidas liberam o crédito
+            for s, enviado in list(pendentes.items()):
+                if agora - enviado > TIMEOUT_ACK:
+                    del pendentes[s]
+                    perdidos += 1
+
+            if agora - ultimo_relatorio >= 1.0:
+                fps = confirmados_relatorio / (agora - ultimo_relatorio)
+                ultima = latencias[-1] * 1000 if latencias else 0
+                print(f"📊 {fps:6.1f} fps   latência {ultima:6.2f} ms   erros {erros}   perdidos {perdidos}")
+                ultimo_relatorio = agora
+                confirmados_relatorio = 0
+
+            # Sem crédito: espera a placa em vez de girar em falso
+            if len(pendentes) >= args.janela:
+                buffer += ser.read(1)
+    except KeyboardInterrupt:
+        pass  # CTRL+C encerra o envio e mostra o resumo
+
+    total = time.perf_counter() - inicio
+    return latencias, erros, perdidos, total
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Envia frames para a matriz pela USB')
+    parser.add_argument('origem', help="'demo' ou arquivo de frames RGB crus")
+    parser.add_argument('--porta', default=PORTA)
+    parser.add_argument('--largura', type=int, default=LARGURA)
+    parser.add_argument('--altura', type=int, default=ALTURA)
+    parser.add_argument('--intensidade', type=int, default=INTENSIDADE)
+    parser.add_argument('--fps', type=float, default=0, help='Limite de fps (0 = o máximo que a placa aceitar)')
+    parser.add_argument('--janela', type=int, default=JANELA)
+    parser.add_argument('--duracao', type=float, default=0, help='Segundos de envio (0 = até CTRL+C)')
+    args = parser.parse_args()
+
+    if args.origem == 'demo':
+        frames = frames_demo(args.largura, args.altura)
+    else:
+        frames = frames_arquivo(args.origem, args.largura, args.altura)
+
+    try:
+        with serial.Serial(args.porta, BAUD, timeout=0.001) as ser:
+            print(f"📡 Enviando para {args.porta} ({args.largura}x{args.altura})...\n(Pressione CTRL+C para parar)\n")
+            latencias, erros, perdidos, total = enviar(ser, frames, args)
+    except serial.SerialException:
+        print(f"❌ Erro: Não foi possível abrir a porta {args.porta}. Verifique se a placa está conectada.")
+        return
+
+    if latencias:
+        print(f"\n✅ {len(latencias)} frames em {total:.1f} s: {len(latencias) / total:.1f} fps sustentados")
+        print(f"   latência min {min(latencias) * 1000:.2f} ms  média {sum(latencias) / len(latencias) * 1000:.2f} ms  "
+              f"p99 {percentil(latencias, 0.99) * 1000:.2f} ms   erros {erros}   perdidos {perdidos}")
+
+
+if __name__ == '__main__':
+    main()
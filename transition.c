@@ -0,0 +1,276 @@
+#include <string.h>
+#include "hardware/sync.h"
+#include "transition.h"
+#include "matrix_geometry.h"
+#include "output_core.h"
+
+#define LANES 0x00FF00FF                 // Duas faixas de 8 bits com 8 bits de folga
+
+// === PEDIDO (escrito por transition_start(), possivelmente no outro núcleo) ===
+static volatile uint32_t request_seq = 0;
+static TransitionType request_type;
+static uint32_t request_duration_us;
+
+// === ESTADO DO ESTÁGIO DE SAÍDA (só quem envia os frames escreve) ===
+static uint32_t latched_seq = 0;         // Último pedido aceito
+static bool pending = false;             // Pedido aceito esperando o primeiro frame novo
+static bool running = false;             // Mistura em andamento
+static TransitionType type;
+static uint32_t duration_us;
+static uint64_t start_us;                // Instante do primeiro frame misturado
+static uint64_t last_output_us;          // Último frame enviado com mistura
+static uint32_t from[NUM_LEDS];          // Origem: o que estava nos LEDs quando a transição começou
+static uint32_t to[NUM_LEDS];            // Último frame recebido do modo novo
+static alarm_id_t alarm_id = 0;          // Alarme do próximo reenvio
+
+// === TABELAS (montadas uma vez por boot, por índice na cadeia) ===
+static uint8_t column[NUM_LEDS];         // Coluna de cada LED
+static uint8_t row[NUM_LEDS];            // Linha de cada LED
+static uint16_t dissolve_order[NUM_LEDS];  // Posição de cada LED na ordem da dissolução
+static bool tables_ready = false;
+
+static const char *const transition_names[TRANSITION_TYPES] = {
+    "cut", "crossfade", "wipe-right", "wipe-left", "wipe-down", "wipe-up", "dissolve",
+};
+
+/**
+ * Monta coordenadas e a ordem da dissolução (Fisher-Yates com xorshift)
+ */
+static void transition_tables_init(void) {
+    uint32_t rng = 0x6D2B79F5u;
+
+    for (int i = 0; i < NUM_LEDS; i++) {
+        int position = map_index_to_position(i);
+        column[i] = (uint8_t)(position % MATRIX_WIDTH);
+        row[i] = (uint8_t)(position / MATRIX_WIDTH);
+        dissolve_order[i] = (uint16_t)i;
+    }
+    for (int i = NUM_LEDS - 1; i > 0; i--) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        int j = (int)(rng % (uint32_t)(i + 1));
+        uint16_t swap = dissolve_order[i];
+        dissolve_order[i] = dissolve_order[j];
+        dissolve_order[j] = swap;
+    }
+
+    tables_ready = true;
+}
+
+/**
+ * Interpola duas palavras G|R|B: from + (to - from) * alpha / 256 em cada canal
+ * @param a Palavra de origem
+ * @param b Palavra de destino
+ * @param alpha Peso do destino (0-256)
+ * @return Palavra interpolada
+ */
+static inline uint32_t lerp_word(uint32_t a, uint32_t b, uint32_t alpha) {
+    // G e B em uma palavra, R em outra (o byte baixo do fio é sempre zero)
+    uint32_t a_gb = (a >> 8) & LANES, b_gb = (b >> 8) & LANES;
+    uint32_t a_r = (a >> 16) & 0xFF, b_r = (b >> 16) & 0xFF;
+    uint32_t gb = (a_gb + (((b_gb - a_gb) * alpha) >> 8)) & LANES;
+    uint32_t r = (a_r + (((b_r - a_r) * alpha) >> 8)) & 0xFF;
+    return (gb << 8) | (r << 16);
+}
+
+/**
+ * Peso do frame novo no instante atual
+ * @param now_us Instante
+ * @return 0 a 256
+ */
+static uint32_t transition_alpha(uint64_t now_us) {
+    uint64_t elapsed = now_us - start_us;
+    if (elapsed >= duration_us) return 256;
+    return (uint32_t)((elapsed << 8) / duration_us);
+}
+
+/**
+ * Passada única: guarda o frame novo (quando src é diferente de to), lê a
+ * origem (de origin, que vira a nova origem quando a transição começa) e
+ * escreve a mistura em out
+ * @param out Saída
+ * @param src Frame novo
+ * @param origin Origem da mistura
+ * @param alpha Peso do frame novo (0-256)
+ */
+static void transition_blend(uint32_t *out, const uint32_t *src, const uint32_t *origin, uint32_t alpha) {
+    bool keep_to = src != to, keep_from = origin != from;
+
+    switch (type) {
+    case TRANSITION_CROSSFADE:
+        for (int i = 0; i < NUM_LEDS; i++) {
+            uint32_t a = origin[i], b = src[i];
+            if (keep_from) from[i] = a;
+            if (keep_to) to[i] = b;
+            out[i] = lerp_word(a, b, alpha);
+        }
+        break;
+
+    case TRANSITION_DISSOLVE: {
+        // Os primeiros LEDs da ordem já trocaram; alpha define quantos
+        uint32_t threshold = (alpha * NUM_LEDS) >> 8;
+        for (int i = 0; i < NUM_LEDS; i++) {
+            uint32_t a = origin[i], b = src[i];
+            if (keep_from) from[i] = a;
+            if (keep_to) to[i] = b;
+            out[i] = dissolve_order[i] < threshold ? b : a;
+        }
+        break;
+    }
+
+    default: {
+        // Varredura: cada LED tem o peso da borda sobre a própria coluna (ou linha), com meio-tom na borda
+        bool vertical = type == TRANSITION_WIPE_DOWN || type == TRANSITION_WIPE_UP;
+        bool reverse = type == TRANSITION_WIPE_LEFT || type == TRANSITION_WIPE_UP;
+        const uint8_t *key = vertical ? row : column;
+        int span = vertical ? MATRIX_HEIGHT : MATRIX_WIDTH;
+        int32_t edge = (int32_t)(alpha * (uint32_t)span);
+
+        for (int i = 0; i < NUM_LEDS; i++) {
+            uint32_t a = origin[i], b = src[i];
+            if (keep_from) from[i] = a;
+            if (keep_to) to[i] = b;
+
+            int k = reverse ? span - 1 - key[i] : key[i];
+            int32_t weight = edge - (k << 8);
+            out[i] = weight <= 0 ? a : weight >= 256 ? b : lerp_word(a, b, (uint32_t)weight);
+        }
+        break;
+    }
+    }
+}
+
+/**
+ * Aceita um pedido novo de transition_start()
+ */
+static void transition_latch(void) {
+    uint32_t seq = request_seq;
+    if (seq == latched_seq) return;
+
+    // Parâmetros lidos só depois de observar o novo contador
+    __dmb();
+    latched_seq = seq;
+    type = request_type;
+    duration_us = request_duration_us;
+    pending = type != TRANSITION_CUT && duration_us > 0;
+    running = false;
+}
+
+/**
+ * Pede uma transição
+ * @param new_type Tipo
+ * @param frames Duração em frames
+ */
+void transition_start(TransitionType new_type, uint frames) {
+    request_type = new_type < TRANSITION_TYPES ? new_type : TRANSITION_CUT;
+    request_duration_us = frames * TRANSITION_PERIOD_US;
+
+    // Parâmetros visíveis antes do novo contador
+    __dmb();
+    request_seq = request_seq + 1;
+}
+
+/**
+ * Mistura um frame novo
+ * @param words Frame novo e saída
+ * @param previous Último frame enviado
+ */
+void transition_apply(uint32_t *words, const uint32_t *previous) {
+    transition_latch();
+    if (!pending && !running) return;
+
+    if (!tables_ready) transition_tables_init();
+
+    uint64_t now_us = time_us_64();
+    if (pending) {
+        // Primeiro frame do modo novo: a origem é o que está nos LEDs agora
+        pending = false;
+        running = true;
+        start_us = now_us;
+        transition_blend(words, words, previous, 0);
+    } else {
+        uint32_t alpha = transition_alpha(now_us);
+        transition_blend(words, words, from, alpha);
+        running = alpha < 256;
+    }
+    last_output_us = now_us;
+}
+
+/**
+ * Remistura no instante atual
+ * @param words Saída
+ * @return true se há frame
+ */
+bool transition_render(uint32_t *words) {
+    transition_latch();
+    if (!running) return false;
+
+    uint64_t now_us = time_us_64();
+    if (now_us - last_output_us < TRANSITION_PERIOD_US) return false;
+
+    uint32_t alpha = transition_alpha(now_us);
+    transition_blend(words, to, from, alpha);
+    running = alpha < 256;
+    last_output_us = now_us;
+    return true;
+}
+
+/**
+ * Callback do alarme: apenas acorda o laço principal para o reenvio
+ */
+static int64_t transition_alarm_callback(alarm_id_t id, void *user_data) {
+    alarm_id = 0;
+    __sev();
+    return 0;
+}
+
+/**
+ * Reenvio no laço principal
+ * @param pio Instância PIO
+ * @param sm State machine
+ * @return true se enviou
+ */
+bool transition_poll(PIO pio, uint sm) {
+    if (output_core_owns(pio, sm)) return false;
+
+    uint32_t local[NUM_LEDS];
+    uint32_t *words = frame_words_begin(pio, sm, local);
+    bool sent = transition_render(words);
+    if (sent) frame_words_send(pio, sm, words);
+
+    // Próximo reenvio (o frame novo que chegar antes disso também conta)
+    if (alarm_id > 0) {
+        cancel_alarm(alarm_id);
+        alarm_id = 0;
+    }
+    if (running) {
+        alarm_id = add_alarm_at(from_us_since_boot(last_output_us + TRANSITION_PERIOD_US), transition_alarm_callback,
+                                NULL, true);
+    }
+    return sent;
+}
+
+/**
+ * Indica transição pedida ou em andamento
+ * @return true se ativa
+ */
+bool transition_active(void) {
+    return running || pending || request_seq != latched_seq;
+}
+
+/**
+ * Procura pelo nome
+ * @param name Nome
+ * @param found Saída
+ * @return true se encontrado
+ */
+bool transition_find(const char *name, TransitionType *found) {
+    for (int i = 0; i < TRANSITION_TYPES; i++) {
+        if (strcmp(name, transition_names[i]) == 0) {
+            *found = (TransitionType)i;
+            return true;
+        }
+    }
+    return false;
+}
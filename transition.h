@@ -0,0 +1,89 @@
+#ifndef TRANSITION_H
+#define TRANSITION_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "led_functions.h"
+
+/**
+ * Transições entre o frame que estava nos LEDs e os frames do modo que entra:
+ * fusão, varredura em uma das quatro direções e dissolução pseudoaleatória.
+ * A mistura acontece no estágio de saída, nas palavras G|R|B já com intensidade:
+ * cada frame novo passa por transition_apply() em uma única passada, que guarda
+ * o frame recebido, lê o frame de saída e escreve o resultado no mesmo buffer.
+ * O peso é 8.8 (0 a 256) pelo tempo decorrido; a varredura tem borda suave e a
+ * dissolução usa uma ordem de LEDs sorteada uma vez por boot.
+ * Modos lentos (rolagem, demo) não seguram a transição: transition_poll()
+ * remistura o último frame recebido a TRANSITION_FPS enquanto ela durar.
+ */
+
+#ifndef TRANSITION_FPS
+#define TRANSITION_FPS 60                // Ritmo da remistura enquanto a transição dura
+#endif
+
+#define TRANSITION_PERIOD_US (1000000 / TRANSITION_FPS)
+
+typedef enum {
+    TRANSITION_CUT,                      // Troca direta, sem mistura
+    TRANSITION_CROSSFADE,                // Fusão de todos os LEDs
+    TRANSITION_WIPE_RIGHT,               // Borda anda para a direita (o novo entra pela esquerda)
+    TRANSITION_WIPE_LEFT,                // Borda anda para a esquerda
+    TRANSITION_WIPE_DOWN,                // Borda desce (o novo entra por cima)
+    TRANSITION_WIPE_UP,                  // Borda sobe
+    TRANSITION_DISSOLVE,                 // LEDs trocam um a um em ordem pseudoaleatória
+    TRANSITION_TYPES
+} TransitionType;
+
+/**
+ * Pede uma transição para o próximo frame enviado: o frame que está nos LEDs
+ * nesse momento vira a origem. Pode ser chamada com outra transição em andamento
+ * (a nova parte do que está sendo mostrado). Segura para chamar do núcleo 0 com
+ * a saída no núcleo 1.
+ * @param type Tipo de transição
+ * @param frames Duração em frames de TRANSITION_FPS (0 equivale a TRANSITION_CUT)
+ */
+extern void transition_start(TransitionType type, uint frames);
+
+/**
+ * Estágio de saída: mistura um frame novo com a origem da transição, no lugar.
+ * Sem transição pedida ou em andamento, retorna sem tocar nas palavras.
+ * @param words Frame novo (NUM_LEDS palavras G|R|B, ordem física); recebe o resultado
+ * @param previous Último frame enviado aos LEDs (origem, lida só quando uma transição começa)
+ */
+extern void transition_apply(uint32_t *words, const uint32_t *previous);
+
+/**
+ * Remistura a origem e o último frame recebido no instante atual, se a
+ * transição está em andamento e o último envio foi há TRANSITION_PERIOD_US.
+ * Para quem é dono da saída (laço do núcleo 1).
+ * @param words Saída com NUM_LEDS palavras
+ * @return false se não há nada a enviar
+ */
+extern bool transition_render(uint32_t *words);
+
+/**
+ * Laço principal: reenvia a mistura no ritmo de TRANSITION_FPS enquanto o modo
+ * novo não manda frames (sem efeito quando o núcleo 1 é dono da saída).
+ * Um alarme acorda o __wfe() no próximo reenvio.
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @return true se um frame foi enviado
+ */
+extern bool transition_poll(PIO pio, uint sm);
+
+/**
+ * Indica se há transição pedida ou em andamento.
+ * @return true até o último frame da mistura sair
+ */
+extern bool transition_active(void);
+
+/**
+ * Procura um tipo pelo nome ("cut", "crossfade", "wipe-right", "wipe-left",
+ * "wipe-down", "wipe-up", "dissolve").
+ * @param name Nome
+ * @param type Saída
+ * @return false se o nome não existe
+ */
+extern bool transition_find(const char *name, TransitionType *type);
+
+#endif
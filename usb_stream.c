@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include "usb_stream.h"
+#include "framebuffer.h"
+
+// Os pixels recebidos (R, G, B) são gravados direto no array de RGBColor8
+_Static_assert(sizeof(RGBColor8) == 3, "RGBColor8 deve ter 3 bytes sem preenchimento");
+
+typedef enum {
+    RX_SYNC0, RX_SYNC1, RX_TYPE, RX_SEQ, RX_LEN0, RX_LEN1, RX_PAYLOAD, RX_CRC0, RX_CRC1
+} RxState;
+
+// === ESTADO DA RECEPÇÃO ===
+static RxState state = RX_SYNC0;
+static uint8_t type, seq;
+static uint16_t length, received;    // Tamanho do payload e bytes já recebidos
+static uint16_t crc, packet_crc;     // CRC calculado e CRC recebido
+static uint16_t intensity;           // Intensidade do frame em recepção
+static RGBColor8 *pixels;            // Buffer livre do framebuffer, com o payload em recepção
+static UsbStreamStats stats;
+
+/**
+ * Atualiza o CRC-16/CCITT-FALSE com um byte (sem tabela)
+ * @param value CRC atual
+ * @param byte Byte recebido
+ * @return CRC atualizado
+ */
+static inline uint16_t crc16_update(uint16_t value, uint8_t byte) {
+    uint8_t x = (value >> 8) ^ byte;
+    x ^= x >> 4;
+    return (uint16_t)((value << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x);
+}
+
+/**
+ * Envia a confirmação de um pacote
+ * @param ack_seq Número de sequência do pacote
+ * @param status Resultado
+ */
+static void send_ack(uint8_t ack_seq, UsbStreamStatus status) {
+    uint8_t body[5] = {USB_STREAM_ACK, 2, 0, ack_seq, (uint8_t)status};
+    uint8_t checksum = 0;
+
+    putchar_raw(0xA5);
+    putchar_raw(0x5A);
+    for (uint i = 0; i < sizeof(body); i++) {
+        putchar_raw(body[i]);
+        checksum += body[i];
+    }
+    putchar_raw(checksum);
+    stdio_flush();
+}
+
+/**
+ * Processa um byte do pacote
+ * @param byte Byte recebido
+ * @return true quando um frame válido terminou
+ */
+static bool receive_byte(uint8_t byte) {
+    switch (state) {
+        case RX_SYNC0:
+            if (byte == USB_STREAM_SYNC0) state = RX_SYNC1;
+            return false;
+
+        case RX_SYNC1:
+            state = byte == USB_STREAM_SYNC1 ? RX_TYPE : byte == USB_STREAM_SYNC0 ? RX_SYNC1 : RX_SYNC0;
+            crc = 0xFFFF;
+            return false;
+
+        case RX_TYPE:
+            type = byte;
+            state = RX_SEQ;
+            break;
+
+        case RX_SEQ:
+            seq = byte;
+            state = RX_LEN0;
+            break;
+
+        case RX_LEN0:
+            length = byte;
+            state = RX_LEN1;
+            break;
+
+        case RX_LEN1:
+            length |= (uint16_t)byte << 8;
+            received = 0;
+
+            // Só frames do tamanho desta matriz
+            if (type != USB_STREAM_FRAME || length != USB_STREAM_FRAME_BYTES) {
+                stats.length_errors++;
+                send_ack(seq, USB_STREAM_BAD_LENGTH);
+                state = RX_SYNC0;
+                return false;
+            }
+            pixels = framebuffer_spare();
+            state = RX_PAYLOAD;
+            break;
+
+        case RX_PAYLOAD:
+            if (received < 2) {
+                intensity = received == 0 ? byte : intensity | (uint16_t)byte << 8;
+            } else {
+                ((uint8_t *)pixels)[received - 2] = byte;
+            }
+            if (++received == length) state = RX_CRC0;
+            break;
+
+        case RX_CRC0:
+            packet_crc = byte;
+            state = RX_CRC1;
+            return false;
+
+        case RX_CRC1:
+            packet_crc |= (uint16_t)byte << 8;
+            state = RX_SYNC0;
+
+            if (packet_crc != crc) {
+                framebuffer_spare_release();
+                stats.crc_errors++;
+                send_ack(seq, USB_STREAM_BAD_CRC);
+                return false;
+            }
+            return true;
+    }
+
+    crc = crc16_update(crc, byte);
+    return false;
+}
+
+/**
+ * Lê a USB e exibe os frames recebidos
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @return true se um frame foi exibido
+ */
+bool usb_stream_poll(PIO pio, uint sm) {
+    for (int i = 0; i < USB_STREAM_POLL_BYTES; i++) {
+        int c = getchar_timeout_us(0);
+        if (c == PICO_ERROR_TIMEOUT) return false;
+
+        if (receive_byte((uint8_t)c)) {
+            // O payload chegou no buffer livre: o de desenho só é trocado com um pacote
+            // íntegro, então um CRC inválido, ou um pacote chegando no meio de uma
+            // animação, não deixa pixels pela metade nele
+            framebuffer_swap_in();
+
+            // Envia (espera o frame anterior se ainda estiver no fio) e só então libera o host
+            framebuffer_commit(pio, sm, intensity > INTENSITY_FIXED_MAX ? INTENSITY_FIXED_MAX : intensity);
+            stats.frames++;
+            send_ack(seq, USB_STREAM_OK);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Retorna os contadores da recepção
+ * @return Contadores
+ */
+const UsbStreamStats *usb_stream_get_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,56 @@
+#ifndef USB_STREAM_H
+#define USB_STREAM_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "led_functions.h"
+
+// === RECEPÇÃO DE FRAMES PELA USB (CDC) ===
+// Pacote enviado pelo host (little-endian):
+//   0x5A 0xA5 | tipo (1) | seq (1) | tamanho (2) | payload | CRC-16 (2)
+// CRC-16/CCITT-FALSE (polinômio 0x1021, início 0xFFFF) sobre tipo, seq, tamanho e payload.
+// Payload do tipo USB_STREAM_FRAME: intensidade 0-256 (2) + NUM_LEDS pixels R,G,B em ordem lógica.
+//
+// Cada pacote recebe uma confirmação no formato dos registros de perf_counters.h:
+//   0xA5 0x5A | USB_STREAM_ACK | tamanho = 2 (2) | seq (1) | status (1) | checksum (1)
+// O host só envia um novo frame quando há crédito (frames sem confirmação < janela),
+// então os frames seguem o ritmo do emissor sem estourar a recepção.
+
+#define USB_STREAM_SYNC0 0x5A
+#define USB_STREAM_SYNC1 0xA5
+#define USB_STREAM_FRAME 1                         // Frame completo para o framebuffer
+#define USB_STREAM_ACK 2                           // Confirmação (placa -> host)
+#define USB_STREAM_FRAME_BYTES (2 + NUM_LEDS * 3)  // Payload de USB_STREAM_FRAME
+#define USB_STREAM_POLL_BYTES 1024                 // Bytes lidos no máximo por chamada
+#define USB_STREAM_TIMEOUT_MS 2000                 // Sem frames por esse tempo, o modo streaming termina
+
+typedef enum {
+    USB_STREAM_OK = 0,           // Frame exibido
+    USB_STREAM_BAD_CRC = 1,      // CRC não confere (frame descartado)
+    USB_STREAM_BAD_LENGTH = 2,   // Tamanho ou tipo inválido para esta matriz
+} UsbStreamStatus;
+
+typedef struct {
+    uint32_t frames;             // Frames exibidos
+    uint32_t crc_errors;         // Pacotes com CRC inválido
+    uint32_t length_errors;      // Pacotes com tamanho ou tipo inválido
+} UsbStreamStats;
+
+/**
+ * Lê os bytes disponíveis na USB e exibe o frame quando um pacote válido termina.
+ * O payload é recebido no buffer livre do framebuffer (framebuffer_spare()), que só toma o
+ * lugar do buffer de desenho depois de o CRC conferir; um pacote inválido não altera o que
+ * está sendo desenhado.
+ * @param pio Instância do PIO usada
+ * @param sm State machine ativa
+ * @return true se um frame foi exibido nesta chamada
+ */
+extern bool usb_stream_poll(PIO pio, uint sm);
+
+/**
+ * Retorna os contadores da recepção.
+ * @return Ponteiro para os contadores
+ */
+extern const UsbStreamStats *usb_stream_get_stats(void);
+
+#endif